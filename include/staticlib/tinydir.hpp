@@ -26,11 +26,28 @@
 
 #include "staticlib/config.hpp"
 
+#include "staticlib/tinydir/append_log.hpp"
+#include "staticlib/tinydir/async_file_sink.hpp"
+#include "staticlib/tinydir/chunked_reader.hpp"
+#include "staticlib/tinydir/deferred_remover.hpp"
+#include "staticlib/tinydir/direct_file_sink.hpp"
+#include "staticlib/tinydir/direct_file_source.hpp"
+#include "staticlib/tinydir/directory.hpp"
+#include "staticlib/tinydir/disk_usage.hpp"
 #include "staticlib/tinydir/file_sink.hpp"
 #include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/file_status.hpp"
+#include "staticlib/tinydir/fingerprint.hpp"
+#include "staticlib/tinydir/follow_reader.hpp"
+#include "staticlib/tinydir/io_buffer_pool.hpp"
+#include "staticlib/tinydir/io_stats.hpp"
 #include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/parallel_copy.hpp"
 #include "staticlib/tinydir/tinydir_exception.hpp"
 #include "staticlib/tinydir/path.hpp"
+#include "staticlib/tinydir/record_reader.hpp"
+#include "staticlib/tinydir/rotating_file_sink.hpp"
+#include "staticlib/tinydir/tree_diff.hpp"
 
 #endif /* STATICLIB_TINYDIR_HPP */
 
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   append_log.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 3:30 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_APPEND_LOG_HPP
+#define STATICLIB_TINYDIR_APPEND_LOG_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io/span.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * File that multiple threads append records to concurrently without
+ * locking: every writer reserves a range at the end of the log with
+ * an atomic increment of the tail offset and writes its record there
+ * with a positional write. Writes may complete out of order, log tracks
+ * the committed size - the longest prefix where all writes are completed,
+ * readers must not read past it to not see the ranges not yet written.
+ * Existing data of the file is kept, records are appended after it.
+ * If a write fails, the log is broken: its committed size stops before
+ * the failed range and further appends are rejected.
+ * Instances are not movable, they are meant to be shared between threads.
+ */
+class append_log {
+    /**
+     * Underlying file
+     */
+    file_sink sink;
+    /**
+     * End of the reserved ranges
+     */
+    std::atomic<uint64_t> tail;
+    /**
+     * End of the completed prefix
+     */
+    std::atomic<uint64_t> committed;
+    /**
+     * Number of ranges completed out of order
+     */
+    std::atomic<size_t> pending_count;
+    /**
+     * Whether some write has failed
+     */
+    std::atomic<bool> broken;
+    /**
+     * Guards pending ranges
+     */
+    std::mutex pending_mtx;
+    /**
+     * Ranges completed out of order, offset to length
+     */
+    std::map<uint64_t, uint64_t> pending;
+
+public:
+    /**
+     * Constructor, file is created if it does not exist
+     *
+     * @param file_path path to file
+     * @throws tinydir_exception if file cannot be opened
+     */
+    explicit append_log(const std::string& file_path);
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    append_log(const append_log&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    append_log& operator=(const append_log&) = delete;
+
+    /**
+     * Appends the record to the log, may be called concurrently,
+     * returns after the record is written (not necessarily committed)
+     *
+     * @param span record data
+     * @return offset of the record in file
+     * @throws tinydir_exception on IO error or if log is broken
+     */
+    uint64_t append(sl::io::span<const char> span);
+
+    /**
+     * Size of the log including the ranges reserved by the writes
+     * in progress
+     *
+     * @return reserved size
+     */
+    uint64_t size() const;
+
+    /**
+     * Size of the prefix of the log where all writes are completed
+     *
+     * @return committed size
+     */
+    uint64_t committed_size() const;
+
+    /**
+     * Whether some write has failed
+     *
+     * @return true if log is broken
+     */
+    bool is_broken() const;
+
+    /**
+     * Writes the data of the log to the storage device ("fsync")
+     *
+     * @throws tinydir_exception on IO error
+     */
+    void sync();
+
+    /**
+     * File path accessor
+     *
+     * @return path to file
+     */
+    const std::string& path() const;
+
+private:
+    void commit(uint64_t offset, uint64_t length);
+
+    void drain_pending();
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_APPEND_LOG_HPP */
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   async_file_sink.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 2:30 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_ASYNC_FILE_SINK_HPP
+#define STATICLIB_TINYDIR_ASYNC_FILE_SINK_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io/span.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Behaviour of writes into the full queue
+ */
+enum class async_backpressure {
+    /**
+     * Writing thread waits for the writer thread to free the space
+     */
+    block,
+    /**
+     * Data is discarded and counted
+     */
+    drop,
+    /**
+     * Data is put into unbounded (locked) overflow list
+     */
+    grow
+};
+
+/**
+ * Options for asynchronous file sink
+ */
+struct async_sink_options {
+    /**
+     * Number of buffers the queue can hold, rounded up to a power of two
+     */
+    size_t queue_size = 4096;
+    /**
+     * Behaviour of writes into the full queue
+     */
+    async_backpressure backpressure = async_backpressure::block;
+    /**
+     * Maximum number of bytes the writer thread coalesces into a single write
+     */
+    size_t max_batch_size = 1 << 20;
+};
+
+class async_sink_state;
+
+/**
+ * Sink that passes written data to a dedicated writer thread through
+ * a bounded lock-free queue, so writing threads do not wait for the disk
+ * (unless the queue is full in "block" mode). Writer thread coalesces
+ * queued buffers into vectored writes. Data written from one thread is
+ * written to file in the same order. Write errors are reported by
+ * the subsequent "write", "flush" or "close" calls.
+ * Methods except "close" and move operations may be called concurrently.
+ */
+class async_file_sink {
+    /**
+     * Queue and writer thread
+     */
+    std::unique_ptr<async_sink_state> state;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param sink file sink to write to, ownership is taken
+     * @param options queue options
+     */
+    explicit async_file_sink(file_sink&& sink, async_sink_options options = async_sink_options());
+
+    /**
+     * Constructor
+     *
+     * @param file_path path to file
+     * @param mode file open mode
+     * @param options queue options
+     * @throws tinydir_exception if file cannot be opened
+     */
+    explicit async_file_sink(const std::string& file_path,
+            file_sink::open_mode mode = file_sink::open_mode::create,
+            async_sink_options options = async_sink_options());
+
+    /**
+     * Destructor, writes queued data and closes the file, errors are ignored
+     */
+    ~async_file_sink() STATICLIB_NOEXCEPT;
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    async_file_sink(const async_file_sink&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    async_file_sink& operator=(const async_file_sink&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    async_file_sink(async_file_sink&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    async_file_sink& operator=(async_file_sink&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Copies the data into the queue
+     *
+     * @param span source buffer
+     * @return number of bytes accepted, always equal to span size,
+     *         including data dropped because of the full queue
+     * @throws tinydir_exception if previous write failed
+     */
+    std::streamsize write(sl::io::span<const char> span);
+
+    /**
+     * Moves the buffer into the queue without copying the data
+     *
+     * @param buffer data to write
+     * @return number of bytes accepted, always equal to buffer size,
+     *         including data dropped because of the full queue
+     * @throws tinydir_exception if previous write failed
+     */
+    std::streamsize write_buffer(std::string&& buffer);
+
+    /**
+     * Waits until all the data queued before this call is written to file
+     * (not necessarily synced to the storage device)
+     *
+     * @return zero
+     * @throws tinydir_exception if some of the data cannot be written
+     */
+    std::streamsize flush();
+
+    /**
+     * Writes all queued data, stops the writer thread and closes the file
+     *
+     * @throws tinydir_exception if some of the data cannot be written
+     */
+    void close();
+
+    /**
+     * Number of bytes discarded in "drop" mode
+     *
+     * @return dropped bytes count
+     */
+    uint64_t dropped_bytes() const;
+
+    /**
+     * File path accessor
+     *
+     * @return path to file
+     */
+    const std::string& path() const;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_ASYNC_FILE_SINK_HPP */
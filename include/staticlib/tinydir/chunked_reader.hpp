@@ -0,0 +1,303 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   chunked_reader.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 9:40 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_CHUNKED_READER_HPP
+#define STATICLIB_TINYDIR_CHUNKED_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io/span.hpp"
+
+#include "staticlib/tinydir/io_buffer_pool.hpp"
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Range of a file processed as a single unit by "read_chunks"
+ */
+struct file_chunk {
+    /**
+     * Zero-based index of the chunk in the file
+     */
+    size_t index;
+    /**
+     * Offset of the chunk from the beginning of the file
+     */
+    uint64_t offset;
+    /**
+     * Length of the chunk in bytes
+     */
+    uint64_t length;
+
+    /**
+     * Constructor
+     *
+     * @param index chunk index
+     * @param offset chunk offset
+     * @param length chunk length
+     */
+    file_chunk(size_t index, uint64_t offset, uint64_t length) :
+    index(index),
+    offset(offset),
+    length(length) { }
+};
+
+/**
+ * Options for splitting and parallel reading of a file
+ */
+struct chunked_read_options {
+    /**
+     * Number of worker threads, zero to use the number of hardware threads
+     */
+    size_t threads_count = 0;
+    /**
+     * Number of chunks, zero to use 4 chunks per worker thread
+     */
+    size_t chunks_count = 0;
+    /**
+     * Chunks are not made smaller than this size, number of chunks is
+     * reduced for small files
+     */
+    uint64_t min_chunk_size = 1 << 20;
+    /**
+     * Whether every chunk except the last one must end with the delimiter
+     */
+    bool align_to_delimiter = false;
+    /**
+     * Record delimiter
+     */
+    char delimiter = '\n';
+    /**
+     * Whether chunks are delivered to the consumer in file order,
+     * otherwise they are delivered as soon as processed
+     */
+    bool ordered = true;
+    /**
+     * Size of the read buffer of every chunk, the following range
+     * of the same size is read ahead by the OS
+     */
+    size_t buffer_size = 1 << 20;
+};
+
+/**
+ * Source that reads a single chunk of a file using positional reads,
+ * while the caller consumes the buffer the next range of the chunk
+ * is requested from the OS ("posix_fadvise" on linux, "F_RDADVISE" on mac).
+ * Every instance uses its own file descriptor (handle on windows).
+ */
+class chunk_source {
+#ifdef STATICLIB_WINDOWS
+    void* handle = nullptr;
+#else // STATICLIB_WINDOWS
+    /**
+     * Native file descriptor (handle on windows)
+     */
+    int fd = -1;
+#endif // STATICLIB_WINDOWS
+    /**
+     * Path to file
+     */
+    std::string file_path;
+    /**
+     * Range of the file
+     */
+    file_chunk range;
+    /**
+     * Size of the read buffer
+     */
+    size_t buffer_size = 0;
+    /**
+     * Pooled read buffer
+     */
+    io_buffer buffer;
+    /**
+     * Number of bytes in buffer
+     */
+    size_t available = 0;
+    /**
+     * Number of bytes consumed from buffer
+     */
+    size_t position = 0;
+    /**
+     * Number of chunk bytes read from the file
+     */
+    uint64_t consumed = 0;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param file_path path to file
+     * @param chunk range of the file to read
+     * @param buffer_size size of the read buffer
+     * @throws tinydir_exception if file cannot be opened
+     */
+    chunk_source(const std::string& file_path, const file_chunk& chunk, size_t buffer_size = 1 << 20);
+
+    /**
+     * Destructor, will close the descriptor
+     */
+    ~chunk_source() STATICLIB_NOEXCEPT;
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    chunk_source(const chunk_source&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    chunk_source& operator=(const chunk_source&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    chunk_source(chunk_source&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    chunk_source& operator=(chunk_source&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Reads data from the chunk, large reads bypass the buffer
+     *
+     * @param span destination buffer
+     * @return number of bytes read, "std::char_traits<char>::eof()"
+     *         at the end of the chunk
+     * @throws tinydir_exception on IO error or if file was truncated
+     */
+    std::streamsize read(sl::io::span<char> span);
+
+    /**
+     * Range accessor
+     *
+     * @return range of the file read by this source
+     */
+    const file_chunk& chunk() const;
+
+    /**
+     * File path accessor
+     *
+     * @return path to this file
+     */
+    const std::string& path() const;
+
+    /**
+     * Closes the underlying file descriptor, will be called automatically
+     * on destruction
+     */
+    void close() STATICLIB_NOEXCEPT;
+
+private:
+    size_t read_range(char* buf, size_t len);
+};
+
+/**
+ * Splits the file into contiguous non-empty chunks of approximately equal size,
+ * with "align_to_delimiter" option the boundaries are moved forward to follow
+ * the nearest delimiter, so chunks may differ in size and their number may
+ * be smaller than requested.
+ *
+ * @param file_path path to file
+ * @param options split options
+ * @return list of chunks covering the whole file, empty for empty file
+ * @throws tinydir_exception on IO error
+ */
+std::vector<file_chunk> split_file(const std::string& file_path,
+        const chunked_read_options& options = chunked_read_options());
+
+/**
+ * Splits the file into chunks and processes them concurrently, each chunk
+ * is read by a separate "chunk_source" on a worker thread. Consumer is called
+ * on the calling thread once for every processed chunk, in file order if
+ * "ordered" option is set. Workers do not run further than two chunks per
+ * thread ahead of the consumer.
+ * First exception thrown by the processor or the consumer stops the
+ * scheduling of the remaining chunks and is rethrown after running workers
+ * are finished.
+ *
+ * @param file_path path to file
+ * @param options split and scheduling options
+ * @param process function called on a worker thread for every chunk
+ * @param consume function called on the calling thread after the chunk is processed
+ * @throws tinydir_exception on IO error
+ */
+void read_chunks(const std::string& file_path, const chunked_read_options& options,
+        std::function<void(chunk_source&)> process,
+        std::function<void(const file_chunk&)> consume = nullptr);
+
+/**
+ * Same as "read_chunks", but the result returned by "map" on a worker thread
+ * is passed to "consume" on the calling thread
+ *
+ * @param file_path path to file
+ * @param options split and scheduling options
+ * @param map function called on a worker thread for every chunk
+ * @param consume function called on the calling thread with the result of "map"
+ * @throws tinydir_exception on IO error
+ */
+template<typename T>
+void map_chunks(const std::string& file_path, const chunked_read_options& options,
+        std::function<T(chunk_source&)> map,
+        std::function<void(const file_chunk&, T)> consume) {
+    std::mutex mtx;
+    std::unordered_map<size_t, T> results;
+    read_chunks(file_path, options, [&](chunk_source& src) {
+        auto res = map(src);
+        std::lock_guard<std::mutex> guard{mtx};
+        results.emplace(src.chunk().index, std::move(res));
+    }, [&](const file_chunk& chunk) {
+        std::unique_lock<std::mutex> lock{mtx};
+        auto it = results.find(chunk.index);
+        auto res = std::move(it->second);
+        results.erase(it);
+        lock.unlock();
+        consume(chunk, std::move(res));
+    });
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_CHUNKED_READER_HPP */
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   deferred_remover.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 4:10 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_DEFERRED_REMOVER_HPP
+#define STATICLIB_TINYDIR_DEFERRED_REMOVER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "staticlib/config.hpp"
+
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Options for deferred remover
+ */
+struct deferred_remove_options {
+    /**
+     * Maximum number of files and directories the reaper deletes
+     * per second, zero for no limit
+     */
+    uint64_t max_removals_per_second = 0;
+    /**
+     * Whether to delete the leftovers found in the trash
+     * directory on start (i.e. after a crash)
+     */
+    bool recover = true;
+};
+
+class deferred_remover_state;
+
+/**
+ * Removes files and directories by renaming them into the trash directory,
+ * the contents of the trash is deleted by a background reaper thread
+ * at a throttled rate. Trash directory must be on the same FS as the
+ * removed paths, so the rename is atomic and does not copy the data.
+ * Only one remover should use the trash directory at a time. Entries
+ * not deleted on close (or on crash) are left in the trash and are deleted
+ * by the next remover created with the "recover" option.
+ */
+class deferred_remover {
+    /**
+     * Queue and reaper thread
+     */
+    std::unique_ptr<deferred_remover_state> state;
+
+public:
+    /**
+     * Constructor, trash directory is created if it does not exist
+     *
+     * @param trash_dir path to trash directory
+     * @param options remover options
+     * @throws tinydir_exception if trash directory cannot be created
+     */
+    explicit deferred_remover(const std::string& trash_dir,
+            deferred_remove_options options = deferred_remove_options());
+
+    /**
+     * Destructor, stops the reaper
+     */
+    ~deferred_remover() STATICLIB_NOEXCEPT;
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    deferred_remover(const deferred_remover&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    deferred_remover& operator=(const deferred_remover&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    deferred_remover(deferred_remover&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    deferred_remover& operator=(deferred_remover&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Moves the file or directory into the trash and returns,
+     * may be called concurrently
+     *
+     * @param path path to file or directory
+     * @throws tinydir_exception if path cannot be renamed into the trash
+     */
+    void remove(const std::string& path);
+
+    /**
+     * Waits until the trash is empty
+     */
+    void wait();
+
+    /**
+     * Stops the reaper, entries not deleted yet are left in the trash
+     */
+    void close() STATICLIB_NOEXCEPT;
+
+    /**
+     * Number of entries in trash waiting to be deleted,
+     * including the one being deleted
+     *
+     * @return pending entries count
+     */
+    size_t pending_count() const;
+
+    /**
+     * Number of files and directories deleted by the reaper
+     *
+     * @return removals count
+     */
+    uint64_t removals_count() const;
+
+    /**
+     * Number of trash entries the reaper failed to delete,
+     * they are left in the trash
+     *
+     * @return failures count
+     */
+    uint64_t failures_count() const;
+
+    /**
+     * Trash directory accessor
+     *
+     * @return path to trash directory
+     */
+    const std::string& trash_dir() const;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_DEFERRED_REMOVER_HPP */
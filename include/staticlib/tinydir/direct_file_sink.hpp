@@ -0,0 +1,198 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   direct_file_sink.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 7:05 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_DIRECT_FILE_SINK_HPP
+#define STATICLIB_TINYDIR_DIRECT_FILE_SINK_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io/span.hpp"
+
+#include "staticlib/tinydir/io_buffer_pool.hpp"
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+class io_thread;
+
+/**
+ * Write-only file sink that bypasses the page cache ("O_DIRECT" on linux,
+ * "F_NOCACHE" on mac, "FILE_FLAG_NO_BUFFERING" on windows). Data is staged
+ * in two aligned buffers, one buffer is filled by the caller while the other
+ * one is written in background. Unaligned tail is written on "finish"
+ * or "close". If FS does not support unbuffered IO, file is written
+ * through the page cache.
+ * File is always created or truncated.
+ */
+class direct_file_sink {
+#ifdef STATICLIB_WINDOWS
+    void* handle = nullptr;
+#else // STATICLIB_WINDOWS
+    /**
+     * Native file descriptor (handle on windows)
+     */
+    int fd = -1;
+#endif // STATICLIB_WINDOWS
+    /**
+     * Path to file
+     */
+    std::string file_path;
+    /**
+     * Whether unbuffered mode is enabled
+     */
+    bool direct = false;
+    /**
+     * Size of a single staging buffer
+     */
+    size_t buffer_size = 0;
+    /**
+     * Pooled aligned storage for both staging buffers
+     */
+    io_buffer buffers;
+    /**
+     * Index of the buffer filled by the caller
+     */
+    size_t current = 0;
+    /**
+     * Number of bytes in current buffer
+     */
+    size_t filled = 0;
+    /**
+     * File offset of current buffer
+     */
+    uint64_t offset = 0;
+    /**
+     * Background thread writing the other buffer
+     */
+    std::unique_ptr<io_thread> io;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param file_path path to file
+     * @param buffer_size size of a single staging buffer, rounded up to 4096
+     * @throws tinydir_exception if file cannot be opened
+     */
+    explicit direct_file_sink(const std::string& file_path, size_t buffer_size = 1 << 20);
+
+    /**
+     * Destructor, will write the tail and close the descriptor,
+     * errors are ignored
+     */
+    ~direct_file_sink() STATICLIB_NOEXCEPT;
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    direct_file_sink(const direct_file_sink&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    direct_file_sink& operator=(const direct_file_sink&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    direct_file_sink(direct_file_sink&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    direct_file_sink& operator=(direct_file_sink&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Copies specified data into staging buffer, full buffers
+     * are written in background
+     *
+     * @param span source buffer
+     * @return number of bytes accepted, always equal to span size
+     * @throws tinydir_exception if previous background write failed
+     */
+    std::streamsize write(sl::io::span<const char> span);
+
+    /**
+     * Waits for the background write, unaligned data stays staged
+     *
+     * @return zero
+     * @throws tinydir_exception if background write failed
+     */
+    std::streamsize flush();
+
+    /**
+     * Writes all staged data including the unaligned tail,
+     * sets the exact file size and closes the file
+     *
+     * @throws tinydir_exception on IO error
+     */
+    void finish();
+
+    /**
+     * Same as "finish", but errors are ignored, will be called
+     * automatically on destruction
+     */
+    void close() STATICLIB_NOEXCEPT;
+
+    /**
+     * Whether the file is written bypassing the page cache
+     *
+     * @return true if unbuffered mode is enabled
+     */
+    bool is_direct() const;
+
+    /**
+     * File path accessor
+     *
+     * @return path to this file
+     */
+    const std::string& path() const;
+
+private:
+    bool is_open() const;
+
+    void wait_pending();
+
+    void submit_current();
+
+    void close_handle() STATICLIB_NOEXCEPT;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_DIRECT_FILE_SINK_HPP */
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   direct_file_source.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 7:10 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_DIRECT_FILE_SOURCE_HPP
+#define STATICLIB_TINYDIR_DIRECT_FILE_SOURCE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io/span.hpp"
+
+#include "staticlib/tinydir/io_buffer_pool.hpp"
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+class io_thread;
+
+/**
+ * Sequential file source that bypasses the page cache ("O_DIRECT" on linux,
+ * "F_NOCACHE" on mac, "FILE_FLAG_NO_BUFFERING" on windows). File is read
+ * into two aligned buffers, next buffer is read in background while
+ * the caller consumes the current one. If FS does not support unbuffered IO,
+ * file is read through the page cache.
+ */
+class direct_file_source {
+#ifdef STATICLIB_WINDOWS
+    void* handle = nullptr;
+#else // STATICLIB_WINDOWS
+    /**
+     * Native file descriptor (handle on windows)
+     */
+    int fd = -1;
+#endif // STATICLIB_WINDOWS
+    /**
+     * Path to file
+     */
+    std::string file_path;
+    /**
+     * Whether unbuffered mode is enabled
+     */
+    bool direct = false;
+    /**
+     * Size of a single read-ahead buffer
+     */
+    size_t buffer_size = 0;
+    /**
+     * Pooled aligned storage for both read-ahead buffers
+     */
+    io_buffer buffers;
+    /**
+     * Index of the buffer consumed by the caller
+     */
+    size_t current = 1;
+    /**
+     * Number of bytes in current buffer
+     */
+    size_t available = 0;
+    /**
+     * Number of bytes of current buffer already consumed
+     */
+    size_t position = 0;
+    /**
+     * File offset of the next read-ahead
+     */
+    uint64_t offset = 0;
+    /**
+     * Background thread reading into the other buffer
+     */
+    std::unique_ptr<io_thread> io;
+
+public:
+    /**
+     * Constructor, starts reading the file in background
+     *
+     * @param file_path path to file
+     * @param buffer_size size of a single read-ahead buffer, rounded up to 4096
+     * @throws tinydir_exception if file cannot be opened
+     */
+    explicit direct_file_source(const std::string& file_path, size_t buffer_size = 1 << 20);
+
+    /**
+     * Destructor, will close the descriptor
+     */
+    ~direct_file_source() STATICLIB_NOEXCEPT;
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    direct_file_source(const direct_file_source&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    direct_file_source& operator=(const direct_file_source&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    direct_file_source(direct_file_source&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    direct_file_source& operator=(direct_file_source&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Reads up to the specified number of bytes from this file
+     *
+     * @param span destination buffer
+     * @return number of bytes read, "std::char_traits<char>::eof()" on EOF
+     * @throws tinydir_exception on IO error
+     */
+    std::streamsize read(sl::io::span<char> span);
+
+    /**
+     * Closes the underlying file descriptor, will be called automatically
+     * on destruction
+     */
+    void close() STATICLIB_NOEXCEPT;
+
+    /**
+     * Whether the file is read bypassing the page cache
+     *
+     * @return true if unbuffered mode is enabled
+     */
+    bool is_direct() const;
+
+    /**
+     * File path accessor
+     *
+     * @return path to this file
+     */
+    const std::string& path() const;
+
+private:
+    void read_ahead();
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_DIRECT_FILE_SOURCE_HPP */
@@ -0,0 +1,214 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   directory.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:10 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_DIRECTORY_HPP
+#define STATICLIB_TINYDIR_DIRECTORY_HPP
+
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/file_status.hpp"
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Handle to an open directory, all operations take names relative
+ * to this directory and are performed using "*at" system calls,
+ * so the parent path is not resolved again and concurrent renames
+ * of the parent directories do not affect them.
+ * On windows operations fall back to joined paths.
+ */
+class directory {
+#ifndef STATICLIB_WINDOWS
+    /**
+     * Native directory descriptor
+     */
+    int fd = -1;
+#endif // !STATICLIB_WINDOWS
+    /**
+     * Path to directory
+     */
+    std::string dir_path;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param dirpath path to directory
+     * @throws tinydir_exception if directory cannot be opened
+     */
+    explicit directory(const std::string& dirpath);
+
+    /**
+     * Destructor, will close the descriptor
+     */
+    ~directory() STATICLIB_NOEXCEPT;
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    directory(const directory&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    directory& operator=(const directory&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    directory(directory&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    directory& operator=(directory&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Opens a subdirectory of this directory
+     *
+     * @param name relative path to subdirectory
+     * @return directory handle
+     * @throws tinydir_exception on IO error
+     */
+    directory open_directory(const std::string& name) const;
+
+    /**
+     * Opens a file from this directory for reading
+     *
+     * @param name relative path to file
+     * @return file source
+     * @throws tinydir_exception on IO error
+     */
+    file_source open_read(const std::string& name) const;
+
+    /**
+     * Opens a file from this directory for writing
+     *
+     * @param name relative path to file
+     * @param mode file open mode
+     * @return file sink
+     * @throws tinydir_exception on IO error
+     */
+    file_sink open_write(const std::string& name,
+            file_sink::open_mode mode = file_sink::open_mode::create) const;
+
+    /**
+     * Lists the names of the entries of this directory,
+     * "." and ".." entries are skipped
+     *
+     * @return entries names sorted alphabetically
+     * @throws tinydir_exception on IO error
+     */
+    std::vector<std::string> list() const;
+
+    /**
+     * Reads FS metadata of the entry of this directory
+     *
+     * @param name relative path to entry
+     * @param follow_symlinks whether to follow symlinks
+     * @return metadata of the entry, "not_found" type if entry does not exist
+     * @throws tinydir_exception on IO error
+     */
+    file_status stat(const std::string& name, bool follow_symlinks = false) const;
+
+    /**
+     * Creates a subdirectory in this directory
+     *
+     * @param name relative path to subdirectory
+     * @throws tinydir_exception on IO error
+     */
+    void create_directory(const std::string& name) const;
+
+    /**
+     * Removes a file or a directory (recursively) from this directory,
+     * symlinks are not followed
+     *
+     * @param name relative path to entry
+     * @throws tinydir_exception on IO error
+     */
+    void remove(const std::string& name) const;
+
+    /**
+     * Renames an entry inside this directory, existing target file is replaced
+     *
+     * @param name relative path to entry
+     * @param target_name new relative path
+     * @throws tinydir_exception on IO error
+     */
+    void rename(const std::string& name, const std::string& target_name) const;
+
+    /**
+     * Moves an entry from this directory to the specified one,
+     * both directories must reside on the same file system
+     *
+     * @param name relative path to entry
+     * @param target_dir target directory
+     * @param target_name relative path in target directory
+     * @throws tinydir_exception on IO error
+     */
+    void rename(const std::string& name, const directory& target_dir, const std::string& target_name) const;
+
+    /**
+     * Closes the underlying descriptor, will be called automatically
+     * on destruction
+     */
+    void close() STATICLIB_NOEXCEPT;
+
+    /**
+     * Directory path accessor
+     *
+     * @return path to this directory
+     */
+    const std::string& path() const;
+
+private:
+#ifndef STATICLIB_WINDOWS
+    directory(int fd, std::string dir_path);
+
+    int open_subdirectory(const std::string& name, int extra_flags) const;
+#endif // !STATICLIB_WINDOWS
+
+    std::string child_path(const std::string& name) const;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_DIRECTORY_HPP */
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   disk_usage.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 1:15 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_DISK_USAGE_HPP
+#define STATICLIB_TINYDIR_DISK_USAGE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Aggregated disk usage of a directory including all its subdirectories
+ */
+struct disk_usage_node {
+    /**
+     * Path to directory
+     */
+    std::string dirpath;
+    /**
+     * Sum of apparent sizes of all entries in this subtree
+     */
+    uint64_t apparent_size = 0;
+    /**
+     * Sum of sizes allocated on disk for all entries in this subtree
+     */
+    uint64_t allocated_size = 0;
+    /**
+     * Number of entries (inodes) in this subtree, including the directory itself
+     */
+    uint64_t inodes_count = 0;
+    /**
+     * Usage of subdirectories, sorted by path
+     */
+    std::vector<disk_usage_node> children;
+};
+
+/**
+ * Disk usage accounting options
+ */
+struct disk_usage_options {
+    /**
+     * Files with multiple hard links are counted only once (by device and inode),
+     * in whichever of the containing directories is visited first
+     */
+    bool dedupe_hardlinks = true;
+    /**
+     * Do not descend into directories located on other filesystems
+     */
+    bool one_filesystem = false;
+    /**
+     * Number of worker threads, zero to use the number of hardware threads
+     */
+    size_t threads_count = 0;
+};
+
+/**
+ * Computes disk usage of the specified directory tree using only
+ * the metadata from "stat" calls, files are not opened.
+ * Subdirectories are traversed in parallel, symlinks are not followed.
+ *
+ * @param root_dir path to directory
+ * @param options accounting options
+ * @return usage tree, root node corresponds to the specified directory
+ * @throws tinydir_exception on IO error
+ */
+disk_usage_node disk_usage(const std::string& root_dir,
+        const disk_usage_options& options = disk_usage_options());
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_DISK_USAGE_HPP */
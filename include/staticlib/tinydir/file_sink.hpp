@@ -24,7 +24,10 @@
 #ifndef STATICLIB_TINYDIR_FILE_SINK_HPP
 #define STATICLIB_TINYDIR_FILE_SINK_HPP
 
+#include <cstdint>
 #include <string>
+#include <system_error>
+#include <vector>
 
 #include "staticlib/config.hpp"
 #include "staticlib/io/span.hpp"
@@ -34,6 +37,8 @@
 namespace staticlib {
 namespace tinydir {
 
+class directory;
+
 /**
  * Implementation of a file descriptor/handle wrapper with a 
  * unified interface for *nix and windows
@@ -52,12 +57,29 @@ class file_sink {
      */
     std::string file_path;
 
+#ifndef STATICLIB_WINDOWS
+    friend class directory;
+
+    /**
+     * Private constructor for the descriptors opened
+     * relative to a directory handle
+     *
+     * @param fd open file descriptor, ownership is taken
+     * @param file_path path to file
+     */
+    file_sink(int fd, std::string file_path);
+#endif // !STATICLIB_WINDOWS
+
 public:
     /**
      * File open mode
      */
     enum class open_mode {
-        create, append, from_file
+        create, append, from_file,
+        /**
+         * File is created exclusively, open fails if it already exists
+         */
+        create_new
     };
 
     /**
@@ -67,6 +89,16 @@ public:
      */
     file_sink(const std::string& file_path, open_mode mode = open_mode::create);
 
+    /**
+     * Non-throwing constructor, on failure the error is reported
+     * through "ec" and the instance is left closed
+     *
+     * @param file_path path to file
+     * @param mode file open mode
+     * @param ec error code, cleared on success
+     */
+    file_sink(const std::string& file_path, open_mode mode, std::error_code& ec);
+
     /**
      * Destructor, will close the descriptor
      */
@@ -112,7 +144,30 @@ public:
     std::streamsize write(sl::io::span<const char> span);
 
     /**
-     * Writes the contents of the specified file to this file descriptor
+     * Writes the whole buffer at the specified offset ("pwrite"), file
+     * position is not used or changed, so concurrent calls for
+     * different ranges are allowed
+     *
+     * @param span source buffer
+     * @param offset offset in file
+     * @throws tinydir_exception on IO error
+     */
+    void write_at(sl::io::span<const char> span, uint64_t offset);
+
+    /**
+     * Writes the specified buffers to this file descriptor with a single
+     * call ("writev") where supported, number of buffers written at once
+     * is limited, so the write may be partial
+     *
+     * @param spans source buffers
+     * @return number of bytes successfully written
+     */
+    std::streamsize write_vector(const std::vector<sl::io::span<const char>>& spans);
+
+    /**
+     * Writes the contents of the specified file to this file descriptor,
+     * holes of the sparse source file are preserved unless this file
+     * is opened in "append" mode
      *
      * @param string source file path
      * @return number of bytes successfully written
@@ -134,6 +189,32 @@ public:
      */
     std::streamsize flush();
 
+    /**
+     * Allocates disk space for the first "size" bytes of this file
+     * without changing its size, so the following writes do not need
+     * to allocate extents; does nothing if FS does not support it
+     *
+     * @param size number of bytes to allocate
+     * @throws tinydir_exception on IO error
+     */
+    void reserve_space(uint64_t size);
+
+    /**
+     * Sets the size of this file, disk space reserved with "reserve_space"
+     * beyond the new size is released; current position is not changed
+     *
+     * @param size new size in bytes
+     * @throws tinydir_exception on IO error
+     */
+    void resize(uint64_t size);
+
+    /**
+     * Writes the data of this file to the storage device ("fsync")
+     *
+     * @throws tinydir_exception on IO error
+     */
+    void sync();
+
     /**
      * Closed the underlying file descriptor, will be called automatically 
      * on destruction
@@ -24,16 +24,47 @@
 #ifndef STATICLIB_TINYDIR_FILE_SOURCE_HPP
 #define STATICLIB_TINYDIR_FILE_SOURCE_HPP
 
+#include <cstdint>
 #include <string>
+#include <system_error>
+#include <vector>
 
 #include "staticlib/config.hpp"
 #include "staticlib/io/span.hpp"
 
+#include "staticlib/tinydir/file_status.hpp"
 #include "staticlib/tinydir/tinydir_exception.hpp"
 
 namespace staticlib {
 namespace tinydir {
 
+class directory;
+
+/**
+ * Range of a file that contains data, holes of sparse files are not
+ * included into extents
+ */
+struct file_extent {
+    /**
+     * Offset of the range from the beginning of the file
+     */
+    uint64_t offset;
+    /**
+     * Length of the range in bytes
+     */
+    uint64_t length;
+
+    /**
+     * Constructor
+     *
+     * @param offset range offset
+     * @param length range length
+     */
+    file_extent(uint64_t offset, uint64_t length) :
+    offset(offset),
+    length(length) { }
+};
+
 /**
  * Implementation of a file descriptor/handle wrapper with a 
  * unified interface for *nix and windows
@@ -52,6 +83,19 @@ class file_source {
      */
     std::string file_path;
 
+#ifndef STATICLIB_WINDOWS
+    friend class directory;
+
+    /**
+     * Private constructor for the descriptors opened
+     * relative to a directory handle
+     *
+     * @param fd open file descriptor, ownership is taken
+     * @param file_path path to file
+     */
+    file_source(int fd, std::string file_path);
+#endif // !STATICLIB_WINDOWS
+
 public:
     /**
      * Constructor
@@ -60,6 +104,15 @@ public:
      */
     file_source(const std::string& file_path);
 
+    /**
+     * Non-throwing constructor, on failure the error is reported
+     * through "ec" and the instance is left closed
+     *
+     * @param file_path path to file
+     * @param ec error code, cleared on success
+     */
+    file_source(const std::string& file_path, std::error_code& ec);
+
     /**
      * Destructor, will close the descriptor
      */
@@ -122,6 +175,59 @@ public:
      */
     off_t size();
 
+    /**
+     * Reads FS metadata of the file pointed by this descriptor,
+     * result is not affected by renames or removal of the path
+     *
+     * @return metadata of the opened file
+     * @throws tinydir_exception on IO error
+     */
+    file_status status();
+
+    /**
+     * Returns the ranges of this file that contain data, holes of sparse
+     * files are skipped. If FS cannot report holes, the whole file
+     * is returned as a single extent. Current position is not changed.
+     *
+     * @return data extents sorted by offset
+     */
+    std::vector<file_extent> data_extents();
+
+    /**
+     * Transfers the range of this file to the specified descriptor without
+     * copying the data to user space, "sendfile" is used for sockets and
+     * "splice" for pipes (linux), other descriptors and platforms fall back
+     * to reads and writes. Partial transfers are repeated until "count" bytes
+     * are sent or EOF is reached. If the destination is non-blocking and
+     * cannot accept more data after some bytes were sent, transferred number
+     * of bytes is returned, transfer can be resumed from "offset" plus this number.
+     * Current position of this file is not changed.
+     * Not supported on windows.
+     *
+     * @param dest_fd destination descriptor
+     * @param offset offset in this file to start from
+     * @param count maximum number of bytes to transfer
+     * @return number of bytes transferred, less than "count" on EOF
+     *         or when non-blocking destination is full, zero only
+     *         if "offset" is at EOF or "count" is zero
+     * @throws tinydir_exception on IO error or if non-blocking destination
+     *         cannot accept any data
+     */
+    uint64_t transfer_to(int dest_fd, uint64_t offset, uint64_t count);
+
+    /**
+     * Non-throwing version of "transfer_to", when non-blocking destination
+     * is full, "ec" is set to "operation_would_block" and the number of bytes
+     * transferred so far (possibly zero) is returned.
+     *
+     * @param dest_fd destination descriptor
+     * @param offset offset in this file to start from
+     * @param count maximum number of bytes to transfer
+     * @param ec error code, cleared when transfer stopped on "count" or EOF
+     * @return number of bytes transferred before the transfer stopped
+     */
+    uint64_t transfer_to(int dest_fd, uint64_t offset, uint64_t count, std::error_code& ec);
+
     /**
      * Closed the underlying file descriptor, will be called automatically 
      * on destruction
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_status.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:05 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_FILE_STATUS_HPP
+#define STATICLIB_TINYDIR_FILE_STATUS_HPP
+
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Type of the FS entry
+ */
+enum class file_type {
+    not_found, regular_file, directory, symlink, other
+};
+
+/**
+ * FS metadata of a file or directory, filled from a single "stat" call
+ */
+struct file_status {
+    /**
+     * Type of the entry, "not_found" if entry does not exist
+     */
+    file_type type = file_type::not_found;
+    /**
+     * Apparent size in bytes
+     */
+    uint64_t size = 0;
+    /**
+     * Number of bytes actually allocated on disk
+     */
+    uint64_t allocated_size = 0;
+    /**
+     * Modification time in nanoseconds since epoch
+     */
+    int64_t mtime_ns = 0;
+    /**
+     * Permission bits
+     */
+    uint32_t mode = 0;
+    /**
+     * ID of the device containing the entry (volume serial number on windows)
+     */
+    uint64_t device = 0;
+    /**
+     * Inode number (file index on windows)
+     */
+    uint64_t inode = 0;
+    /**
+     * Number of hard links
+     */
+    uint64_t links_count = 0;
+};
+
+/**
+ * Reads FS metadata of the specified path, symlinks are followed.
+ *
+ * @param path path to file or directory
+ * @return metadata of the entry, "not_found" type if entry does not exist
+ * @throws tinydir_exception on IO error
+ */
+file_status status(const std::string& path);
+
+/**
+ * Reads FS metadata of the specified path, symlinks are followed.
+ * Does not throw on IO error.
+ *
+ * @param path path to file or directory
+ * @param ec set to IO error code, cleared on success and when entry does not exist
+ * @return metadata of the entry, "not_found" type if entry does not exist or on error
+ */
+file_status status(const std::string& path, std::error_code& ec);
+
+/**
+ * Reads FS metadata of the specified path, symlinks are NOT followed.
+ *
+ * @param path path to file, directory or symlink
+ * @return metadata of the entry, "not_found" type if entry does not exist
+ * @throws tinydir_exception on IO error
+ */
+file_status symlink_status(const std::string& path);
+
+/**
+ * Sets the modification time (and access time) of the specified file
+ *
+ * @param path path to file or directory
+ * @param mtime_ns modification time in nanoseconds since epoch
+ * @throws tinydir_exception on IO error
+ */
+void set_modification_time(const std::string& path, int64_t mtime_ns);
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_FILE_STATUS_HPP */
+
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fingerprint.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 2:10 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_FINGERPRINT_HPP
+#define STATICLIB_TINYDIR_FINGERPRINT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Content fingerprint of a file
+ */
+struct file_fingerprint {
+    /**
+     * Path to file
+     */
+    std::string filepath;
+    /**
+     * Number of bytes hashed
+     */
+    uint64_t size = 0;
+    /**
+     * XXH64 hash (seed 0) of the file contents
+     */
+    uint64_t xxh64 = 0;
+    /**
+     * Hex-encoded SHA-256 hash of the file contents, empty if not requested
+     */
+    std::string sha256;
+};
+
+/**
+ * Fingerprinting options
+ */
+struct fingerprint_options {
+    /**
+     * Compute SHA-256 in addition to XXH64
+     */
+    bool sha256 = false;
+    /**
+     * Size of the read buffer for each worker thread
+     */
+    size_t buffer_size = 1 << 20;
+    /**
+     * Number of worker threads, zero to use the number of hardware threads
+     */
+    size_t threads_count = 0;
+};
+
+/**
+ * Duplicates search options
+ */
+struct duplicates_options {
+    /**
+     * Number of bytes read from the beginning and from the end
+     * of each candidate file on the partial hash stage
+     */
+    size_t partial_size = 1 << 16;
+    /**
+     * Files smaller than this size are ignored
+     */
+    uint64_t min_size = 1;
+    /**
+     * Confirm full-content matches with SHA-256 computed on the full hash stage,
+     * instead of comparing the contents of the matched files byte by byte
+     */
+    bool sha256 = false;
+    /**
+     * Size of the read buffer for each worker thread
+     */
+    size_t buffer_size = 1 << 20;
+    /**
+     * Number of worker threads, zero to use the number of hardware threads
+     */
+    size_t threads_count = 0;
+};
+
+/**
+ * Computes the fingerprint of the specified file reading it sequentially
+ * with large reads
+ *
+ * @param file_path path to file
+ * @param options fingerprinting options, "threads_count" is ignored
+ * @return file fingerprint
+ * @throws tinydir_exception on IO error
+ */
+file_fingerprint fingerprint_file(const std::string& file_path,
+        const fingerprint_options& options = fingerprint_options());
+
+/**
+ * Computes fingerprints of the specified files in parallel
+ *
+ * @param file_paths paths to files
+ * @param options fingerprinting options
+ * @return fingerprints in the same order as the specified paths
+ * @throws tinydir_exception on IO error
+ */
+std::vector<file_fingerprint> fingerprint_files(const std::vector<std::string>& file_paths,
+        const fingerprint_options& options = fingerprint_options());
+
+/**
+ * Finds groups of regular files with identical contents in the specified
+ * directory trees. Candidates are first grouped by size, then by the hash
+ * of their head and tail, only the files that still collide are hashed fully.
+ * Full hash matches are then compared byte by byte (or by SHA-256, see options).
+ * Hard links to the same inode are reported only once. Symlinks are not followed.
+ *
+ * @param root_dirs paths to directories to search
+ * @param options search options
+ * @return groups of paths (each with at least two entries) to identical files,
+ *         paths are sorted inside each group, groups are sorted by their first path
+ * @throws tinydir_exception on IO error
+ */
+std::vector<std::vector<std::string>> find_duplicates(const std::vector<std::string>& root_dirs,
+        const duplicates_options& options = duplicates_options());
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_FINGERPRINT_HPP */
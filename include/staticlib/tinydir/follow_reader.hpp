@@ -0,0 +1,218 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   follow_reader.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 12:40 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_FOLLOW_READER_HPP
+#define STATICLIB_TINYDIR_FOLLOW_READER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io/span.hpp"
+
+#include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/file_status.hpp"
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Options for following a growing file
+ */
+struct follow_options {
+    /**
+     * Interval of checks for new data when change notifications
+     * are not available
+     */
+    std::chrono::milliseconds poll_interval = std::chrono::milliseconds(250);
+    /**
+     * Whether to skip the data existing when the file is first opened,
+     * files created after rotation are always read from the beginning
+     */
+    bool start_at_end = false;
+};
+
+/**
+ * Reader that follows a file growing at the end (like "tail -F").
+ * Waiting for new data uses "inotify" on linux and periodic checks
+ * on other systems. If the file is truncated, it is read again from the
+ * beginning; if the path is pointed to a new file (rotation), the remaining
+ * data of the old file is read first and then the new file is opened.
+ * File may not exist when the reader is created.
+ */
+class follow_reader {
+    /**
+     * Path to file
+     */
+    std::string file_path;
+    /**
+     * Options
+     */
+    follow_options options;
+    /**
+     * Currently opened file, empty if file does not exist
+     */
+    std::unique_ptr<file_source> src;
+    /**
+     * Metadata of the opened file at the time it was opened
+     */
+    file_status opened;
+    /**
+     * Position in currently opened file
+     */
+    uint64_t position = 0;
+    /**
+     * Number of times the file was reopened after rotation
+     */
+    uint64_t reopens = 0;
+#ifndef STATICLIB_WINDOWS
+    /**
+     * "inotify" descriptor, -1 if notifications are not used
+     */
+    int notify_fd = -1;
+    /**
+     * Watch of the parent directory
+     */
+    int dir_watch = -1;
+    /**
+     * Watch of the opened file
+     */
+    int file_watch = -1;
+#endif // !STATICLIB_WINDOWS
+
+public:
+    /**
+     * Constructor
+     *
+     * @param file_path path to file
+     * @param options follow options
+     * @throws tinydir_exception if existing file cannot be opened
+     */
+    explicit follow_reader(const std::string& file_path, follow_options options = follow_options());
+
+    /**
+     * Destructor
+     */
+    ~follow_reader() STATICLIB_NOEXCEPT;
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    follow_reader(const follow_reader&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    follow_reader& operator=(const follow_reader&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    follow_reader(follow_reader&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    follow_reader& operator=(follow_reader&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Reads data appended to the file, does not block waiting for new data
+     *
+     * @param span destination buffer
+     * @return number of bytes read, zero if no new data is available
+     * @throws tinydir_exception on IO error
+     */
+    std::streamsize read(sl::io::span<char> span);
+
+    /**
+     * Reads data appended to the file, waits for new data
+     * up to the specified timeout
+     *
+     * @param span destination buffer
+     * @param timeout maximum time to wait
+     * @return number of bytes read, zero on timeout
+     * @throws tinydir_exception on IO error
+     */
+    std::streamsize read(sl::io::span<char> span, std::chrono::milliseconds timeout);
+
+    /**
+     * Waits for a change of the file or for the poll interval
+     *
+     * @param timeout maximum time to wait
+     * @return false if nothing was changed before timeout,
+     *         true if file may have changed
+     * @throws tinydir_exception on IO error
+     */
+    bool wait(std::chrono::milliseconds timeout);
+
+    /**
+     * Position in currently opened file
+     *
+     * @return offset of the next byte to read
+     */
+    uint64_t offset() const;
+
+    /**
+     * Number of times the file was reopened after rotation
+     *
+     * @return reopens count
+     */
+    uint64_t reopens_count() const;
+
+    /**
+     * Whether FS change notifications are used instead of polling
+     *
+     * @return true if notifications are used
+     */
+    bool is_notified() const;
+
+    /**
+     * File path accessor
+     *
+     * @return path to followed file
+     */
+    const std::string& path() const;
+
+private:
+    bool open_file(bool initial);
+
+    void close_notify() STATICLIB_NOEXCEPT;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_FOLLOW_READER_HPP */
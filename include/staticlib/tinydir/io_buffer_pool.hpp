@@ -0,0 +1,207 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   io_buffer_pool.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 8:40 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_IO_BUFFER_POOL_HPP
+#define STATICLIB_TINYDIR_IO_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io/span.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Page-aligned buffer borrowed from the process-wide IO buffer pool,
+ * buffer is returned to the pool on destruction
+ */
+class io_buffer {
+    /**
+     * Aligned memory block
+     */
+    char* ptr = nullptr;
+    /**
+     * Capacity of the block
+     */
+    size_t len = 0;
+
+    friend io_buffer acquire_io_buffer(size_t min_size);
+
+    io_buffer(char* ptr, size_t len);
+
+public:
+    /**
+     * Constructor for an empty buffer
+     */
+    io_buffer() { }
+
+    /**
+     * Destructor, returns the buffer to the pool
+     */
+    ~io_buffer() STATICLIB_NOEXCEPT;
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    io_buffer(const io_buffer&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    io_buffer& operator=(const io_buffer&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    io_buffer(io_buffer&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    io_buffer& operator=(io_buffer&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Pointer to the buffer memory, aligned to 4096 bytes
+     *
+     * @return buffer memory, "nullptr" for empty buffer
+     */
+    char* data() {
+        return ptr;
+    }
+
+    /**
+     * Pointer to the buffer memory, aligned to 4096 bytes
+     *
+     * @return buffer memory, "nullptr" for empty buffer
+     */
+    const char* data() const {
+        return ptr;
+    }
+
+    /**
+     * Buffer capacity, may be larger than the requested size
+     *
+     * @return buffer size in bytes
+     */
+    size_t size() const {
+        return len;
+    }
+
+    /**
+     * Span over the whole buffer
+     *
+     * @return span
+     */
+    sl::io::span<char> span() {
+        return {ptr, len};
+    }
+
+    /**
+     * Returns the buffer to the pool early, instance becomes empty
+     */
+    void release() STATICLIB_NOEXCEPT;
+};
+
+/**
+ * Usage counters of the IO buffer pool
+ */
+struct io_buffer_pool_stats {
+    /**
+     * Number of buffers acquired
+     */
+    uint64_t acquired = 0;
+    /**
+     * Number of buffers taken from the cache of the calling thread
+     */
+    uint64_t thread_cache_hits = 0;
+    /**
+     * Number of buffers taken from the shared cache
+     */
+    uint64_t shared_cache_hits = 0;
+    /**
+     * Number of buffers allocated from the heap
+     */
+    uint64_t allocations = 0;
+    /**
+     * Number of buffers returned to the heap
+     */
+    uint64_t deallocations = 0;
+    /**
+     * Total size of buffers currently borrowed
+     */
+    uint64_t in_use_bytes = 0;
+    /**
+     * Total size of buffers currently kept in thread and shared caches
+     */
+    uint64_t cached_bytes = 0;
+};
+
+/**
+ * Borrows a buffer from the pool. Buffers are grouped into power-of-two
+ * size classes from 4 KiB to 4 MiB, each thread keeps a few released
+ * buffers (up to 8 MiB), other released buffers are kept in the shared
+ * cache up to the configured limit. Larger buffers are not cached.
+ *
+ * @param min_size minimal required buffer size
+ * @return buffer of at least "min_size" bytes
+ * @throws std::bad_alloc if memory cannot be allocated
+ */
+io_buffer acquire_io_buffer(size_t min_size);
+
+/**
+ * Returns counters aggregated over all threads since the start of the process
+ *
+ * @return counters snapshot
+ */
+io_buffer_pool_stats io_buffer_pool_snapshot();
+
+/**
+ * Sets the maximum total size of buffers kept in the shared cache,
+ * default limit is 64 MiB, excess buffers are freed immediately
+ *
+ * @param max_cached_bytes limit in bytes
+ */
+void io_buffer_pool_set_limit(size_t max_cached_bytes);
+
+/**
+ * Frees all buffers kept in the shared cache and in the cache
+ * of the calling thread
+ */
+void io_buffer_pool_trim();
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_IO_BUFFER_POOL_HPP */
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   io_stats.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:05 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_IO_STATS_HPP
+#define STATICLIB_TINYDIR_IO_STATS_HPP
+
+#include <cstdint>
+#include <array>
+#include <functional>
+#include <string>
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Categories of system calls issued by this library
+ */
+enum class io_op {
+    open, close, read, write, seek, stat, read_directory, create_directory,
+    rename, remove, copy, symlink, resize, full_path, set_times, sync, link,
+    /**
+     * Number of categories, not an operation
+     */
+    count
+};
+
+/**
+ * Number of buckets in latency histograms
+ */
+const size_t io_latency_buckets_count = 32;
+
+/**
+ * Counters for a single category of system calls
+ */
+struct io_op_stats {
+    /**
+     * Number of calls
+     */
+    uint64_t calls = 0;
+    /**
+     * Number of failed calls
+     */
+    uint64_t errors = 0;
+    /**
+     * Number of bytes transferred, for read, write and copy operations
+     */
+    uint64_t bytes = 0;
+    /**
+     * Total time spent in calls in nanoseconds
+     */
+    uint64_t total_ns = 0;
+    /**
+     * Latency histogram, bucket "i" counts the calls that took
+     * from 2^i to 2^(i+1) nanoseconds, last bucket counts all longer calls
+     */
+    std::array<uint64_t, io_latency_buckets_count> latency_histogram;
+
+    /**
+     * Constructor
+     */
+    io_op_stats() {
+        latency_histogram.fill(0);
+    }
+};
+
+/**
+ * Counters for all categories of system calls
+ */
+struct io_stats {
+    /**
+     * Counters indexed by "io_op" value
+     */
+    std::array<io_op_stats, static_cast<size_t> (io_op::count)> ops;
+
+    /**
+     * Returns counters for the specified category
+     *
+     * @param op category
+     * @return counters
+     */
+    const io_op_stats& get(io_op op) const {
+        return ops[static_cast<size_t> (op)];
+    }
+};
+
+/**
+ * Details of a single system call passed to the trace callback
+ */
+struct io_trace_event {
+    /**
+     * Category of the call
+     */
+    io_op op;
+    /**
+     * Path to file or directory the call was issued for
+     */
+    const std::string& path;
+    /**
+     * Number of bytes transferred
+     */
+    uint64_t bytes;
+    /**
+     * Duration of the call in nanoseconds
+     */
+    uint64_t duration_ns;
+    /**
+     * Whether the call failed
+     */
+    bool failed;
+};
+
+/**
+ * Returns whether the library was built with IO instrumentation
+ * ("STATICLIB_TINYDIR_ENABLE_IO_STATS" macro), when instrumentation is
+ * disabled all counters stay zero and trace callback is never called.
+ *
+ * @return true if instrumentation is enabled, false otherwise
+ */
+bool io_stats_enabled();
+
+/**
+ * Returns counters aggregated over all threads (including finished ones)
+ * since the start of the process or the last reset
+ *
+ * @return counters snapshot
+ */
+io_stats io_stats_snapshot();
+
+/**
+ * Returns counters for the calls made from the current thread
+ *
+ * @return counters snapshot
+ */
+io_stats io_stats_thread_snapshot();
+
+/**
+ * Sets all counters of all threads to zero
+ */
+void io_stats_reset();
+
+/**
+ * Sets the callback that is called (on the calling thread) after
+ * each system call, callback must be thread-safe and must not throw
+ *
+ * @param callback trace callback, empty function to disable tracing
+ */
+void io_stats_set_trace_callback(std::function<void(const io_trace_event&)> callback);
+
+/**
+ * Returns the name of the specified category
+ *
+ * @param op category
+ * @return category name
+ */
+const char* io_op_name(io_op op);
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_IO_STATS_HPP */
@@ -25,6 +25,7 @@
 #define STATICLIB_TINYDIR_OPERATIONS_HPP
 
 #include <string>
+#include <system_error>
 #include <vector>
 
 #include "staticlib/tinydir/path.hpp"
@@ -48,6 +49,35 @@ std::vector<path> list_directory(const std::string& dirpath);
  */
 void create_directory(const std::string& dirpath);
 
+/**
+ * Creates new FS directory with the specified path,
+ * non-throwing version
+ *
+ * @param dirpath path to directory to create
+ * @param ec error code, cleared on success
+ */
+void create_directory(const std::string& dirpath, std::error_code& ec);
+
+/**
+ * Creates FS directory with the specified path together with all
+ * missing parent directories, existing directory is not an error.
+ * Deepest existing ancestor is found by probing from the leaf upward,
+ * directories created concurrently by other callers are accepted.
+ *
+ * @param dirpath path to directory to create
+ * @throws tinydir_exception on IO error
+ */
+void create_directories(const std::string& dirpath);
+
+/**
+ * Creates FS directory with the specified path together with all
+ * missing parent directories, non-throwing version
+ *
+ * @param dirpath path to directory to create
+ * @param ec error code, cleared on success
+ */
+void create_directories(const std::string& dirpath, std::error_code& ec);
+
 /**
  * Convert backslashes to forward ones, removes duplicate slashes,
  * removes end slash. Does NOT touch FS.
@@ -66,6 +96,16 @@ std::string normalize_path(const std::string& path);
  */
 std::string full_path(const std::string& path);
 
+/**
+ * Converts relative path to absolute one, non-throwing version.
+ * Calls FS.
+ *
+ * @param path relative path
+ * @param ec error code, cleared on success
+ * @return absolute path, empty string on error
+ */
+std::string full_path(const std::string& path, std::error_code& ec);
+
 /**
  * Creates a symbolic link to the specified dest path.
  *
@@ -74,6 +114,15 @@ std::string full_path(const std::string& path);
  */
 void create_symlink(const std::string& dest, const std::string& path);
 
+/**
+ * Creates a hard link to the specified existing file,
+ * both paths must be on the same FS.
+ *
+ * @param dest existing file path
+ * @param path new link path
+ */
+void create_hardlink(const std::string& dest, const std::string& path);
+
 } // namespace
 }
 
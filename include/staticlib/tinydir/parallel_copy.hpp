@@ -0,0 +1,83 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   parallel_copy.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:50 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_PARALLEL_COPY_HPP
+#define STATICLIB_TINYDIR_PARALLEL_COPY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "staticlib/config.hpp"
+
+#include "staticlib/tinydir/chunked_reader.hpp"
+#include "staticlib/tinydir/path.hpp"
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Options for the multi-range copy of a single file
+ */
+struct parallel_copy_options {
+    /**
+     * Number of worker threads, zero to use the number of hardware threads
+     */
+    size_t threads_count = 0;
+    /**
+     * Size of a single range copied by one worker
+     */
+    uint64_t chunk_size = 64 << 20;
+    /**
+     * Progress callback, called with the range and the number of bytes
+     * of this range copied so far, at least once per 16 MiB and once when
+     * the range is finished. Calls are made from worker threads, but never
+     * concurrently.
+     */
+    std::function<void(const file_chunk&, uint64_t)> on_progress;
+};
+
+/**
+ * Copies a regular file splitting it into ranges that are copied concurrently
+ * ("copy_file_range" with explicit offsets on linux, "pread" and "pwrite" on
+ * other systems). Disk space for the whole file is preallocated,
+ * holes of sparse files are not preserved. Data is copied into a temporary
+ * sibling of the target, that is flushed to disk and renamed into place
+ * only after all ranges are finished, so the target never contains
+ * partially copied data. On windows the file is copied sequentially.
+ *
+ * @param from source file path
+ * @param to target file path
+ * @param options copy options
+ * @return target path instance
+ * @throws tinydir_exception on IO error, temporary file is removed
+ */
+path parallel_copy_file(const std::string& from, const std::string& to,
+        const parallel_copy_options& options = parallel_copy_options());
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_PARALLEL_COPY_HPP */
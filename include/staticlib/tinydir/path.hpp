@@ -25,12 +25,14 @@
 #define STATICLIB_TINYDIR_PATH_HPP
 
 #include <string>
+#include <system_error>
 
 #include "staticlib/config/noexcept.hpp"
 
 #include "staticlib/tinydir/tinydir_exception.hpp"
 #include "staticlib/tinydir/file_sink.hpp"
 #include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/file_status.hpp"
 
 namespace staticlib {
 namespace tinydir {
@@ -45,8 +47,46 @@ class path {
     bool is_dir = false;
     bool is_reg = false;
     bool is_exist = false;
+    bool has_status = false;
+    bool is_lazy = false;
+    file_status fstatus;
 
 public:
+    /**
+     * Rename mode
+     */
+    enum class rename_mode {
+        /**
+         * Existing target is replaced
+         */
+        replace,
+        /**
+         * Rename fails if target exists
+         */
+        no_replace,
+        /**
+         * Source and target (both must exist) are exchanged atomically
+         */
+        exchange
+    };
+
+    /**
+     * Clone mode, defines how regular files are cloned
+     */
+    enum class clone_mode {
+        /**
+         * Files are hard-linked to the source ones (like "cp -al"),
+         * changes to the contents of the file are visible through both paths
+         */
+        hardlink,
+        /**
+         * Files share the data with the source ones copy-on-write
+         * ("FICLONE" on linux, "clonefile" on mac), files are copied
+         * if FS does not support shared extents
+         */
+        reflink
+    };
+
     /**
      * Constructor
      * 
@@ -84,6 +124,20 @@ public:
      */
     path& operator=(path&& other) STATICLIB_NOEXCEPT;
  
+    /**
+     * Composes the path to the child of this directory, the name is appended
+     * to the normalized path of this instance without normalizing it again
+     * (names that contain separators are normalized). Unlike the string
+     * constructor, does not list the parent directory: existence, type and
+     * metadata of the returned instance are read from FS (with "lstat")
+     * on every call to the corresponding accessor.
+     *
+     * @param name child name
+     * @return path to the child
+     * @throws tinydir_exception if name is empty or contains "." or ".." components
+     */
+    path operator/(const std::string& name) const;
+
     /**
      * Returns FS path to this file
      * 
@@ -101,6 +155,7 @@ public:
     /**
      * Returns whether this file existed in FS
      * at the time of this instance creation
+     * (at the time of the call for composed paths)
      * 
      * @return true is file exists, false otherwise
      */
@@ -119,6 +174,19 @@ public:
      * @return whether this instance represents a regular file
      */
     bool is_regular_file() const;
+
+    /**
+     * Returns FS metadata of this file, symlinks are NOT followed.
+     * Instances returned from "list_directory" (and created from a string
+     * path on posix) carry the metadata read by the same "lstat" call that
+     * determined the file type, so sorting or filtering the listing
+     * by size or time does not require another call per entry.
+     * Otherwise metadata is read from FS on every call.
+     *
+     * @return metadata of the file, "not_found" type if file does not exist
+     * @throws tinydir_exception on IO error
+     */
+    file_status symlink_status() const;
     
     /**
      * Open current file for reading
@@ -153,11 +221,34 @@ public:
  
     /**
      * Renames this file or directory to the target path.
+     * "no_replace" and "exchange" modes are atomic, they require
+     * "renameat2" support on linux and "renamex_np" on macos,
+     * "exchange" is not supported on windows.
      * 
      * @param target target path
+     * @param mode rename mode
      * @returns target path instance
      */
-    path rename(const std::string& target) const;
+    path rename(const std::string& target, rename_mode mode = rename_mode::replace) const;
+
+    /**
+     * Renames this file or directory to the target path,
+     * non-throwing version, target path is not read back from FS.
+     *
+     * @param target target path
+     * @param ec error code, cleared on success
+     */
+    void rename(const std::string& target, std::error_code& ec) const;
+
+    /**
+     * Renames this file or directory to the target path using the
+     * specified mode, non-throwing version
+     *
+     * @param target target path
+     * @param mode rename mode
+     * @param ec error code, cleared on success
+     */
+    void rename(const std::string& target, rename_mode mode, std::error_code& ec) const;
 
     /**
      * Copies this file to the target path
@@ -167,6 +258,47 @@ public:
      */
     path copy_file(const std::string& target) const;
 
+    /**
+     * Copies this file to the target path, non-throwing version,
+     * target path is not read back from FS.
+     *
+     * @param target target file path
+     * @param ec error code, cleared on success
+     */
+    void copy_file(const std::string& target, std::error_code& ec) const;
+
+    /**
+     * Moves this file or directory to the target path. Rename is tried
+     * first, if the target is on a different file system, the entry is
+     * copied (directory contents - in parallel) preserving permissions
+     * and modification times into a temporary sibling of the target,
+     * renamed into place, and only then the source is removed.
+     *
+     * @param target target path
+     * @param threads_count number of threads used to copy directory contents,
+     *        zero to use the number of hardware threads
+     * @return target path instance
+     * @throws tinydir_exception on IO error
+     */
+    path move(const std::string& target, size_t threads_count = 0) const;
+
+    /**
+     * Clones this file or directory to the target path, directory structure
+     * is recreated preserving permissions and modification times, symlinks
+     * are copied and regular files are linked in parallel, so unchanged
+     * trees can be snapshotted with metadata operations only.
+     * Target must not exist and must be on the same FS.
+     *
+     * @param target target path
+     * @param mode clone mode for regular files
+     * @param threads_count number of threads used to link the files,
+     *        zero to use the number of hardware threads
+     * @return target path instance
+     * @throws tinydir_exception on IO error
+     */
+    path clone(const std::string& target, clone_mode mode = clone_mode::hardlink,
+            size_t threads_count = 0) const;
+
     /**
      * Resizes this file to the target size.
      * Creates a file if it does not exist.
@@ -180,6 +312,9 @@ public:
 
     path(std::nullptr_t, void* /* tinydir_file* */ file);
 
+private:
+    path(std::string&& fpath, std::string&& fname);
+
 };
 
 } // namespace
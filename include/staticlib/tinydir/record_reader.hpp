@@ -0,0 +1,169 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   record_reader.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:55 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_RECORD_READER_HPP
+#define STATICLIB_TINYDIR_RECORD_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io/span.hpp"
+
+#include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/io_buffer_pool.hpp"
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Reader of delimited records (lines by default) from a file. Records
+ * are returned as spans pointing into the internal buffer without copying,
+ * delimiters are searched using SIMD instructions where supported.
+ * Partial record at the end of the buffer is moved to the beginning
+ * before reading more data, buffer is enlarged for records that
+ * do not fit into it.
+ */
+class record_reader {
+    /**
+     * Underlying file
+     */
+    file_source src;
+    /**
+     * Record delimiter
+     */
+    char delimiter;
+    /**
+     * Pooled read buffer
+     */
+    io_buffer buffer;
+    /**
+     * Start of the next record in buffer
+     */
+    size_t begin = 0;
+    /**
+     * Position in buffer from which the delimiter is searched
+     */
+    size_t scanned = 0;
+    /**
+     * End of data in buffer
+     */
+    size_t end = 0;
+    /**
+     * File offset of the beginning of the buffer
+     */
+    uint64_t buffer_offset = 0;
+    /**
+     * File offset of the last returned record
+     */
+    uint64_t record_offset = 0;
+    /**
+     * Whether the end of file was reached
+     */
+    bool eof = false;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param src file to read records from, records are read from
+     *        the current position
+     * @param delimiter record delimiter, not included into records
+     * @param buffer_size initial size of the buffer
+     */
+    explicit record_reader(file_source&& src, char delimiter = '\n', size_t buffer_size = 1 << 20);
+
+    /**
+     * Constructor
+     *
+     * @param file_path path to file
+     * @param delimiter record delimiter, not included into records
+     * @param buffer_size initial size of the buffer
+     * @throws tinydir_exception if file cannot be opened
+     */
+    explicit record_reader(const std::string& file_path, char delimiter = '\n', size_t buffer_size = 1 << 20);
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    record_reader(const record_reader&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    record_reader& operator=(const record_reader&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    record_reader(record_reader&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    record_reader& operator=(record_reader&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Reads the next record, last record is returned even if it
+     * does not end with the delimiter
+     *
+     * @param record span over the record, valid until the next call
+     * @return false at the end of file, true otherwise
+     * @throws tinydir_exception on IO error
+     */
+    bool next(sl::io::span<const char>& record);
+
+    /**
+     * Offset of the last returned record from the beginning of the file
+     *
+     * @return record offset in bytes
+     */
+    uint64_t offset() const;
+
+    /**
+     * Underlying file accessor
+     *
+     * @return file source
+     */
+    file_source& source();
+
+private:
+    void fill();
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_RECORD_READER_HPP */
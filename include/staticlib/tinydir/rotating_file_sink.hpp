@@ -0,0 +1,222 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   rotating_file_sink.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 1:45 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_ROTATING_FILE_SINK_HPP
+#define STATICLIB_TINYDIR_ROTATING_FILE_SINK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io/span.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Options for rotating file sink
+ */
+struct rotation_options {
+    /**
+     * Segment is rotated before the write that would make it larger
+     * than this size, zero disables size-based rotation
+     */
+    uint64_t max_segment_size = 64 << 20;
+    /**
+     * Segment is rotated on the first write after it became older
+     * than this age, zero disables time-based rotation
+     */
+    std::chrono::milliseconds max_segment_age = std::chrono::milliseconds(0);
+    /**
+     * Index of the first segment
+     */
+    uint64_t first_index = 1;
+    /**
+     * Whether to reserve "max_segment_size" bytes of disk space
+     * for every new segment
+     */
+    bool preallocate = true;
+    /**
+     * Whether to "fsync" retired segments before closing them
+     */
+    bool sync_retired = true;
+};
+
+class rotation_worker;
+
+/**
+ * Sink that writes into a sequence of files (segments) named as
+ * "<prefix>.<index>". Next segment is created and preallocated on
+ * a background thread in advance, so rotation on the writing thread
+ * only swaps the pointer; retired segments are synced and closed
+ * on the same background thread. Single write call is never split
+ * between segments. All segments, including the first one, are created
+ * exclusively - indices of existing files (i.e. left from earlier runs)
+ * are skipped, existing files are never truncated. Space reserved by
+ * preallocation beyond the written data is released when the segment
+ * is retired. Pre-created segment that was not used is removed on close.
+ */
+class rotating_file_sink {
+    /**
+     * Segments path prefix
+     */
+    std::string prefix;
+    /**
+     * Options
+     */
+    rotation_options options;
+    /**
+     * Background worker
+     */
+    std::unique_ptr<rotation_worker> worker;
+    /**
+     * Segment being written
+     */
+    std::unique_ptr<file_sink> current;
+    /**
+     * Index of the segment being written
+     */
+    uint64_t index = 0;
+    /**
+     * Number of bytes written into current segment
+     */
+    uint64_t written = 0;
+    /**
+     * Time when the current segment was opened
+     */
+    std::chrono::steady_clock::time_point opened_at;
+
+public:
+    /**
+     * Constructor, first segment is created on the calling thread,
+     * with the first free index starting from "first_index"
+     *
+     * @param path_prefix segments path prefix
+     * @param options rotation options
+     * @throws tinydir_exception if first segment cannot be created
+     */
+    explicit rotating_file_sink(const std::string& path_prefix,
+            rotation_options options = rotation_options());
+
+    /**
+     * Destructor, will close current segment, background
+     * errors are ignored
+     */
+    ~rotating_file_sink() STATICLIB_NOEXCEPT;
+
+    /**
+     * Deleted copy constructor
+     *
+     * @param other instance
+     */
+    rotating_file_sink(const rotating_file_sink&) = delete;
+
+    /**
+     * Deleted copy assignment operator
+     *
+     * @param other instance
+     * @return this instance
+     */
+    rotating_file_sink& operator=(const rotating_file_sink&) = delete;
+
+    /**
+     * Move constructor
+     *
+     * @param other other instance
+     */
+    rotating_file_sink(rotating_file_sink&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Move assignment operator
+     *
+     * @param other other instance
+     * @return this instance
+     */
+    rotating_file_sink& operator=(rotating_file_sink&& other) STATICLIB_NOEXCEPT;
+
+    /**
+     * Writes the whole span into current segment, rotates
+     * before writing if required by the options
+     *
+     * @param span source buffer
+     * @return number of bytes written, always equal to span size
+     * @throws tinydir_exception on IO error
+     */
+    std::streamsize write(sl::io::span<const char> span);
+
+    /**
+     * No-op
+     *
+     * @return zero
+     */
+    std::streamsize flush();
+
+    /**
+     * Switches writing to the next segment, does nothing
+     * if nothing was written into current segment
+     *
+     * @throws tinydir_exception if next segment cannot be created
+     *         or previously retired segment cannot be synced
+     */
+    void rotate();
+
+    /**
+     * Retires current segment waiting for it to be synced and closed,
+     * removes pre-created next segment and stops the background thread
+     *
+     * @throws tinydir_exception if some of retired segments cannot be synced
+     */
+    void close();
+
+    /**
+     * Index of the segment being written
+     *
+     * @return segment index
+     */
+    uint64_t segment_index() const;
+
+    /**
+     * Number of bytes written into current segment
+     *
+     * @return segment size
+     */
+    uint64_t segment_size() const;
+
+    /**
+     * Path to segment with the specified index
+     *
+     * @param idx segment index
+     * @return segment path
+     */
+    std::string segment_path(uint64_t idx) const;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_ROTATING_FILE_SINK_HPP */
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   tree_diff.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:44 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_TREE_DIFF_HPP
+#define STATICLIB_TINYDIR_TREE_DIFF_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "staticlib/tinydir/file_status.hpp"
+#include "staticlib/tinydir/tinydir_exception.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Single entry of the directory tree snapshot
+ */
+struct tree_entry {
+    /**
+     * Path relative to the tree root, with forward slashes
+     */
+    std::string relpath;
+    /**
+     * Metadata of the entry, symlinks are not followed
+     */
+    file_status status;
+};
+
+/**
+ * Metadata of all entries of the directory tree, sorted by the relative path.
+ * Instances of this class are completely disconnected from FS.
+ */
+class tree_snapshot {
+    std::vector<tree_entry> entries_list;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param entries tree entries in any order
+     */
+    explicit tree_snapshot(std::vector<tree_entry> entries = std::vector<tree_entry>());
+
+    /**
+     * Returns entries sorted by relative path
+     *
+     * @return entries list
+     */
+    const std::vector<tree_entry>& entries() const;
+
+    /**
+     * Finds an entry by its relative path
+     *
+     * @param relpath relative path
+     * @return pointer to entry, "nullptr" if not found
+     */
+    const tree_entry* find(const std::string& relpath) const;
+
+    /**
+     * Writes this snapshot into the specified file
+     *
+     * @param file_path path to snapshot file
+     * @throws tinydir_exception on IO error
+     */
+    void save(const std::string& file_path) const;
+
+    /**
+     * Reads the snapshot previously written with "save"
+     *
+     * @param file_path path to snapshot file
+     * @return snapshot instance
+     * @throws tinydir_exception on IO or format error
+     */
+    static tree_snapshot load(const std::string& file_path);
+};
+
+/**
+ * Kind of difference between two trees
+ */
+enum class tree_change_kind {
+    added, removed, modified
+};
+
+/**
+ * Single difference between the source and target trees
+ */
+struct tree_change {
+    /**
+     * Kind of difference, expressed as an action required to turn the target into the source
+     */
+    tree_change_kind kind;
+    /**
+     * Path relative to the tree roots
+     */
+    std::string relpath;
+    /**
+     * Type of the entry in the source tree ("removed" changes use the target type)
+     */
+    file_type type;
+
+    /**
+     * Constructor
+     *
+     * @param kind kind of difference
+     * @param relpath relative path
+     * @param type entry type
+     */
+    tree_change(tree_change_kind kind, std::string relpath, file_type type) :
+    kind(kind),
+    relpath(std::move(relpath)),
+    type(type) { }
+};
+
+/**
+ * Tree comparison options
+ */
+struct tree_diff_options {
+    /**
+     * Regular files with the same size but different modification times
+     * are considered modified
+     */
+    bool compare_mtime = true;
+    /**
+     * Regular files with the same size are compared byte-by-byte,
+     * modification times are ignored
+     */
+    bool verify_content = false;
+    /**
+     * Number of worker threads, zero to use the number of hardware threads
+     */
+    size_t threads_count = 0;
+};
+
+/**
+ * Recursively reads the metadata of all entries of the specified directory,
+ * subdirectories are read in parallel. Symlinks are not followed.
+ *
+ * @param root_dir path to directory
+ * @param threads_count number of worker threads, zero to use the number of hardware threads
+ * @return tree snapshot
+ * @throws tinydir_exception on IO error
+ */
+tree_snapshot snapshot_tree(const std::string& root_dir, size_t threads_count = 0);
+
+/**
+ * Compares two snapshots, regular files are compared by size and
+ * (optionally) modification time, directories are compared by existence,
+ * symlinks - by size and modification time of the link itself.
+ * Entry type change is reported as a "removed" change followed by an "added" one.
+ *
+ * @param source source snapshot
+ * @param target target snapshot
+ * @param options comparison options, "verify_content" is ignored
+ * @return list of changes sorted by relative path
+ */
+std::vector<tree_change> diff_trees(const tree_snapshot& source, const tree_snapshot& target,
+        const tree_diff_options& options = tree_diff_options());
+
+/**
+ * Compares two directory trees on FS, see the snapshot overload for details.
+ *
+ * @param source_dir path to source directory
+ * @param target_dir path to target directory
+ * @param options comparison options
+ * @return list of changes sorted by relative path
+ * @throws tinydir_exception on IO error
+ */
+std::vector<tree_change> diff_trees(const std::string& source_dir, const std::string& target_dir,
+        const tree_diff_options& options = tree_diff_options());
+
+/**
+ * Makes the target directory tree a one-way mirror of the source one,
+ * only the differences are applied: removed entries are deleted,
+ * added and modified files are copied (in parallel) preserving their
+ * modification times. Target directory is created if it does not exist.
+ * With "verify_content" option, modification times of the target files
+ * found equal to the source ones are updated from the source.
+ *
+ * @param source_dir path to source directory
+ * @param target_dir path to target directory
+ * @param options comparison options
+ * @return list of applied changes
+ * @throws tinydir_exception on IO error
+ */
+std::vector<tree_change> mirror_tree(const std::string& source_dir, const std::string& target_dir,
+        const tree_diff_options& options = tree_diff_options());
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_TREE_DIFF_HPP */
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   append_log.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 3:40 AM
+ */
+
+#include "staticlib/tinydir/append_log.hpp"
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "staticlib/tinydir/file_status.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+append_log::append_log(const std::string& file_path) :
+sink(file_path, file_sink::open_mode::from_file),
+tail(0),
+committed(0),
+pending_count(0),
+broken(false) {
+    auto size = status(sink.path()).size;
+    tail.store(size);
+    committed.store(size);
+}
+
+uint64_t append_log::append(sl::io::span<const char> span) {
+    if (broken.load(std::memory_order_relaxed)) throw tinydir_exception(TRACEMSG(
+            "Attempt to append to broken log: [" + sink.path() + "]"));
+    uint64_t len = span.size();
+    auto offset = tail.fetch_add(len);
+    if (0 == len) {
+        return offset;
+    }
+    try {
+        sink.write_at(span, offset);
+    } catch (...) {
+        // range is never committed, readers stop before it
+        broken.store(true);
+        throw;
+    }
+    commit(offset, len);
+    return offset;
+}
+
+uint64_t append_log::size() const {
+    return tail.load();
+}
+
+uint64_t append_log::committed_size() const {
+    return committed.load();
+}
+
+bool append_log::is_broken() const {
+    return broken.load();
+}
+
+void append_log::sync() {
+    sink.sync();
+}
+
+const std::string& append_log::path() const {
+    return sink.path();
+}
+
+void append_log::commit(uint64_t offset, uint64_t length) {
+    // fast path, all preceding writes are completed
+    auto expected = offset;
+    if (committed.compare_exchange_strong(expected, offset + length)) {
+        // following ranges may have been completed before this one
+        if (pending_count.load() > 0) {
+            drain_pending();
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard{pending_mtx};
+        pending.emplace(offset, length);
+        pending_count.fetch_add(1);
+    }
+    // preceding range may have been committed after the check above
+    drain_pending();
+}
+
+void append_log::drain_pending() {
+    std::lock_guard<std::mutex> guard{pending_mtx};
+    for (;;) {
+        auto cur = committed.load();
+        auto it = pending.find(cur);
+        if (pending.end() == it) {
+            break;
+        }
+        // fast path never starts from the offset of a pending range,
+        // so this CAS does not fail
+        committed.compare_exchange_strong(cur, cur + it->second);
+        pending.erase(it);
+        pending_count.fetch_sub(1);
+    }
+}
+
+} // namespace
+}
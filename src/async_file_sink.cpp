@@ -0,0 +1,410 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   async_file_sink.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 2:50 AM
+ */
+
+#include "staticlib/tinydir/async_file_sink.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "mpsc_queue.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+// limits the number of buffers in a single vectored write
+const size_t max_batch_buffers = 256;
+
+// protects from lost wakeups, normally threads are notified explicitly
+const std::chrono::milliseconds wait_timeout = std::chrono::milliseconds(100);
+
+struct queue_entry {
+    std::string data;
+    // non-zero for flush markers
+    uint64_t ticket = 0;
+
+    queue_entry() { }
+
+    queue_entry(std::string&& data, uint64_t ticket) :
+    data(std::move(data)),
+    ticket(ticket) { }
+};
+
+} // namespace
+
+class async_sink_state {
+    file_sink sink;
+    std::string file_path;
+    async_sink_options options;
+    mpsc_queue<queue_entry> queue;
+    // "grow" mode only
+    std::mutex overflow_mtx;
+    std::deque<queue_entry> overflow;
+    std::atomic<bool> overflowed;
+    std::atomic<bool> writer_sleeping;
+    std::atomic<size_t> producers_waiting;
+    std::atomic<uint64_t> flush_tickets;
+    std::atomic<uint64_t> dropped;
+    std::atomic<bool> failed;
+    // written under "mtx", read without lock by producers
+    std::atomic<bool> closed;
+    // guarded by "mtx"
+    std::mutex mtx;
+    std::condition_variable writer_cv;
+    std::condition_variable space_cv;
+    std::condition_variable flush_cv;
+    uint64_t flushed = 0;
+    std::exception_ptr error;
+    bool stopping = false;
+    // must be the last member, started after all other are initialized
+    std::thread thread;
+
+public:
+    async_sink_state(file_sink&& sink, const async_sink_options& options) :
+    sink(std::move(sink)),
+    file_path(this->sink.path()),
+    options(options),
+    queue(options.queue_size),
+    overflowed(false),
+    writer_sleeping(false),
+    producers_waiting(0),
+    flush_tickets(0),
+    dropped(0),
+    failed(false),
+    closed(false),
+    thread([this] { run(); }) { }
+
+    async_sink_state(const async_sink_state&) = delete;
+
+    async_sink_state& operator=(const async_sink_state&) = delete;
+
+    ~async_sink_state() STATICLIB_NOEXCEPT {
+        stop();
+    }
+
+    void write(std::string&& data) {
+        check_open();
+        check_error();
+        if (data.empty()) {
+            return;
+        }
+        auto entry = queue_entry(std::move(data), 0);
+        if (async_backpressure::drop == options.backpressure && !overflowed.load()) {
+            if (!queue.try_push(entry)) {
+                dropped.fetch_add(entry.data.size(), std::memory_order_relaxed);
+                return;
+            }
+            wake_writer();
+        } else {
+            push(entry);
+        }
+    }
+
+    void flush() {
+        check_open();
+        auto ticket = flush_tickets.fetch_add(1) + 1;
+        // markers are never dropped
+        auto marker = queue_entry(std::string(), ticket);
+        push(marker);
+        std::unique_lock<std::mutex> lock{mtx};
+        flush_cv.wait(lock, [this, ticket] {
+            return flushed >= ticket;
+        });
+        if (nullptr != error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void close() {
+        stop();
+        sink.close();
+        if (nullptr != error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    uint64_t dropped_bytes() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    const std::string& path() const {
+        return file_path;
+    }
+
+private:
+    void check_open() {
+        if (closed.load()) throw tinydir_exception(TRACEMSG(
+                "Attempt to write into closed file: [" + file_path + "]"));
+    }
+
+    void check_error() {
+        if (failed.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> guard{mtx};
+            std::rethrow_exception(error);
+        }
+    }
+
+    void push(queue_entry& entry) {
+        // overflow list, once used, is used until the writer empties it to keep the order
+        if (!overflowed.load() && queue.try_push(entry)) {
+            wake_writer();
+            return;
+        }
+        if (async_backpressure::block != options.backpressure) {
+            std::lock_guard<std::mutex> guard{overflow_mtx};
+            overflow.emplace_back(std::move(entry));
+            overflowed.store(true);
+        } else {
+            std::unique_lock<std::mutex> lock{mtx};
+            producers_waiting.fetch_add(1);
+            while (!queue.try_push(entry)) {
+                space_cv.wait_for(lock, wait_timeout);
+            }
+            producers_waiting.fetch_sub(1);
+        }
+        wake_writer();
+    }
+
+    void wake_writer() {
+        // pairs with the check of the queue after "writer_sleeping" is set
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writer_sleeping.load()) {
+            std::lock_guard<std::mutex> guard{mtx};
+            writer_cv.notify_one();
+        }
+    }
+
+    void stop() STATICLIB_NOEXCEPT {
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            if (closed.load()) {
+                return;
+            }
+            closed.store(true);
+            stopping = true;
+        }
+        writer_cv.notify_one();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    // writer thread
+
+    void run() STATICLIB_NOEXCEPT {
+        auto batch = std::vector<queue_entry>();
+        auto spans = std::vector<sl::io::span<const char>>();
+        for (;;) {
+            batch.clear();
+            size_t bytes = 0;
+            while (batch.size() < max_batch_buffers && bytes < options.max_batch_size) {
+                queue_entry entry;
+                if (!queue.try_pop(entry)) {
+                    break;
+                }
+                bytes += entry.data.size();
+                batch.emplace_back(std::move(entry));
+            }
+            if (overflowed.load()) {
+                take_overflow(batch, bytes);
+            }
+            if (batch.empty()) {
+                if (!queue.empty()) {
+                    // push into the oldest cell is not completed yet
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (!sleep()) {
+                    return;
+                }
+                continue;
+            }
+            if (producers_waiting.load() > 0) {
+                std::lock_guard<std::mutex> guard{mtx};
+                space_cv.notify_all();
+            }
+            write_batch(batch, spans);
+        }
+    }
+
+    void take_overflow(std::vector<queue_entry>& batch, size_t bytes) {
+        std::lock_guard<std::mutex> guard{overflow_mtx};
+        // overflow entries are newer than all cells reserved in the queue (including ones
+        // with unfinished pushes), reservations made before adding them are visible under the lock
+        if (!queue.empty()) {
+            return;
+        }
+        while (!overflow.empty() && batch.size() < max_batch_buffers &&
+                bytes < options.max_batch_size) {
+            bytes += overflow.front().data.size();
+            batch.emplace_back(std::move(overflow.front()));
+            overflow.pop_front();
+        }
+        if (overflow.empty()) {
+            overflowed.store(false);
+        }
+    }
+
+    bool sleep() {
+        std::unique_lock<std::mutex> lock{mtx};
+        writer_sleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (queue.empty() && !overflowed.load()) {
+            if (stopping) {
+                writer_sleeping.store(false);
+                return false;
+            }
+            writer_cv.wait_for(lock, wait_timeout);
+        }
+        writer_sleeping.store(false);
+        return true;
+    }
+
+    void write_batch(std::vector<queue_entry>& batch, std::vector<sl::io::span<const char>>& spans) {
+        spans.clear();
+        for (auto& en : batch) {
+            if (0 == en.ticket) {
+                spans.emplace_back(en.data.data(), en.data.size());
+            } else {
+                // everything queued before the marker is written first
+                write_spans(spans);
+                spans.clear();
+                {
+                    std::lock_guard<std::mutex> guard{mtx};
+                    flushed = std::max(flushed, en.ticket);
+                }
+                flush_cv.notify_all();
+            }
+        }
+        write_spans(spans);
+    }
+
+    void write_spans(std::vector<sl::io::span<const char>>& spans) {
+        if (spans.empty() || failed.load(std::memory_order_relaxed)) {
+            // data is discarded after the error
+            return;
+        }
+        try {
+            while (!spans.empty()) {
+                auto written = static_cast<size_t> (sink.write_vector(spans));
+                // partial write, skips written buffers and a prefix of the next one
+                size_t count = 0;
+                while (count < spans.size() && written >= spans[count].size()) {
+                    written -= spans[count].size();
+                    count += 1;
+                }
+                spans.erase(spans.begin(), spans.begin() + static_cast<std::ptrdiff_t> (count));
+                if (written > 0) {
+                    auto& first = spans.front();
+                    first = sl::io::span<const char>(first.data() + written, first.size() - written);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> guard{mtx};
+            error = std::current_exception();
+            failed.store(true);
+        }
+    }
+};
+
+async_file_sink::async_file_sink(file_sink&& sink, async_sink_options options) :
+state(new async_sink_state(std::move(sink), options)) { }
+
+async_file_sink::async_file_sink(const std::string& file_path, file_sink::open_mode mode,
+        async_sink_options options) :
+async_file_sink(file_sink(file_path, mode), options) { }
+
+async_file_sink::~async_file_sink() STATICLIB_NOEXCEPT {
+    try {
+        close();
+    } catch (...) {
+        // ignore
+    }
+}
+
+async_file_sink::async_file_sink(async_file_sink&& other) STATICLIB_NOEXCEPT :
+state(std::move(other.state)) { }
+
+async_file_sink& async_file_sink::operator=(async_file_sink&& other) STATICLIB_NOEXCEPT {
+    try {
+        close();
+    } catch (...) {
+        // ignore
+    }
+    state = std::move(other.state);
+    return *this;
+}
+
+std::streamsize async_file_sink::write(sl::io::span<const char> span) {
+    if (nullptr == state.get()) throw tinydir_exception(TRACEMSG(
+            "Attempt to write into moved-from async sink"));
+    state->write(std::string(span.data(), span.size()));
+    return static_cast<std::streamsize> (span.size());
+}
+
+std::streamsize async_file_sink::write_buffer(std::string&& buffer) {
+    if (nullptr == state.get()) throw tinydir_exception(TRACEMSG(
+            "Attempt to write into moved-from async sink"));
+    auto len = buffer.size();
+    state->write(std::move(buffer));
+    return static_cast<std::streamsize> (len);
+}
+
+std::streamsize async_file_sink::flush() {
+    if (nullptr == state.get()) throw tinydir_exception(TRACEMSG(
+            "Attempt to flush moved-from async sink"));
+    state->flush();
+    return 0;
+}
+
+void async_file_sink::close() {
+    if (nullptr != state.get()) {
+        state->close();
+    }
+}
+
+uint64_t async_file_sink::dropped_bytes() const {
+    return nullptr != state.get() ? state->dropped_bytes() : 0;
+}
+
+const std::string& async_file_sink::path() const {
+    if (nullptr == state.get()) throw tinydir_exception(TRACEMSG(
+            "Attempt to access moved-from async sink"));
+    return state->path();
+}
+
+} // namespace
+}
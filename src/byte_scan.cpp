@@ -0,0 +1,141 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   byte_scan.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:45 PM
+ */
+
+#include "byte_scan.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STATICLIB_TINYDIR_SCAN_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
+// AVX2 code is compiled separately from the rest of the file and is
+// only called after the runtime check
+#ifdef STATICLIB_TINYDIR_SCAN_SSE2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STATICLIB_TINYDIR_SCAN_AVX2
+#define STATICLIB_TINYDIR_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && _MSC_VER >= 1900
+#define STATICLIB_TINYDIR_SCAN_AVX2
+#define STATICLIB_TINYDIR_TARGET_AVX2
+#include <immintrin.h>
+#include <intrin.h>
+#endif // __GNUC__
+#endif // STATICLIB_TINYDIR_SCAN_SSE2
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+typedef const char* (*scan_fun)(const char*, const char*, char);
+
+const char* scan_scalar(const char* begin, const char* end, char ch) {
+    for (; begin < end; ++begin) {
+        if (ch == *begin) {
+            return begin;
+        }
+    }
+    return end;
+}
+
+#ifdef STATICLIB_TINYDIR_SCAN_SSE2
+
+unsigned first_set_bit(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long res = 0;
+    _BitScanForward(&res, mask);
+    return static_cast<unsigned> (res);
+#else // !_MSC_VER
+    return static_cast<unsigned> (__builtin_ctz(mask));
+#endif // _MSC_VER
+}
+
+const char* scan_sse2(const char* begin, const char* end, char ch) {
+    auto needle = _mm_set1_epi8(ch);
+    for (; end - begin >= 16; begin += 16) {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (begin));
+        auto mask = static_cast<unsigned> (_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+        if (0 != mask) {
+            return begin + first_set_bit(mask);
+        }
+    }
+    return scan_scalar(begin, end, ch);
+}
+
+#endif // STATICLIB_TINYDIR_SCAN_SSE2
+
+#ifdef STATICLIB_TINYDIR_SCAN_AVX2
+
+STATICLIB_TINYDIR_TARGET_AVX2
+const char* scan_avx2(const char* begin, const char* end, char ch) {
+    auto needle = _mm256_set1_epi8(ch);
+    for (; end - begin >= 32; begin += 32) {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (begin));
+        auto mask = static_cast<unsigned> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        if (0 != mask) {
+            return begin + first_set_bit(mask);
+        }
+    }
+    return scan_sse2(begin, end, ch);
+}
+
+bool avx2_supported() {
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    // OSXSAVE and AVX
+    if ((regs[2] & (1 << 27)) == 0 || (regs[2] & (1 << 28)) == 0) return false;
+    // YMM state is enabled by OS
+    if ((_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(regs, 7, 0);
+    return 0 != (regs[1] & (1 << 5));
+#else // !_MSC_VER
+    __builtin_cpu_init();
+    return 0 != __builtin_cpu_supports("avx2");
+#endif // _MSC_VER
+}
+
+#endif // STATICLIB_TINYDIR_SCAN_AVX2
+
+scan_fun choose_scan() {
+#if defined(STATICLIB_TINYDIR_SCAN_AVX2)
+    return avx2_supported() ? scan_avx2 : scan_sse2;
+#elif defined(STATICLIB_TINYDIR_SCAN_SSE2)
+    return scan_sse2;
+#else // scalar
+    return scan_scalar;
+#endif // STATICLIB_TINYDIR_SCAN_AVX2
+}
+
+} // namespace
+
+const char* scan_for_byte(const char* begin, const char* end, char ch) {
+    static scan_fun fun = choose_scan();
+    return fun(begin, end, ch);
+}
+
+} // namespace
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   byte_scan.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:40 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_BYTE_SCAN_HPP
+#define STATICLIB_TINYDIR_BYTE_SCAN_HPP
+
+#include "staticlib/config.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Finds the first occurrence of the byte in the range, AVX2 is used
+ * when supported by CPU, then SSE2, then a scalar loop
+ *
+ * @param begin range begin
+ * @param end range end
+ * @param ch byte to find
+ * @return pointer to the found byte, "end" if not found
+ */
+const char* scan_for_byte(const char* begin, const char* end, char ch);
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_BYTE_SCAN_HPP */
@@ -0,0 +1,317 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   chunked_reader.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 9:55 PM
+ */
+
+#include "staticlib/tinydir/chunked_reader.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <ios>
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "staticlib/tinydir/file_source.hpp"
+
+#include "byte_scan.hpp"
+#include "direct_io.hpp"
+#include "io_probe.hpp"
+#include "task_pool.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+const size_t scan_buffer_size = 1 << 16;
+
+// offset of the first delimiter at or after the specified offset
+uint64_t find_delimiter(file_source& src, uint64_t offset, uint64_t size, char delimiter) {
+    auto buf = acquire_io_buffer(scan_buffer_size);
+    src.seek(static_cast<std::streamsize> (offset));
+    auto pos = offset;
+    while (pos < size) {
+        auto read = src.read(buf.span());
+        if (std::char_traits<char>::eof() == read) break;
+        auto buf_end = buf.data() + read;
+        auto found = scan_for_byte(buf.data(), buf_end, delimiter);
+        if (buf_end != found) {
+            return pos + static_cast<uint64_t> (found - buf.data());
+        }
+        pos += static_cast<uint64_t> (read);
+    }
+    return size;
+}
+
+struct schedule_state {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<size_t> processed;
+    std::exception_ptr error;
+};
+
+} // namespace
+
+chunk_source::chunk_source(const std::string& file_path, const file_chunk& chunk, size_t buffer_size) :
+file_path(file_path.data(), file_path.size()),
+range(chunk),
+buffer_size(static_cast<size_t> (std::max(static_cast<uint64_t> (1),
+        std::min(static_cast<uint64_t> (buffer_size), chunk.length)))) {
+    std::error_code ec;
+#ifdef STATICLIB_WINDOWS
+    handle = direct_io_open_buffered(this->file_path, ec);
+    auto fh = handle;
+#else // !STATICLIB_WINDOWS
+    fd = direct_io_open_buffered(this->file_path, ec);
+    auto fh = fd;
+#endif // STATICLIB_WINDOWS
+    if (ec) throw tinydir_exception(TRACEMSG("Error opening file: [" + this->file_path + "]," +
+            " error: [" + ec.message() + "]"));
+    direct_io_read_ahead(fh, range.offset, this->buffer_size);
+}
+
+chunk_source::chunk_source(chunk_source&& other) STATICLIB_NOEXCEPT :
+#ifdef STATICLIB_WINDOWS
+handle(other.handle),
+#else // !STATICLIB_WINDOWS
+fd(other.fd),
+#endif // STATICLIB_WINDOWS
+file_path(std::move(other.file_path)),
+range(other.range),
+buffer_size(other.buffer_size),
+buffer(std::move(other.buffer)),
+available(other.available),
+position(other.position),
+consumed(other.consumed) {
+#ifdef STATICLIB_WINDOWS
+    other.handle = nullptr;
+#else // !STATICLIB_WINDOWS
+    other.fd = -1;
+#endif // STATICLIB_WINDOWS
+}
+
+chunk_source& chunk_source::operator=(chunk_source&& other) STATICLIB_NOEXCEPT {
+    close();
+#ifdef STATICLIB_WINDOWS
+    handle = other.handle;
+    other.handle = nullptr;
+#else // !STATICLIB_WINDOWS
+    fd = other.fd;
+    other.fd = -1;
+#endif // STATICLIB_WINDOWS
+    file_path = std::move(other.file_path);
+    range = other.range;
+    buffer_size = other.buffer_size;
+    buffer = std::move(other.buffer);
+    available = other.available;
+    position = other.position;
+    consumed = other.consumed;
+    return *this;
+}
+
+chunk_source::~chunk_source() STATICLIB_NOEXCEPT {
+    close();
+}
+
+std::streamsize chunk_source::read(sl::io::span<char> span) {
+#ifdef STATICLIB_WINDOWS
+    bool open = nullptr != handle;
+#else // !STATICLIB_WINDOWS
+    bool open = -1 != fd;
+#endif // STATICLIB_WINDOWS
+    if (!open) throw tinydir_exception(TRACEMSG(
+            "Attempt to read closed file: [" + file_path + "]"));
+    if (0 == span.size()) {
+        return 0;
+    }
+    if (position == available) {
+        auto remaining = range.length - consumed;
+        if (0 == remaining) {
+            return std::char_traits<char>::eof();
+        }
+        auto len = static_cast<size_t> (std::min(static_cast<uint64_t> (span.size()), remaining));
+        if (len >= buffer_size) {
+            return static_cast<std::streamsize> (read_range(span.data(), len));
+        }
+        if (nullptr == buffer.data()) {
+            buffer = acquire_io_buffer(buffer_size);
+        }
+        len = static_cast<size_t> (std::min(static_cast<uint64_t> (buffer_size), remaining));
+        available = read_range(buffer.data(), len);
+        position = 0;
+    }
+    auto len = std::min(span.size(), available - position);
+    std::memcpy(span.data(), buffer.data() + position, len);
+    position += len;
+    return static_cast<std::streamsize> (len);
+}
+
+const file_chunk& chunk_source::chunk() const {
+    return range;
+}
+
+const std::string& chunk_source::path() const {
+    return file_path;
+}
+
+void chunk_source::close() STATICLIB_NOEXCEPT {
+    buffer.release();
+#ifdef STATICLIB_WINDOWS
+    if (nullptr != handle) {
+        direct_io_close(handle, file_path);
+        handle = nullptr;
+    }
+#else // !STATICLIB_WINDOWS
+    if (-1 != fd) {
+        direct_io_close(fd, file_path);
+        fd = -1;
+    }
+#endif // STATICLIB_WINDOWS
+}
+
+size_t chunk_source::read_range(char* buf, size_t len) {
+#ifdef STATICLIB_WINDOWS
+    auto fh = handle;
+#else // !STATICLIB_WINDOWS
+    auto fh = fd;
+#endif // STATICLIB_WINDOWS
+    size_t res = 0;
+    STATICLIB_TINYDIR_IO_BEGIN(probe, read, file_path);
+    auto ec = direct_io_read_at(fh, buf, len, range.offset + consumed, res);
+    STATICLIB_TINYDIR_IO_END(probe, res, static_cast<bool> (ec));
+    if (ec) throw tinydir_exception(TRACEMSG("Read error from file: [" + file_path + "]," +
+            " error: [" + ec.message() + "]"));
+    if (0 == res) throw tinydir_exception(TRACEMSG("Unexpected end of file: [" + file_path + "]," +
+            " chunk offset: [" + sl::support::to_string(range.offset) + "]," +
+            " chunk length: [" + sl::support::to_string(range.length) + "]," +
+            " file was truncated"));
+    consumed += res;
+    // next window is read by the OS while the caller processes this one
+    auto remaining = range.length - consumed;
+    if (remaining > 0) {
+        direct_io_read_ahead(fh, range.offset + consumed,
+                std::min(static_cast<uint64_t> (buffer_size), remaining));
+    }
+    return res;
+}
+
+std::vector<file_chunk> split_file(const std::string& file_path, const chunked_read_options& options) {
+    auto src = file_source(file_path);
+    auto size = static_cast<uint64_t> (src.size());
+    auto res = std::vector<file_chunk>();
+    if (0 == size) {
+        return res;
+    }
+    uint64_t requested = 0 != options.chunks_count ? options.chunks_count :
+            (0 != options.threads_count ? options.threads_count :
+            task_pool::default_threads_count()) * 4;
+    auto by_size = size / std::max(options.min_chunk_size, static_cast<uint64_t> (1));
+    auto count = std::max(std::min(requested, by_size), static_cast<uint64_t> (1));
+    uint64_t begin = 0;
+    for (uint64_t i = 1; i <= count; i++) {
+        // avoids overflow of "size * i"
+        auto end = i < count ? size / count * i + (size % count) * i / count : size;
+        if (options.align_to_delimiter && end < size) {
+            auto from = std::max(end - 1, begin);
+            auto found = find_delimiter(src, from, size, options.delimiter);
+            end = found < size ? found + 1 : size;
+        }
+        if (end > begin) {
+            res.emplace_back(res.size(), begin, end - begin);
+            begin = end;
+        }
+    }
+    return res;
+}
+
+void read_chunks(const std::string& file_path, const chunked_read_options& options,
+        std::function<void(chunk_source&)> process,
+        std::function<void(const file_chunk&)> consume) {
+    auto chunks = split_file(file_path, options);
+    if (chunks.empty()) {
+        return;
+    }
+    auto threads_count = 0 != options.threads_count ? options.threads_count :
+            task_pool::default_threads_count();
+    threads_count = std::min(threads_count, chunks.size());
+    auto window = threads_count * 2;
+    // must outlive the pool, running tasks report to it
+    schedule_state st;
+    auto ready = std::vector<bool>(chunks.size(), false);
+    task_pool pool(threads_count);
+    size_t submitted = 0;
+    size_t delivered = 0;
+    while (delivered < chunks.size()) {
+        for (; submitted < chunks.size() && submitted - delivered < window; submitted++) {
+            auto idx = submitted;
+            auto buffer_size = options.buffer_size;
+            pool.submit([&st, &chunks, &process, &file_path, idx, buffer_size] {
+                try {
+                    auto src = chunk_source(file_path, chunks[idx], buffer_size);
+                    process(src);
+                    std::lock_guard<std::mutex> guard{st.mtx};
+                    st.processed.push_back(idx);
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard{st.mtx};
+                    if (nullptr == st.error) {
+                        st.error = std::current_exception();
+                    }
+                }
+                st.cv.notify_one();
+            });
+        }
+        auto processed = std::vector<size_t>();
+        {
+            std::unique_lock<std::mutex> lock{st.mtx};
+            st.cv.wait(lock, [&st] {
+                return nullptr != st.error || !st.processed.empty();
+            });
+            if (nullptr != st.error) {
+                // pool destructor drops queued chunks and waits for running ones
+                std::rethrow_exception(st.error);
+            }
+            processed.assign(st.processed.begin(), st.processed.end());
+            st.processed.clear();
+        }
+        for (auto idx : processed) {
+            if (options.ordered) {
+                ready[idx] = true;
+                for (; delivered < chunks.size() && ready[delivered]; delivered++) {
+                    if (consume) {
+                        consume(chunks[delivered]);
+                    }
+                }
+            } else {
+                if (consume) {
+                    consume(chunks[idx]);
+                }
+                delivered += 1;
+            }
+        }
+    }
+}
+
+} // namespace
+}
@@ -0,0 +1,276 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   deferred_remover.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 4:25 AM
+ */
+
+#include "staticlib/tinydir/deferred_remover.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+class deferred_remover_state {
+    std::string trash;
+    deferred_remove_options options;
+    std::atomic<uint64_t> names_counter;
+    std::atomic<uint64_t> removals;
+    std::atomic<uint64_t> failures;
+    std::atomic<bool> stopping;
+    mutable std::mutex mtx;
+    std::condition_variable work_cv;
+    std::condition_variable idle_cv;
+    // entry being deleted is kept at the front
+    std::deque<tinydir::path> queue;
+    // created by "init_queue"
+    tinydir::path trash_path;
+    std::chrono::steady_clock::time_point next_slot;
+    // must be the last member, started after all other are initialized
+    std::thread thread;
+
+public:
+    deferred_remover_state(const std::string& trash_dir, const deferred_remove_options& options) :
+    trash(trash_dir.data(), trash_dir.size()),
+    options(options),
+    names_counter(0),
+    removals(0),
+    failures(0),
+    stopping(false),
+    queue(init_queue(trash, options)),
+    trash_path(trash),
+    next_slot(std::chrono::steady_clock::now()),
+    thread([this] { run(); }) { }
+
+    deferred_remover_state(const deferred_remover_state&) = delete;
+
+    deferred_remover_state& operator=(const deferred_remover_state&) = delete;
+
+    ~deferred_remover_state() STATICLIB_NOEXCEPT {
+        close();
+    }
+
+    void remove(const std::string& path) {
+        if (stopping.load()) throw tinydir_exception(TRACEMSG(
+                "Attempt to remove path with closed remover, path: [" + path + "]"));
+        // unique within the trash across restarts
+        auto stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        // joined path is not listed, its type is read on access
+        auto target = trash_path / (sl::support::to_string(stamp) + "_" +
+                sl::support::to_string(names_counter.fetch_add(1)));
+        std::error_code ec;
+        tinydir::path(path).rename(target.filepath(), ec);
+        if (ec) throw tinydir_exception(TRACEMSG("Cannot move path to trash: [" + path + "]," +
+                " trash: [" + trash + "]," +
+                " error: [" + ec.message() + "]"));
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            queue.push_back(std::move(target));
+        }
+        work_cv.notify_one();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock{mtx};
+        idle_cv.wait(lock, [this] {
+            return queue.empty() || stopping.load();
+        });
+    }
+
+    void close() STATICLIB_NOEXCEPT {
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            stopping.store(true);
+        }
+        work_cv.notify_all();
+        idle_cv.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    size_t pending_count() const {
+        std::lock_guard<std::mutex> guard{mtx};
+        return queue.size();
+    }
+
+    uint64_t removals_count() const {
+        return removals.load();
+    }
+
+    uint64_t failures_count() const {
+        return failures.load();
+    }
+
+    const std::string& trash_dir() const {
+        return trash;
+    }
+
+private:
+    static std::deque<tinydir::path> init_queue(const std::string& trash,
+            const deferred_remove_options& options) {
+        create_directories(trash);
+        auto res = std::deque<tinydir::path>();
+        if (options.recover) {
+            auto leftovers = list_directory(trash);
+            // oldest first
+            std::sort(leftovers.begin(), leftovers.end(), [](const tinydir::path& a, const tinydir::path& b) {
+                return a.filename() < b.filename();
+            });
+            res.assign(leftovers.begin(), leftovers.end());
+        }
+        return res;
+    }
+
+    void run() STATICLIB_NOEXCEPT {
+        for (;;) {
+            // only this thread pops, and "push_back" keeps references to deque elements valid
+            const tinydir::path* entry = nullptr;
+            {
+                std::unique_lock<std::mutex> lock{mtx};
+                work_cv.wait(lock, [this] {
+                    return stopping.load() || !queue.empty();
+                });
+                if (stopping.load()) {
+                    return;
+                }
+                entry = std::addressof(queue.front());
+            }
+            bool success = reap(*entry);
+            {
+                std::lock_guard<std::mutex> guard{mtx};
+                if (stopping.load()) {
+                    // left for recovery
+                    return;
+                }
+                queue.pop_front();
+                if (!success) {
+                    failures.fetch_add(1);
+                }
+            }
+            idle_cv.notify_all();
+        }
+    }
+
+    // post-order, so every removal deletes a single file or an empty directory
+    bool reap(const tinydir::path& entry) {
+        if (entry.is_directory()) {
+            auto children = std::vector<tinydir::path>();
+            try {
+                children = list_directory(entry.filepath());
+            } catch (const std::exception&) {
+                return false;
+            }
+            for (auto& ch : children) {
+                if (!reap(ch)) {
+                    return false;
+                }
+            }
+        }
+        if (!throttle() || !entry.remove_quietly()) {
+            return false;
+        }
+        removals.fetch_add(1);
+        return true;
+    }
+
+    bool throttle() {
+        if (0 == options.max_removals_per_second) {
+            return !stopping.load();
+        }
+        auto interval = std::chrono::nanoseconds(1000000000 / options.max_removals_per_second);
+        auto now = std::chrono::steady_clock::now();
+        if (next_slot > now) {
+            std::unique_lock<std::mutex> lock{mtx};
+            work_cv.wait_until(lock, next_slot, [this] {
+                return stopping.load();
+            });
+        }
+        next_slot = std::max(next_slot, now) + interval;
+        return !stopping.load();
+    }
+};
+
+deferred_remover::deferred_remover(const std::string& trash_dir, deferred_remove_options options) :
+state(new deferred_remover_state(trash_dir, options)) { }
+
+deferred_remover::~deferred_remover() STATICLIB_NOEXCEPT { }
+
+deferred_remover::deferred_remover(deferred_remover&& other) STATICLIB_NOEXCEPT :
+state(std::move(other.state)) { }
+
+deferred_remover& deferred_remover::operator=(deferred_remover&& other) STATICLIB_NOEXCEPT {
+    state = std::move(other.state);
+    return *this;
+}
+
+void deferred_remover::remove(const std::string& path) {
+    if (nullptr == state.get()) throw tinydir_exception(TRACEMSG(
+            "Attempt to remove path with moved-from remover, path: [" + path + "]"));
+    state->remove(path);
+}
+
+void deferred_remover::wait() {
+    if (nullptr != state.get()) {
+        state->wait();
+    }
+}
+
+void deferred_remover::close() STATICLIB_NOEXCEPT {
+    if (nullptr != state.get()) {
+        state->close();
+    }
+}
+
+size_t deferred_remover::pending_count() const {
+    return nullptr != state.get() ? state->pending_count() : 0;
+}
+
+uint64_t deferred_remover::removals_count() const {
+    return nullptr != state.get() ? state->removals_count() : 0;
+}
+
+uint64_t deferred_remover::failures_count() const {
+    return nullptr != state.get() ? state->failures_count() : 0;
+}
+
+const std::string& deferred_remover::trash_dir() const {
+    if (nullptr == state.get()) throw tinydir_exception(TRACEMSG(
+            "Attempt to access moved-from remover"));
+    return state->trash_dir();
+}
+
+} // namespace
+}
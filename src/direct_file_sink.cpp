@@ -0,0 +1,238 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   direct_file_sink.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 7:40 PM
+ */
+
+#include "staticlib/tinydir/direct_file_sink.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef STATICLIB_WINDOWS
+#include "staticlib/support/windows.hpp"
+#else // !STATICLIB_WINDOWS
+#include <unistd.h>
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "direct_io.hpp"
+#include "io_probe.hpp"
+#include "io_thread.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+direct_file_sink::direct_file_sink(const std::string& file_path, size_t buffer_size) :
+file_path(file_path.data(), file_path.size()),
+buffer_size(direct_io_align_up(std::max(buffer_size, static_cast<size_t> (1)))) {
+    std::error_code ec;
+#ifdef STATICLIB_WINDOWS
+    handle = direct_io_open(this->file_path, true, direct, ec);
+#else // !STATICLIB_WINDOWS
+    fd = direct_io_open(this->file_path, true, direct, ec);
+#endif // STATICLIB_WINDOWS
+    if (ec) throw tinydir_exception(TRACEMSG("Error opening file: [" + this->file_path + "]," +
+            " error: [" + ec.message() + "]"));
+    buffers = acquire_io_buffer(this->buffer_size * 2);
+}
+
+direct_file_sink::direct_file_sink(direct_file_sink&& other) STATICLIB_NOEXCEPT :
+#ifdef STATICLIB_WINDOWS
+handle(other.handle),
+#else // !STATICLIB_WINDOWS
+fd(other.fd),
+#endif // STATICLIB_WINDOWS
+file_path(std::move(other.file_path)),
+direct(other.direct),
+buffer_size(other.buffer_size),
+buffers(std::move(other.buffers)),
+current(other.current),
+filled(other.filled),
+offset(other.offset),
+io(std::move(other.io)) {
+#ifdef STATICLIB_WINDOWS
+    other.handle = nullptr;
+#else // !STATICLIB_WINDOWS
+    other.fd = -1;
+#endif // STATICLIB_WINDOWS
+    other.filled = 0;
+}
+
+direct_file_sink& direct_file_sink::operator=(direct_file_sink&& other) STATICLIB_NOEXCEPT {
+    close();
+#ifdef STATICLIB_WINDOWS
+    handle = other.handle;
+    other.handle = nullptr;
+#else // !STATICLIB_WINDOWS
+    fd = other.fd;
+    other.fd = -1;
+#endif // STATICLIB_WINDOWS
+    file_path = std::move(other.file_path);
+    direct = other.direct;
+    buffer_size = other.buffer_size;
+    // memory block is moved, so the pointers held by background IO stay valid
+    buffers = std::move(other.buffers);
+    current = other.current;
+    filled = other.filled;
+    other.filled = 0;
+    offset = other.offset;
+    io = std::move(other.io);
+    return *this;
+}
+
+direct_file_sink::~direct_file_sink() STATICLIB_NOEXCEPT {
+    close();
+}
+
+std::streamsize direct_file_sink::write(sl::io::span<const char> span) {
+    if (!is_open()) throw tinydir_exception(TRACEMSG(
+            "Attempt to write into closed file: [" + file_path + "]"));
+    size_t pos = 0;
+    while (pos < span.size()) {
+        auto len = std::min(buffer_size - filled, span.size() - pos);
+        std::memcpy(buffers.data() + current * buffer_size + filled, span.data() + pos, len);
+        filled += len;
+        pos += len;
+        if (buffer_size == filled) {
+            submit_current();
+        }
+    }
+    return static_cast<std::streamsize> (span.size());
+}
+
+std::streamsize direct_file_sink::flush() {
+    wait_pending();
+    return 0;
+}
+
+void direct_file_sink::finish() {
+    if (!is_open()) return;
+    auto deferred = sl::support::defer([this]() STATICLIB_NOEXCEPT {
+        this->close_handle();
+    });
+    wait_pending();
+    if (filled > 0) {
+        // unbuffered write length must be aligned, padding is cut off afterwards
+        auto len = direct ? direct_io_align_up(filled) : filled;
+        auto buf = buffers.data() + current * buffer_size;
+        std::memset(buf + filled, '\0', len - filled);
+        STATICLIB_TINYDIR_IO_BEGIN(probe, write, file_path);
+#ifdef STATICLIB_WINDOWS
+        auto ec = direct_io_write_at(handle, buf, len, offset);
+#else // !STATICLIB_WINDOWS
+        auto ec = direct_io_write_at(fd, buf, len, offset);
+#endif // STATICLIB_WINDOWS
+        STATICLIB_TINYDIR_IO_END(probe, ec ? 0 : len, static_cast<bool> (ec));
+        if (ec) throw tinydir_exception(TRACEMSG("Write error to file: [" + file_path + "]," +
+                " error: [" + ec.message() + "]"));
+        auto tail = filled;
+        offset += tail;
+        filled = 0;
+        if (len != tail) {
+            STATICLIB_TINYDIR_IO_BEGIN(resize_probe, resize, file_path);
+#ifdef STATICLIB_WINDOWS
+            auto ec_trunc = direct_io_truncate(handle, offset);
+#else // !STATICLIB_WINDOWS
+            auto ec_trunc = direct_io_truncate(fd, offset);
+#endif // STATICLIB_WINDOWS
+            STATICLIB_TINYDIR_IO_END(resize_probe, 0, static_cast<bool> (ec_trunc));
+            if (ec_trunc) throw tinydir_exception(TRACEMSG("Error resizing file: [" + file_path + "]," +
+                    " error: [" + ec_trunc.message() + "]"));
+        }
+    }
+}
+
+void direct_file_sink::close() STATICLIB_NOEXCEPT {
+    try {
+        finish();
+    } catch (...) {
+        // ignore, handle is closed by "finish"
+    }
+}
+
+bool direct_file_sink::is_direct() const {
+    return direct;
+}
+
+const std::string& direct_file_sink::path() const {
+    return file_path;
+}
+
+bool direct_file_sink::is_open() const {
+#ifdef STATICLIB_WINDOWS
+    return nullptr != handle;
+#else // !STATICLIB_WINDOWS
+    return -1 != fd;
+#endif // STATICLIB_WINDOWS
+}
+
+void direct_file_sink::wait_pending() {
+    if (nullptr != io.get() && io->pending()) {
+        // rethrows background error
+        io->wait();
+    }
+}
+
+void direct_file_sink::submit_current() {
+    wait_pending();
+    auto buf = buffers.data() + current * buffer_size;
+    auto len = buffer_size;
+    auto off = offset;
+    auto pa = file_path;
+#ifdef STATICLIB_WINDOWS
+    auto fh = handle;
+#else // !STATICLIB_WINDOWS
+    auto fh = fd;
+#endif // STATICLIB_WINDOWS
+    if (nullptr == io.get()) {
+        io = std::unique_ptr<io_thread>(new io_thread());
+    }
+    io->submit([fh, buf, len, off, pa]() -> size_t {
+        STATICLIB_TINYDIR_IO_BEGIN(probe, write, pa);
+        auto ec = direct_io_write_at(fh, buf, len, off);
+        STATICLIB_TINYDIR_IO_END(probe, ec ? 0 : len, static_cast<bool> (ec));
+        if (ec) throw tinydir_exception(TRACEMSG("Write error to file: [" + pa + "]," +
+                " error: [" + ec.message() + "]"));
+        return len;
+    });
+    offset += len;
+    current ^= 1;
+    filled = 0;
+}
+
+void direct_file_sink::close_handle() STATICLIB_NOEXCEPT {
+    // background write references the handle and the buffer
+    io.reset();
+    buffers.release();
+    if (!is_open()) return;
+#ifdef STATICLIB_WINDOWS
+    direct_io_close(handle, file_path);
+    handle = nullptr;
+#else // !STATICLIB_WINDOWS
+    direct_io_close(fd, file_path);
+    fd = -1;
+#endif // STATICLIB_WINDOWS
+}
+
+} // namespace
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   direct_file_source.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 7:55 PM
+ */
+
+#include "staticlib/tinydir/direct_file_source.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ios>
+
+#ifdef STATICLIB_WINDOWS
+#include "staticlib/support/windows.hpp"
+#else // !STATICLIB_WINDOWS
+#include <unistd.h>
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "direct_io.hpp"
+#include "io_probe.hpp"
+#include "io_thread.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+direct_file_source::direct_file_source(const std::string& file_path, size_t buffer_size) :
+file_path(file_path.data(), file_path.size()),
+buffer_size(direct_io_align_up(std::max(buffer_size, static_cast<size_t> (1)))) {
+    std::error_code ec;
+#ifdef STATICLIB_WINDOWS
+    handle = direct_io_open(this->file_path, false, direct, ec);
+#else // !STATICLIB_WINDOWS
+    fd = direct_io_open(this->file_path, false, direct, ec);
+#endif // STATICLIB_WINDOWS
+    if (ec) throw tinydir_exception(TRACEMSG("Error opening file: [" + this->file_path + "]," +
+            " error: [" + ec.message() + "]"));
+    buffers = acquire_io_buffer(this->buffer_size * 2);
+    read_ahead();
+}
+
+direct_file_source::direct_file_source(direct_file_source&& other) STATICLIB_NOEXCEPT :
+#ifdef STATICLIB_WINDOWS
+handle(other.handle),
+#else // !STATICLIB_WINDOWS
+fd(other.fd),
+#endif // STATICLIB_WINDOWS
+file_path(std::move(other.file_path)),
+direct(other.direct),
+buffer_size(other.buffer_size),
+buffers(std::move(other.buffers)),
+current(other.current),
+available(other.available),
+position(other.position),
+offset(other.offset),
+io(std::move(other.io)) {
+#ifdef STATICLIB_WINDOWS
+    other.handle = nullptr;
+#else // !STATICLIB_WINDOWS
+    other.fd = -1;
+#endif // STATICLIB_WINDOWS
+}
+
+direct_file_source& direct_file_source::operator=(direct_file_source&& other) STATICLIB_NOEXCEPT {
+    close();
+#ifdef STATICLIB_WINDOWS
+    handle = other.handle;
+    other.handle = nullptr;
+#else // !STATICLIB_WINDOWS
+    fd = other.fd;
+    other.fd = -1;
+#endif // STATICLIB_WINDOWS
+    file_path = std::move(other.file_path);
+    direct = other.direct;
+    buffer_size = other.buffer_size;
+    // memory block is moved, so the pointers held by background IO stay valid
+    buffers = std::move(other.buffers);
+    current = other.current;
+    available = other.available;
+    position = other.position;
+    offset = other.offset;
+    io = std::move(other.io);
+    return *this;
+}
+
+direct_file_source::~direct_file_source() STATICLIB_NOEXCEPT {
+    close();
+}
+
+std::streamsize direct_file_source::read(sl::io::span<char> span) {
+    if (nullptr == buffers.data()) throw tinydir_exception(TRACEMSG(
+            "Attempt to read from closed file: [" + file_path + "]"));
+    if (0 == span.size()) {
+        return 0;
+    }
+    if (position == available) {
+        if (nullptr == io.get() || !io->pending()) {
+            return std::char_traits<char>::eof();
+        }
+        // rethrows background error
+        available = io->wait();
+        position = 0;
+        current ^= 1;
+        // short read means EOF
+        if (available == buffer_size) {
+            read_ahead();
+        }
+        if (0 == available) {
+            return std::char_traits<char>::eof();
+        }
+    }
+    auto len = std::min(span.size(), available - position);
+    std::memcpy(span.data(), buffers.data() + current * buffer_size + position, len);
+    position += len;
+    return static_cast<std::streamsize> (len);
+}
+
+void direct_file_source::close() STATICLIB_NOEXCEPT {
+    // background read references the handle and the buffer
+    io.reset();
+    buffers.release();
+#ifdef STATICLIB_WINDOWS
+    if (nullptr != handle) {
+        direct_io_close(handle, file_path);
+        handle = nullptr;
+    }
+#else // !STATICLIB_WINDOWS
+    if (-1 != fd) {
+        direct_io_close(fd, file_path);
+        fd = -1;
+    }
+#endif // STATICLIB_WINDOWS
+}
+
+bool direct_file_source::is_direct() const {
+    return direct;
+}
+
+const std::string& direct_file_source::path() const {
+    return file_path;
+}
+
+void direct_file_source::read_ahead() {
+    auto buf = buffers.data() + (current ^ 1) * buffer_size;
+    auto len = buffer_size;
+    auto off = offset;
+    auto pa = file_path;
+#ifdef STATICLIB_WINDOWS
+    auto fh = handle;
+#else // !STATICLIB_WINDOWS
+    auto fh = fd;
+#endif // STATICLIB_WINDOWS
+    if (nullptr == io.get()) {
+        io = std::unique_ptr<io_thread>(new io_thread());
+    }
+    io->submit([fh, buf, len, off, pa]() -> size_t {
+        size_t res = 0;
+        STATICLIB_TINYDIR_IO_BEGIN(probe, read, pa);
+        auto ec = direct_io_read_at(fh, buf, len, off, res);
+        STATICLIB_TINYDIR_IO_END(probe, res, static_cast<bool> (ec));
+        if (ec) throw tinydir_exception(TRACEMSG("Read error from file: [" + pa + "]," +
+                " error: [" + ec.message() + "]"));
+        return res;
+    });
+    offset += len;
+}
+
+} // namespace
+}
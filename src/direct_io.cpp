@@ -0,0 +1,286 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   direct_io.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 7:25 PM
+ */
+
+#include "direct_io.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#ifdef STATICLIB_WINDOWS
+#include "staticlib/support/windows.hpp"
+#include "staticlib/utils/windows.hpp"
+#else // !STATICLIB_WINDOWS
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/utils.hpp"
+
+#include "io_probe.hpp"
+#include "last_error.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+#ifdef STATICLIB_WINDOWS
+
+namespace { // anonymous
+
+HANDLE create_handle(const std::string& path, bool write, DWORD flags) {
+    auto wpath = sl::utils::widen(path);
+    STATICLIB_TINYDIR_IO_BEGIN(probe, open, path);
+    auto res = ::CreateFileW(
+            wpath.c_str(),
+            write ? GENERIC_WRITE : GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_WRITE,
+            NULL, // lpSecurityAttributes
+            write ? CREATE_ALWAYS : OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | flags,
+            NULL);
+    STATICLIB_TINYDIR_IO_END(probe, 0, INVALID_HANDLE_VALUE == res);
+    return res;
+}
+
+OVERLAPPED overlapped_at(uint64_t offset) {
+    OVERLAPPED ov;
+    std::memset(std::addressof(ov), '\0', sizeof(ov));
+    ov.Offset = static_cast<DWORD> (offset & 0xffffffff);
+    ov.OffsetHigh = static_cast<DWORD> (offset >> 32);
+    return ov;
+}
+
+const size_t max_chunk = static_cast<size_t> (std::numeric_limits<DWORD>::max()) /
+        direct_io_alignment * direct_io_alignment;
+
+} // namespace
+
+void* direct_io_open(const std::string& path, bool write, bool& direct, std::error_code& ec) {
+    direct = true;
+    auto res = create_handle(path, write, FILE_FLAG_NO_BUFFERING | FILE_FLAG_SEQUENTIAL_SCAN);
+    if (INVALID_HANDLE_VALUE == res && ERROR_INVALID_PARAMETER == ::GetLastError()) {
+        direct = false;
+        res = create_handle(path, write, FILE_FLAG_SEQUENTIAL_SCAN);
+    }
+    if (INVALID_HANDLE_VALUE == res) {
+        ec = last_error_code();
+        return nullptr;
+    }
+    ec.clear();
+    return res;
+}
+
+void* direct_io_open_buffered(const std::string& path, std::error_code& ec) {
+    auto res = create_handle(path, false, FILE_FLAG_SEQUENTIAL_SCAN);
+    if (INVALID_HANDLE_VALUE == res) {
+        ec = last_error_code();
+        return nullptr;
+    }
+    ec.clear();
+    return res;
+}
+
+void direct_io_read_ahead(void*, uint64_t, uint64_t) {
+    // sequential scan flag is used instead
+}
+
+void direct_io_close(void* handle, const std::string& path) {
+    STATICLIB_TINYDIR_IO_BEGIN(probe, close, path);
+    auto err = ::CloseHandle(static_cast<HANDLE> (handle));
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 == err);
+    (void) err;
+    (void) path;
+}
+
+std::error_code direct_io_write_at(void* handle, const char* buf, size_t len, uint64_t offset) {
+    size_t done = 0;
+    while (done < len) {
+        auto ov = overlapped_at(offset + done);
+        auto chunk = static_cast<DWORD> (std::min(len - done, max_chunk));
+        DWORD res = 0;
+        auto success = ::WriteFile(static_cast<HANDLE> (handle), buf + done, chunk,
+                std::addressof(res), std::addressof(ov));
+        if (!success) {
+            return last_error_code();
+        }
+        done += res;
+    }
+    return std::error_code();
+}
+
+std::error_code direct_io_read_at(void* handle, char* buf, size_t len, uint64_t offset, size_t& read) {
+    read = 0;
+    while (read < len) {
+        auto ov = overlapped_at(offset + read);
+        auto chunk = static_cast<DWORD> (std::min(len - read, max_chunk));
+        DWORD res = 0;
+        auto success = ::ReadFile(static_cast<HANDLE> (handle), buf + read, chunk,
+                std::addressof(res), std::addressof(ov));
+        if (!success) {
+            if (ERROR_HANDLE_EOF == ::GetLastError()) {
+                break;
+            }
+            return last_error_code();
+        }
+        read += res;
+        if (res < chunk) {
+            break;
+        }
+    }
+    return std::error_code();
+}
+
+std::error_code direct_io_truncate(void* handle, uint64_t size) {
+    LARGE_INTEGER li;
+    li.QuadPart = static_cast<LONGLONG> (size);
+    if (!::SetFilePointerEx(static_cast<HANDLE> (handle), li, nullptr, FILE_BEGIN) ||
+            !::SetEndOfFile(static_cast<HANDLE> (handle))) {
+        return last_error_code();
+    }
+    return std::error_code();
+}
+
+#else // !STATICLIB_WINDOWS
+
+namespace { // anonymous
+
+// single call limit for "pread" and "pwrite" on linux
+const size_t max_chunk = 0x7ffff000;
+
+int open_fd(const std::string& path, bool write, int extra_flags) {
+    auto flags = (write ? O_WRONLY | O_CREAT | O_TRUNC : O_RDONLY) | extra_flags;
+    STATICLIB_TINYDIR_IO_BEGIN(probe, open, path);
+    auto res = ::open(path.c_str(), flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    STATICLIB_TINYDIR_IO_END(probe, 0, -1 == res);
+    return res;
+}
+
+} // namespace
+
+int direct_io_open(const std::string& path, bool write, bool& direct, std::error_code& ec) {
+    direct = false;
+#ifdef O_DIRECT
+    auto res = open_fd(path, write, O_DIRECT);
+    if (-1 != res) {
+        direct = true;
+    } else if (EINVAL == errno) {
+        // FS without O_DIRECT support, i.e. tmpfs
+        res = open_fd(path, write, 0);
+    }
+#else // !O_DIRECT
+    auto res = open_fd(path, write, 0);
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    if (-1 != res) {
+        direct = -1 != ::fcntl(res, F_NOCACHE, 1);
+    }
+#endif // STATICLIB_MAC || STATICLIB_IOS
+#endif // O_DIRECT
+    if (-1 == res) {
+        ec = last_error_code();
+        return -1;
+    }
+    ec.clear();
+    return res;
+}
+
+int direct_io_open_buffered(const std::string& path, std::error_code& ec) {
+    auto res = open_fd(path, false, 0);
+    if (-1 == res) {
+        ec = last_error_code();
+        return -1;
+    }
+#if !defined(STATICLIB_MAC) && !defined(STATICLIB_IOS)
+    // doubles the read-ahead window on linux
+    ::posix_fadvise(res, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif // !STATICLIB_MAC && !STATICLIB_IOS
+    ec.clear();
+    return res;
+}
+
+void direct_io_read_ahead(int fd, uint64_t offset, uint64_t len) {
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    struct radvisory ra;
+    ra.ra_offset = static_cast<off_t> (offset);
+    ra.ra_count = static_cast<int> (std::min(len, static_cast<uint64_t> (std::numeric_limits<int>::max())));
+    ::fcntl(fd, F_RDADVISE, std::addressof(ra));
+#else // !(STATICLIB_MAC || STATICLIB_IOS)
+    ::posix_fadvise(fd, static_cast<off_t> (offset), static_cast<off_t> (len), POSIX_FADV_WILLNEED);
+#endif // STATICLIB_MAC || STATICLIB_IOS
+}
+
+void direct_io_close(int fd, const std::string& path) {
+    STATICLIB_TINYDIR_IO_BEGIN(probe, close, path);
+    auto err = ::close(fd);
+    STATICLIB_TINYDIR_IO_END(probe, 0, -1 == err);
+    (void) err;
+    (void) path;
+}
+
+std::error_code direct_io_write_at(int fd, const char* buf, size_t len, uint64_t offset) {
+    size_t done = 0;
+    while (done < len) {
+        auto chunk = std::min(len - done, max_chunk);
+        auto res = ::pwrite(fd, buf + done, chunk, static_cast<off_t> (offset + done));
+        if (-1 == res) {
+            if (EINTR == errno) continue;
+            return last_error_code();
+        }
+        done += static_cast<size_t> (res);
+    }
+    return std::error_code();
+}
+
+std::error_code direct_io_read_at(int fd, char* buf, size_t len, uint64_t offset, size_t& read) {
+    read = 0;
+    while (read < len) {
+        auto chunk = std::min(len - read, max_chunk);
+        auto res = ::pread(fd, buf + read, chunk, static_cast<off_t> (offset + read));
+        if (-1 == res) {
+            if (EINTR == errno) continue;
+            return last_error_code();
+        }
+        read += static_cast<size_t> (res);
+        // unaligned short read can only happen at EOF and
+        // next read from unaligned offset would fail with O_DIRECT
+        if (0 == res || 0 != read % direct_io_alignment) {
+            break;
+        }
+    }
+    return std::error_code();
+}
+
+std::error_code direct_io_truncate(int fd, uint64_t size) {
+    if (-1 == ::ftruncate(fd, static_cast<off_t> (size))) {
+        return last_error_code();
+    }
+    return std::error_code();
+}
+
+#endif // STATICLIB_WINDOWS
+
+} // namespace
+}
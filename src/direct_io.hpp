@@ -0,0 +1,156 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   direct_io.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 7:20 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_DIRECT_IO_HPP
+#define STATICLIB_TINYDIR_DIRECT_IO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+#include "staticlib/config.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Alignment of buffers, offsets and lengths for unbuffered IO,
+ * covers both 512-byte and 4K logical sectors
+ */
+const size_t direct_io_alignment = 4096;
+
+/**
+ * Rounds the size up to the unbuffered IO alignment
+ *
+ * @param size size in bytes
+ * @return aligned size
+ */
+inline size_t direct_io_align_up(size_t size) {
+    return (size + direct_io_alignment - 1) / direct_io_alignment * direct_io_alignment;
+}
+
+#ifdef STATICLIB_WINDOWS
+
+/**
+ * Opens the file with "FILE_FLAG_NO_BUFFERING", falls back
+ * to the buffered handle if FS rejects the flag
+ *
+ * @param path path to file
+ * @param write whether to create or truncate the file for writing
+ * @param direct whether unbuffered mode was enabled
+ * @param ec error code, empty on success
+ * @return file handle, "nullptr" on error
+ */
+void* direct_io_open(const std::string& path, bool write, bool& direct, std::error_code& ec);
+
+/**
+ * Opens the file for positional reads through the page cache
+ *
+ * @param path path to file
+ * @param ec error code, empty on success
+ * @return file handle, "nullptr" on error
+ */
+void* direct_io_open_buffered(const std::string& path, std::error_code& ec);
+
+/**
+ * Hints the OS to read ahead the specified range, no-op on windows
+ */
+void direct_io_read_ahead(void* handle, uint64_t offset, uint64_t len);
+
+/**
+ * Closes the handle, errors are ignored
+ */
+void direct_io_close(void* handle, const std::string& path);
+
+/**
+ * Writes the whole buffer at the specified offset
+ */
+std::error_code direct_io_write_at(void* handle, const char* buf, size_t len, uint64_t offset);
+
+/**
+ * Reads up to "len" bytes at the specified offset, short count means EOF
+ */
+std::error_code direct_io_read_at(void* handle, char* buf, size_t len, uint64_t offset, size_t& read);
+
+/**
+ * Sets the file size
+ */
+std::error_code direct_io_truncate(void* handle, uint64_t size);
+
+#else // !STATICLIB_WINDOWS
+
+/**
+ * Opens the file with "O_DIRECT" ("F_NOCACHE" on mac), falls back
+ * to the buffered descriptor if FS rejects the flag
+ *
+ * @param path path to file
+ * @param write whether to create or truncate the file for writing
+ * @param direct whether unbuffered mode was enabled
+ * @param ec error code, empty on success
+ * @return file descriptor, -1 on error
+ */
+int direct_io_open(const std::string& path, bool write, bool& direct, std::error_code& ec);
+
+/**
+ * Opens the file for positional reads through the page cache,
+ * access is marked as sequential where supported
+ *
+ * @param path path to file
+ * @param ec error code, empty on success
+ * @return file descriptor, -1 on error
+ */
+int direct_io_open_buffered(const std::string& path, std::error_code& ec);
+
+/**
+ * Hints the OS to read ahead the specified range ("posix_fadvise"
+ * on linux, "F_RDADVISE" on mac)
+ */
+void direct_io_read_ahead(int fd, uint64_t offset, uint64_t len);
+
+/**
+ * Closes the descriptor, errors are ignored
+ */
+void direct_io_close(int fd, const std::string& path);
+
+/**
+ * Writes the whole buffer at the specified offset
+ */
+std::error_code direct_io_write_at(int fd, const char* buf, size_t len, uint64_t offset);
+
+/**
+ * Reads up to "len" bytes at the specified offset, short count means EOF
+ */
+std::error_code direct_io_read_at(int fd, char* buf, size_t len, uint64_t offset, size_t& read);
+
+/**
+ * Sets the file size
+ */
+std::error_code direct_io_truncate(int fd, uint64_t size);
+
+#endif // STATICLIB_WINDOWS
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_DIRECT_IO_HPP */
@@ -0,0 +1,338 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   directory.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:25 PM
+ */
+
+#include "staticlib/tinydir/directory.hpp"
+
+#include <algorithm>
+
+#ifndef STATICLIB_WINDOWS
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#endif // !STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "io_probe.hpp"
+#include "native_stat.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+#ifdef STATICLIB_WINDOWS
+
+directory::directory(const std::string& dirpath) :
+dir_path(dirpath.data(), dirpath.length()) {
+    auto st = sl::tinydir::status(dir_path);
+    if (file_type::directory != st.type) throw tinydir_exception(TRACEMSG(
+            "Error opening directory, path: [" + dir_path + "], error: [Not a directory]"));
+}
+
+directory::directory(directory&& other) STATICLIB_NOEXCEPT :
+dir_path(std::move(other.dir_path)) { }
+
+directory& directory::operator=(directory&& other) STATICLIB_NOEXCEPT {
+    dir_path = std::move(other.dir_path);
+    return *this;
+}
+
+directory directory::open_directory(const std::string& name) const {
+    return directory(child_path(name));
+}
+
+file_source directory::open_read(const std::string& name) const {
+    return file_source(child_path(name));
+}
+
+file_sink directory::open_write(const std::string& name, file_sink::open_mode mode) const {
+    return file_sink(child_path(name), mode);
+}
+
+std::vector<std::string> directory::list() const {
+    auto vec = list_directory(dir_path);
+    auto res = std::vector<std::string>();
+    for (auto& pa : vec) {
+        res.emplace_back(pa.filename());
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+file_status directory::stat(const std::string& name, bool follow_symlinks) const {
+    auto pa = child_path(name);
+    return follow_symlinks ? sl::tinydir::status(pa) : sl::tinydir::symlink_status(pa);
+}
+
+void directory::create_directory(const std::string& name) const {
+    sl::tinydir::create_directory(child_path(name));
+}
+
+void directory::remove(const std::string& name) const {
+    sl::tinydir::path(child_path(name)).remove();
+}
+
+void directory::rename(const std::string& name, const std::string& target_name) const {
+    sl::tinydir::path(child_path(name)).rename(child_path(target_name));
+}
+
+void directory::rename(const std::string& name, const directory& target_dir,
+        const std::string& target_name) const {
+    sl::tinydir::path(child_path(name)).rename(target_dir.child_path(target_name));
+}
+
+void directory::close() STATICLIB_NOEXCEPT {
+    // no-op
+}
+
+#else // !STATICLIB_WINDOWS
+
+directory::directory(const std::string& dirpath) :
+dir_path(dirpath.data(), dirpath.length()) {
+    STATICLIB_TINYDIR_IO_BEGIN(probe, open, dir_path);
+    fd = ::open(dir_path.c_str(), O_RDONLY | O_DIRECTORY);
+    STATICLIB_TINYDIR_IO_END(probe, 0, -1 == fd);
+    if (-1 == fd) throw tinydir_exception(TRACEMSG("Error opening directory," +
+            " path: [" + dir_path + "], error: [" + ::strerror(errno) + "]"));
+}
+
+directory::directory(int fd, std::string dir_path) :
+fd(fd),
+dir_path(std::move(dir_path)) { }
+
+directory::directory(directory&& other) STATICLIB_NOEXCEPT :
+fd(other.fd),
+dir_path(std::move(other.dir_path)) {
+    other.fd = -1;
+}
+
+directory& directory::operator=(directory&& other) STATICLIB_NOEXCEPT {
+    close();
+    fd = other.fd;
+    other.fd = -1;
+    dir_path = std::move(other.dir_path);
+    return *this;
+}
+
+directory directory::open_directory(const std::string& name) const {
+    auto pa = child_path(name);
+    auto res = open_subdirectory(name, 0);
+    if (-1 == res) throw tinydir_exception(TRACEMSG("Error opening directory," +
+            " path: [" + pa + "], error: [" + ::strerror(errno) + "]"));
+    return directory(res, std::move(pa));
+}
+
+file_source directory::open_read(const std::string& name) const {
+    auto pa = child_path(name);
+    STATICLIB_TINYDIR_IO_BEGIN(probe, open, pa);
+    auto res = ::openat(fd, name.c_str(), O_RDONLY);
+    STATICLIB_TINYDIR_IO_END(probe, 0, -1 == res);
+    if (-1 == res) throw tinydir_exception(TRACEMSG("Error opening file: [" + pa + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    return file_source(res, std::move(pa));
+}
+
+file_sink directory::open_write(const std::string& name, file_sink::open_mode mode) const {
+    int flags = 0;
+    switch (mode) {
+    case file_sink::open_mode::create:
+        flags = O_WRONLY | O_CREAT | O_TRUNC;
+        break;
+    case file_sink::open_mode::append:
+        flags = O_WRONLY | O_APPEND;
+        break;
+    case file_sink::open_mode::from_file:
+        flags = O_RDWR | O_CREAT;
+        break;
+    case file_sink::open_mode::create_new:
+        flags = O_WRONLY | O_CREAT | O_EXCL;
+        break;
+    default: throw tinydir_exception(TRACEMSG("Invalid 'open_mode' specified"));
+    }
+    auto pa = child_path(name);
+    STATICLIB_TINYDIR_IO_BEGIN(probe, open, pa);
+    auto res = ::openat(fd, name.c_str(), flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    STATICLIB_TINYDIR_IO_END(probe, 0, -1 == res);
+    if (-1 == res) throw tinydir_exception(TRACEMSG("Error opening file: [" + pa + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    return file_sink(res, std::move(pa));
+}
+
+std::vector<std::string> directory::list() const {
+    STATICLIB_TINYDIR_IO_BEGIN(probe, read_directory, dir_path);
+    // separate descriptor is required, "closedir" closes it
+    // and "readdir" moves its position
+    auto dfd = ::openat(fd, ".", O_RDONLY | O_DIRECTORY);
+    auto dir = -1 != dfd ? ::fdopendir(dfd) : nullptr;
+    if (nullptr == dir) {
+        auto errnum = errno;
+        if (-1 != dfd) {
+            ::close(dfd);
+        }
+        STATICLIB_TINYDIR_IO_END(probe, 0, true);
+        throw tinydir_exception(TRACEMSG("Error opening directory," +
+                " path: [" + dir_path + "], error: [" + ::strerror(errnum) + "]"));
+    }
+    auto deferred = sl::support::defer([dir]() STATICLIB_NOEXCEPT {
+        ::closedir(dir);
+    });
+    auto res = std::vector<std::string>();
+    for (;;) {
+        errno = 0;
+        auto en = ::readdir(dir);
+        if (nullptr == en) {
+            if (0 != errno) {
+                STATICLIB_TINYDIR_IO_END(probe, 0, true);
+                throw tinydir_exception(TRACEMSG("Error iterating directory," +
+                        " path: [" + dir_path + "], error: [" + ::strerror(errno) + "]"));
+            }
+            break;
+        }
+        auto name = std::string(en->d_name);
+        if ("." != name && ".." != name) {
+            res.emplace_back(std::move(name));
+        }
+    }
+    STATICLIB_TINYDIR_IO_END(probe, 0, false);
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+file_status directory::stat(const std::string& name, bool follow_symlinks) const {
+    auto flags = follow_symlinks ? 0 : AT_SYMLINK_NOFOLLOW;
+    STATICLIB_TINYDIR_IO_BEGIN(probe, stat, child_path(name));
+    native_stat st;
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    auto err = ::fstatat(fd, name.c_str(), std::addressof(st), flags);
+#else
+    auto err = ::fstatat64(fd, name.c_str(), std::addressof(st), flags);
+#endif // STATICLIB_MAC || STATICLIB_IOS
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != err && ENOENT != errno && ENOTDIR != errno);
+    if (0 != err) {
+        if (ENOENT == errno || ENOTDIR == errno) {
+            return file_status();
+        }
+        throw tinydir_exception(TRACEMSG("Error reading file status, path: [" + child_path(name) + "]," +
+                " error: [" + ::strerror(errno) + "]"));
+    }
+    return status_from_native(st);
+}
+
+void directory::create_directory(const std::string& name) const {
+    STATICLIB_TINYDIR_IO_BEGIN(probe, create_directory, child_path(name));
+    auto err = ::mkdirat(fd, name.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != err);
+    if (0 != err) throw tinydir_exception(TRACEMSG(
+            "Error creating directory, path: [" + child_path(name) + "],"
+            " error: [" + ::strerror(errno) + "]"));
+}
+
+void directory::remove(const std::string& name) const {
+    auto st = stat(name);
+    if (file_type::not_found == st.type) throw tinydir_exception(TRACEMSG(
+            "Error removing file or directory, path: [" + child_path(name) + "],"
+            " error: [" + ::strerror(ENOENT) + "]"));
+    auto flags = 0;
+    if (file_type::directory == st.type) {
+        // entry may be replaced with a symlink after the check above,
+        // its target must not be descended into
+        auto dfd = open_subdirectory(name, O_NOFOLLOW);
+        if (-1 != dfd) {
+            auto sub = directory(dfd, child_path(name));
+            for (auto& ch : sub.list()) {
+                sub.remove(ch);
+            }
+            flags = AT_REMOVEDIR;
+        } else if (ELOOP != errno && ENOTDIR != errno) {
+            throw tinydir_exception(TRACEMSG("Error opening directory,"
+                    " path: [" + child_path(name) + "], error: [" + ::strerror(errno) + "]"));
+        }
+    }
+    STATICLIB_TINYDIR_IO_BEGIN(probe, remove, child_path(name));
+    auto err = ::unlinkat(fd, name.c_str(), flags);
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != err);
+    if (0 != err) throw tinydir_exception(TRACEMSG(
+            "Error removing file or directory, path: [" + child_path(name) + "],"
+            " error: [" + ::strerror(errno) + "]"));
+}
+
+void directory::rename(const std::string& name, const std::string& target_name) const {
+    rename(name, *this, target_name);
+}
+
+void directory::rename(const std::string& name, const directory& target_dir,
+        const std::string& target_name) const {
+    STATICLIB_TINYDIR_IO_BEGIN(probe, rename, child_path(name));
+    auto err = ::renameat(fd, name.c_str(), target_dir.fd, target_name.c_str());
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != err);
+    if (0 != err) throw tinydir_exception(TRACEMSG("Error renaming file," +
+            " path: [" + child_path(name) + "], target: [" + target_dir.child_path(target_name) + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+}
+
+int directory::open_subdirectory(const std::string& name, int extra_flags) const {
+    STATICLIB_TINYDIR_IO_BEGIN(probe, open, child_path(name));
+    auto res = ::openat(fd, name.c_str(), O_RDONLY | O_DIRECTORY | extra_flags);
+    auto errnum = errno;
+    STATICLIB_TINYDIR_IO_END(probe, 0, -1 == res);
+    errno = errnum;
+    return res;
+}
+
+void directory::close() STATICLIB_NOEXCEPT {
+    if (-1 != fd) {
+        STATICLIB_TINYDIR_IO_BEGIN(probe, close, dir_path);
+        auto err = ::close(fd);
+        STATICLIB_TINYDIR_IO_END(probe, 0, -1 == err);
+        (void) err;
+        fd = -1;
+    }
+}
+
+#endif // STATICLIB_WINDOWS
+
+directory::~directory() STATICLIB_NOEXCEPT {
+    close();
+}
+
+const std::string& directory::path() const {
+    return dir_path;
+}
+
+std::string directory::child_path(const std::string& name) const {
+    if (!dir_path.empty() && '/' == dir_path.back()) {
+        return dir_path + name;
+    }
+    return dir_path + "/" + name;
+}
+
+} // namespace
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   disk_usage.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 1:24 PM
+ */
+
+#include "staticlib/tinydir/disk_usage.hpp"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+
+#include "staticlib/config.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/tinydir/file_status.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "task_pool.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+struct usage_dir {
+    std::string dirpath;
+    uint64_t apparent_size = 0;
+    uint64_t allocated_size = 0;
+    uint64_t inodes_count = 0;
+    std::vector<std::unique_ptr<usage_dir>> children;
+
+    explicit usage_dir(const std::string& dirpath) :
+    dirpath(dirpath.data(), dirpath.length()) { }
+
+    void add(const file_status& st) {
+        apparent_size += st.size;
+        allocated_size += st.allocated_size;
+        inodes_count += 1;
+    }
+};
+
+// sharded to reduce contention between worker threads
+class inodes_registry {
+    static const size_t shards_count = 16;
+    std::array<std::mutex, shards_count> mutexes;
+    std::array<std::set<std::pair<uint64_t, uint64_t>>, shards_count> sets;
+
+public:
+    bool insert(const file_status& st) {
+        auto idx = static_cast<size_t> (st.inode % shards_count);
+        std::lock_guard<std::mutex> guard{mutexes[idx]};
+        return sets[idx].insert(std::make_pair(st.device, st.inode)).second;
+    }
+};
+
+disk_usage_node aggregate(const usage_dir& dir) {
+    auto res = disk_usage_node();
+    res.dirpath = dir.dirpath;
+    res.apparent_size = dir.apparent_size;
+    res.allocated_size = dir.allocated_size;
+    res.inodes_count = dir.inodes_count;
+    for (auto& ch : dir.children) {
+        auto node = aggregate(*ch);
+        res.apparent_size += node.apparent_size;
+        res.allocated_size += node.allocated_size;
+        res.inodes_count += node.inodes_count;
+        res.children.emplace_back(std::move(node));
+    }
+    return res;
+}
+
+} // namespace
+
+disk_usage_node disk_usage(const std::string& root_dir, const disk_usage_options& options) {
+    auto root_path = normalize_path(root_dir);
+    auto root_st = status(root_path);
+    if (file_type::directory != root_st.type) throw tinydir_exception(TRACEMSG(
+            "Invalid disk usage root directory, path: [" + root_dir + "]"));
+    auto root = usage_dir(root_path);
+    root.add(root_st);
+    inodes_registry inodes;
+    std::function<void(usage_dir&)> walk;
+    task_pool pool(options.threads_count);
+    // each node is modified only by the task that lists its directory
+    walk = [&walk, &pool, &inodes, &options, &root_st](usage_dir& dir) {
+        for (auto& ch : list_directory(dir.dirpath)) {
+            auto st = ch.symlink_status();
+            // entry removed concurrently
+            if (file_type::not_found == st.type) continue;
+            if (file_type::directory == st.type) {
+                if (options.one_filesystem && st.device != root_st.device) continue;
+                dir.children.emplace_back(new usage_dir(ch.filepath()));
+                auto child = dir.children.back().get();
+                child->add(st);
+                pool.submit([&walk, child] {
+                    walk(*child);
+                });
+            } else {
+                if (options.dedupe_hardlinks && st.links_count > 1 && !inodes.insert(st)) continue;
+                dir.add(st);
+            }
+        }
+    };
+    pool.submit([&walk, &root] {
+        walk(root);
+    });
+    pool.wait();
+    return aggregate(root);
+}
+
+} // namespace
+}
@@ -0,0 +1,528 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_copy.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 6:10 PM
+ */
+
+#include "file_copy.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#ifdef STATICLIB_WINDOWS
+#include "staticlib/support/windows.hpp"
+#include "staticlib/utils/windows.hpp"
+#else // !STATICLIB_WINDOWS
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+#include <copyfile.h>
+#include <sys/clonefile.h>
+#else // !(STATICLIB_MAC || STATICLIB_IOS)
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif // STATICLIB_MAC || STATICLIB_IOS
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "staticlib/tinydir/io_buffer_pool.hpp"
+
+#include "direct_io.hpp"
+#include "io_probe.hpp"
+#include "last_error.hpp"
+#include "native_stat.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+#ifndef STATICLIB_WINDOWS
+
+namespace { // anonymous
+
+// single call limits, sendfile cannot transfer more than 0x7ffff000 bytes at once
+const uint64_t kernel_copy_chunk = 1 << 30;
+const uint64_t sendfile_chunk = 0x7ffff000;
+const size_t copy_buffer_size = 1 << 20;
+
+#if !defined(STATICLIB_MAC) && !defined(STATICLIB_IOS)
+bool kernel_copy_unsupported(int errnum) {
+    return ENOSYS == errnum || EXDEV == errnum || EINVAL == errnum ||
+            EOPNOTSUPP == errnum || EBADF == errnum;
+}
+#endif // !STATICLIB_MAC && !STATICLIB_IOS
+
+ssize_t write_all(int fd, const char* buf, size_t len) {
+    size_t written = 0;
+    while (written < len) {
+        auto res = ::write(fd, buf + written, len - written);
+        if (-1 == res) {
+            if (EINTR == errno) continue;
+            return -1;
+        }
+        written += static_cast<size_t> (res);
+    }
+    return static_cast<ssize_t> (written);
+}
+
+#if !defined(STATICLIB_MAC) && !defined(STATICLIB_IOS)
+// from linux/fs.h, not exposed by older libc headers
+#ifdef FICLONE
+const unsigned long ficlone_request = FICLONE;
+#else // !FICLONE
+const unsigned long ficlone_request = _IOW(0x94, 9, int);
+#endif // FICLONE
+
+std::error_code copy_fd_attributes(int dest, const std::string& to, const native_stat& stat_source) {
+    (void) to;
+    auto err_mod = ::fchmod(dest, stat_source.st_mode & 07777);
+    if (-1 == err_mod) {
+        return last_error_code();
+    }
+    auto mtime_ns = status_from_native(stat_source).mtime_ns;
+    struct timespec times[2];
+    times[0].tv_sec = static_cast<time_t> (mtime_ns / 1000000000);
+    times[0].tv_nsec = static_cast<long> (mtime_ns % 1000000000);
+    times[1] = times[0];
+    STATICLIB_TINYDIR_IO_BEGIN(times_probe, set_times, to);
+    auto err_times = ::futimens(dest, times);
+    STATICLIB_TINYDIR_IO_END(times_probe, 0, -1 == err_times);
+    if (-1 == err_times) {
+        return last_error_code();
+    }
+    return std::error_code();
+}
+#endif // !STATICLIB_MAC && !STATICLIB_IOS
+
+} // namespace
+
+std::error_code copy_fd_contents(int src_fd, int dest_fd, uint64_t size, uint64_t& copied) {
+    copied = 0;
+#if !defined(STATICLIB_MAC) && !defined(STATICLIB_IOS)
+#ifdef SYS_copy_file_range
+    bool use_copy_range = true;
+#else // !SYS_copy_file_range
+    bool use_copy_range = false;
+#endif // SYS_copy_file_range
+    bool use_sendfile = true;
+#endif // !STATICLIB_MAC && !STATICLIB_IOS
+    io_buffer buf;
+    while (copied < size) {
+        auto left = size - copied;
+        ssize_t res = -1;
+#if !defined(STATICLIB_MAC) && !defined(STATICLIB_IOS)
+        if (use_copy_range) {
+#ifdef SYS_copy_file_range
+            auto len = static_cast<size_t> (std::min(left, kernel_copy_chunk));
+            res = static_cast<ssize_t> (::syscall(SYS_copy_file_range, src_fd, nullptr, dest_fd, nullptr, len, 0));
+#endif // SYS_copy_file_range
+            // positions are not moved on failure, so it is safe to fall back
+            if (-1 == res && 0 == copied && kernel_copy_unsupported(errno)) {
+                use_copy_range = false;
+                continue;
+            }
+        } else if (use_sendfile) {
+            auto len = static_cast<size_t> (std::min(left, sendfile_chunk));
+            res = ::sendfile(dest_fd, src_fd, nullptr, len);
+            if (-1 == res && 0 == copied && kernel_copy_unsupported(errno)) {
+                use_sendfile = false;
+                continue;
+            }
+        } else
+#endif // !STATICLIB_MAC && !STATICLIB_IOS
+        {
+            if (0 == buf.size()) {
+                buf = acquire_io_buffer(static_cast<size_t> (std::min(size, static_cast<uint64_t> (copy_buffer_size))));
+            }
+            auto len = static_cast<size_t> (std::min(left, static_cast<uint64_t> (buf.size())));
+            res = ::read(src_fd, buf.data(), len);
+            if (res > 0) {
+                auto written = write_all(dest_fd, buf.data(), static_cast<size_t> (res));
+                if (-1 == written) {
+                    return last_error_code();
+                }
+            }
+        }
+        if (-1 == res) {
+            if (EINTR == errno) continue;
+            return last_error_code();
+        }
+        if (0 == res) {
+            break;
+        }
+        copied += static_cast<uint64_t> (res);
+    }
+    return std::error_code();
+}
+
+std::error_code read_data_extents(int fd, uint64_t size, std::vector<file_extent>& extents) {
+    extents.clear();
+#ifdef SEEK_DATA
+    uint64_t pos = 0;
+    while (pos < size) {
+        auto data = ::lseek(fd, static_cast<off_t> (pos), SEEK_DATA);
+        if (static_cast<off_t> (-1) == data) {
+            if (ENXIO == errno) {
+                // trailing hole
+                return std::error_code();
+            }
+            if (EINVAL == errno && extents.empty()) {
+                break;
+            }
+            return last_error_code();
+        }
+        if (static_cast<uint64_t> (data) >= size) {
+            return std::error_code();
+        }
+        auto hole = ::lseek(fd, data, SEEK_HOLE);
+        if (static_cast<off_t> (-1) == hole) {
+            return last_error_code();
+        }
+        auto end = std::min(static_cast<uint64_t> (hole), size);
+        extents.emplace_back(static_cast<uint64_t> (data), end - static_cast<uint64_t> (data));
+        pos = end;
+    }
+    if (!extents.empty() || 0 == size) {
+        return std::error_code();
+    }
+#endif // SEEK_DATA
+    extents.clear();
+    if (size > 0) {
+        extents.emplace_back(0, size);
+    }
+    return std::error_code();
+}
+
+std::error_code copy_fd_sparse(int src_fd, int dest_fd, uint64_t size, uint64_t& copied) {
+    copied = 0;
+    auto extents = std::vector<file_extent>();
+    auto ec = read_data_extents(src_fd, size, extents);
+    if (ec) {
+        return ec;
+    }
+    uint64_t data_size = 0;
+    for (auto& ex : extents) {
+        data_size += ex.length;
+    }
+    auto flags = ::fcntl(dest_fd, F_GETFL);
+    bool append = -1 != flags && 0 != (flags & O_APPEND);
+    if (static_cast<off_t> (-1) == ::lseek(src_fd, 0, SEEK_SET)) {
+        return last_error_code();
+    }
+    if (data_size == size || append) {
+        return copy_fd_contents(src_fd, dest_fd, size, copied);
+    }
+
+    auto base = ::lseek(dest_fd, 0, SEEK_CUR);
+    if (static_cast<off_t> (-1) == base) {
+        return last_error_code();
+    }
+    native_stat st;
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    auto err_stat = ::fstat(dest_fd, std::addressof(st));
+#else
+    auto err_stat = ::fstat64(dest_fd, std::addressof(st));
+#endif // STATICLIB_MAC || STATICLIB_IOS
+    if (-1 == err_stat) {
+        return last_error_code();
+    }
+    // holes are skipped, so existing destination data in the target range
+    // would show through them
+    if (st.st_size > base) {
+        return copy_fd_contents(src_fd, dest_fd, size, copied);
+    }
+    for (auto& ex : extents) {
+        auto dest_off = static_cast<off_t> (static_cast<uint64_t> (base) + ex.offset);
+        if (static_cast<off_t> (-1) == ::lseek(src_fd, static_cast<off_t> (ex.offset), SEEK_SET) ||
+                static_cast<off_t> (-1) == ::lseek(dest_fd, dest_off, SEEK_SET)) {
+            return last_error_code();
+        }
+        uint64_t done = 0;
+        ec = copy_fd_contents(src_fd, dest_fd, ex.length, done);
+        if (ec) {
+            return ec;
+        }
+        if (done < ex.length) {
+            // source was truncated concurrently
+            copied = ex.offset + done;
+            return std::error_code();
+        }
+    }
+    // trailing hole, destination is extended to the full size
+    auto end = static_cast<off_t> (static_cast<uint64_t> (base) + size);
+    if (-1 == ::ftruncate(dest_fd, end)) {
+        return last_error_code();
+    }
+    if (static_cast<off_t> (-1) == ::lseek(dest_fd, end, SEEK_SET)) {
+        return last_error_code();
+    }
+    copied = size;
+    return std::error_code();
+}
+
+std::error_code copy_fd_range(int src_fd, int dest_fd, uint64_t offset, uint64_t size, uint64_t& copied) {
+    copied = 0;
+#if !defined(STATICLIB_MAC) && !defined(STATICLIB_IOS) && defined(SYS_copy_file_range)
+    bool use_copy_range = true;
+#endif // !STATICLIB_MAC && !STATICLIB_IOS && SYS_copy_file_range
+    io_buffer buf;
+    while (copied < size) {
+        auto left = size - copied;
+        auto off = offset + copied;
+        ssize_t res = -1;
+#if !defined(STATICLIB_MAC) && !defined(STATICLIB_IOS) && defined(SYS_copy_file_range)
+        if (use_copy_range) {
+            auto len = static_cast<size_t> (std::min(left, kernel_copy_chunk));
+            loff_t off_in = static_cast<loff_t> (off);
+            loff_t off_out = static_cast<loff_t> (off);
+            res = static_cast<ssize_t> (::syscall(SYS_copy_file_range, src_fd, std::addressof(off_in),
+                    dest_fd, std::addressof(off_out), len, 0));
+            if (-1 == res && 0 == copied && kernel_copy_unsupported(errno)) {
+                use_copy_range = false;
+                continue;
+            }
+        } else
+#endif // !STATICLIB_MAC && !STATICLIB_IOS && SYS_copy_file_range
+        {
+            if (0 == buf.size()) {
+                buf = acquire_io_buffer(static_cast<size_t> (std::min(size, static_cast<uint64_t> (copy_buffer_size))));
+            }
+            auto len = static_cast<size_t> (std::min(left, static_cast<uint64_t> (buf.size())));
+            res = ::pread(src_fd, buf.data(), len, static_cast<off_t> (off));
+            if (res > 0) {
+                auto ec = direct_io_write_at(dest_fd, buf.data(), static_cast<size_t> (res), off);
+                if (ec) {
+                    return ec;
+                }
+            }
+        }
+        if (-1 == res) {
+            if (EINTR == errno) continue;
+            return last_error_code();
+        }
+        if (0 == res) {
+            break;
+        }
+        copied += static_cast<uint64_t> (res);
+    }
+    return std::error_code();
+}
+
+std::error_code preallocate_fd(int fd, uint64_t size) {
+    if (0 == size) {
+        return std::error_code();
+    }
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    fstore_t store;
+    std::memset(std::addressof(store), '\0', sizeof(store));
+    store.fst_flags = F_ALLOCATECONTIG;
+    store.fst_posmode = F_PEOFPOSMODE;
+    store.fst_length = static_cast<off_t> (size);
+    if (-1 == ::fcntl(fd, F_PREALLOCATE, std::addressof(store))) {
+        // contiguous space is not available
+        store.fst_flags = F_ALLOCATEALL;
+        ::fcntl(fd, F_PREALLOCATE, std::addressof(store));
+    }
+#else // !(STATICLIB_MAC || STATICLIB_IOS)
+    auto err = ::fallocate(fd, 0, 0, static_cast<off_t> (size));
+    if (-1 == err && EOPNOTSUPP != errno && ENOSYS != errno) {
+        return last_error_code();
+    }
+#endif // STATICLIB_MAC || STATICLIB_IOS
+    if (-1 == ::ftruncate(fd, static_cast<off_t> (size))) {
+        return last_error_code();
+    }
+    return std::error_code();
+}
+
+std::error_code reserve_fd_space(int fd, uint64_t size) {
+    if (0 == size) {
+        return std::error_code();
+    }
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    // F_PREALLOCATE does not change the file size
+    fstore_t store;
+    std::memset(std::addressof(store), '\0', sizeof(store));
+    store.fst_flags = F_ALLOCATEALL;
+    store.fst_posmode = F_PEOFPOSMODE;
+    store.fst_length = static_cast<off_t> (size);
+    if (-1 == ::fcntl(fd, F_PREALLOCATE, std::addressof(store)) && ENOTSUP != errno) {
+        return last_error_code();
+    }
+#else // !(STATICLIB_MAC || STATICLIB_IOS)
+    auto err = ::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t> (size));
+    if (-1 == err && EOPNOTSUPP != errno && ENOSYS != errno) {
+        return last_error_code();
+    }
+#endif // STATICLIB_MAC || STATICLIB_IOS
+    return std::error_code();
+}
+
+#endif // !STATICLIB_WINDOWS
+
+// https://stackoverflow.com/q/10195343/314015
+std::error_code copy_regular_file(const std::string& from, const std::string& to,
+        bool preserve_attributes, const char*& failed_op) {
+    failed_op = "Error copying file";
+#ifdef STATICLIB_WINDOWS
+    // attributes and modification time are always copied
+    (void) preserve_attributes;
+    auto wfrom = sl::utils::widen(from);
+    auto wto = sl::utils::widen(to);
+    STATICLIB_TINYDIR_IO_BEGIN(probe, copy, from);
+    auto err = ::CopyFileW(wfrom.c_str(), wto.c_str(), false);
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 == err);
+    if (0 == err) {
+        return last_error_code();
+    }
+#elif defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    // attributes and modification time are always copied
+    (void) preserve_attributes;
+    STATICLIB_TINYDIR_IO_BEGIN(probe, copy, from);
+#ifdef COPYFILE_DATA_SPARSE
+    auto err_cf = ::copyfile(from.c_str(), to.c_str(), nullptr, COPYFILE_ALL | COPYFILE_DATA_SPARSE);
+#else // !COPYFILE_DATA_SPARSE
+    auto err_cf = ::copyfile(from.c_str(), to.c_str(), nullptr, COPYFILE_ALL);
+#endif // COPYFILE_DATA_SPARSE
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != err_cf);
+    if (0 != err_cf) {
+        return last_error_code();
+    }
+#else // linux
+    STATICLIB_TINYDIR_IO_BEGIN(src_probe, open, from);
+    int source = ::open(from.c_str(), O_RDONLY, 0);
+    STATICLIB_TINYDIR_IO_END(src_probe, 0, -1 == source);
+    if (-1 == source) {
+        failed_op = "Error opening src file";
+        return last_error_code();
+    }
+    auto deferred_src = sl::support::defer([source]() STATICLIB_NOEXCEPT {
+        ::close(source);
+    });
+    native_stat stat_source;
+    auto err_stat = ::fstat64(source, std::addressof(stat_source));
+    if (-1 == err_stat) {
+        failed_op = "Error obtaining file status";
+        return last_error_code();
+    }
+
+    STATICLIB_TINYDIR_IO_BEGIN(dest_probe, open, to);
+    int dest = ::open(to.c_str(), O_WRONLY | O_CREAT | O_TRUNC, stat_source.st_mode);
+    STATICLIB_TINYDIR_IO_END(dest_probe, 0, -1 == dest);
+    if (-1 == dest) {
+        failed_op = "Error opening dest file";
+        return last_error_code();
+    }
+    auto deferred_dest = sl::support::defer([dest]() STATICLIB_NOEXCEPT {
+        ::close(dest);
+    });
+
+    uint64_t copied = 0;
+    STATICLIB_TINYDIR_IO_BEGIN(copy_probe, copy, from);
+    auto ec = copy_fd_sparse(source, dest, static_cast<uint64_t> (stat_source.st_size), copied);
+    STATICLIB_TINYDIR_IO_END(copy_probe, copied, static_cast<bool> (ec));
+    if (ec) {
+        return ec;
+    }
+
+    if (preserve_attributes) {
+        failed_op = "Error copying file attributes";
+        return copy_fd_attributes(dest, to, stat_source);
+    }
+#endif // STATICLIB_WINDOWS
+    return std::error_code();
+}
+
+std::error_code clone_regular_file(const std::string& from, const std::string& to, const char*& failed_op) {
+    failed_op = "Error cloning file";
+#ifdef STATICLIB_WINDOWS
+    // block cloning is available only on ReFS
+    (void) from;
+    (void) to;
+    return std::make_error_code(std::errc::operation_not_supported);
+#elif defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    // attributes and modification time are always copied
+    STATICLIB_TINYDIR_IO_BEGIN(probe, copy, from);
+    auto err = ::clonefile(from.c_str(), to.c_str(), 0);
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != err);
+    if (0 != err) {
+        return ENOTSUP == errno ? std::make_error_code(std::errc::operation_not_supported) :
+                last_error_code();
+    }
+    return std::error_code();
+#else // linux
+    STATICLIB_TINYDIR_IO_BEGIN(src_probe, open, from);
+    int source = ::open(from.c_str(), O_RDONLY, 0);
+    STATICLIB_TINYDIR_IO_END(src_probe, 0, -1 == source);
+    if (-1 == source) {
+        failed_op = "Error opening src file";
+        return last_error_code();
+    }
+    auto deferred_src = sl::support::defer([source]() STATICLIB_NOEXCEPT {
+        ::close(source);
+    });
+    native_stat stat_source;
+    auto err_stat = ::fstat64(source, std::addressof(stat_source));
+    if (-1 == err_stat) {
+        failed_op = "Error obtaining file status";
+        return last_error_code();
+    }
+
+    STATICLIB_TINYDIR_IO_BEGIN(dest_probe, open, to);
+    int dest = ::open(to.c_str(), O_WRONLY | O_CREAT | O_EXCL, stat_source.st_mode);
+    STATICLIB_TINYDIR_IO_END(dest_probe, 0, -1 == dest);
+    if (-1 == dest) {
+        failed_op = "Error opening dest file";
+        return last_error_code();
+    }
+    bool cloned = false;
+    auto deferred_dest = sl::support::defer([dest, &cloned, &to]() STATICLIB_NOEXCEPT {
+        ::close(dest);
+        if (!cloned) {
+            ::unlink(to.c_str());
+        }
+    });
+
+    STATICLIB_TINYDIR_IO_BEGIN(clone_probe, copy, from);
+    auto err = ::ioctl(dest, ficlone_request, source);
+    STATICLIB_TINYDIR_IO_END(clone_probe, 0, -1 == err);
+    if (-1 == err) {
+        // different FS or FS without shared extents
+        if (EOPNOTSUPP == errno || ENOTTY == errno || EXDEV == errno || EINVAL == errno) {
+            return std::make_error_code(std::errc::operation_not_supported);
+        }
+        return last_error_code();
+    }
+    failed_op = "Error copying file attributes";
+    auto ec = copy_fd_attributes(dest, to, stat_source);
+    cloned = !ec;
+    return ec;
+#endif // STATICLIB_WINDOWS
+}
+
+} // namespace
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_copy.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 6:05 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_FILE_COPY_HPP
+#define STATICLIB_TINYDIR_FILE_COPY_HPP
+
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+#include "staticlib/tinydir/file_source.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+#ifndef STATICLIB_WINDOWS
+
+/**
+ * Copies up to "size" bytes between the current positions of the
+ * specified descriptors, "copy_file_range" is used when available,
+ * then "sendfile", then plain reads and writes. Stops early on EOF.
+ *
+ * @param src_fd source descriptor
+ * @param dest_fd destination descriptor
+ * @param size number of bytes to copy
+ * @param copied number of bytes actually copied
+ * @return error code, empty on success
+ */
+std::error_code copy_fd_contents(int src_fd, int dest_fd, uint64_t size, uint64_t& copied);
+
+/**
+ * Finds data ranges of the file using SEEK_DATA/SEEK_HOLE, the whole file
+ * is reported as data if holes are not supported. Moves the file position.
+ *
+ * @param fd file descriptor
+ * @param size file size
+ * @param extents output extents
+ * @return error code, empty on success
+ */
+std::error_code read_data_extents(int fd, uint64_t size, std::vector<file_extent>& extents);
+
+/**
+ * Copies "size" bytes from the beginning of the source descriptor to
+ * the current position of the destination one, holes are preserved
+ * unless destination is opened in append mode or already has data
+ * at or after the current position.
+ *
+ * @param src_fd source descriptor
+ * @param dest_fd destination descriptor
+ * @param size source file size
+ * @param copied number of bytes (including holes) actually copied
+ * @return error code, empty on success
+ */
+std::error_code copy_fd_sparse(int src_fd, int dest_fd, uint64_t size, uint64_t& copied);
+
+/**
+ * Copies up to "size" bytes at the specified offset of the source descriptor
+ * to the same offset of the destination one, file positions are not used,
+ * so the call can run concurrently for different ranges of the same files.
+ * "copy_file_range" is used when available, then "pread" and "pwrite".
+ * Stops early on EOF.
+ *
+ * @param src_fd source descriptor
+ * @param dest_fd destination descriptor
+ * @param offset range offset in both files
+ * @param size number of bytes to copy
+ * @param copied number of bytes actually copied
+ * @return error code, empty on success
+ */
+std::error_code copy_fd_range(int src_fd, int dest_fd, uint64_t offset, uint64_t size, uint64_t& copied);
+
+/**
+ * Allocates disk space for the whole file and sets its size, only
+ * the size is set if FS does not support preallocation
+ *
+ * @param fd file descriptor
+ * @param size file size
+ * @return error code, empty on success
+ */
+std::error_code preallocate_fd(int fd, uint64_t size);
+
+/**
+ * Allocates disk space for the first "size" bytes of the file without
+ * changing its size, does nothing if FS does not support preallocation
+ *
+ * @param fd file descriptor
+ * @param size number of bytes to allocate
+ * @return error code, empty on success
+ */
+std::error_code reserve_fd_space(int fd, uint64_t size);
+
+#endif // !STATICLIB_WINDOWS
+
+/**
+ * Copies a regular file, target is created or truncated
+ *
+ * @param from source path
+ * @param to target path
+ * @param preserve_attributes whether to copy permissions and modification time
+ * @param failed_op description of the step that failed, for error messages
+ * @return error code, empty on success
+ */
+std::error_code copy_regular_file(const std::string& from, const std::string& to,
+        bool preserve_attributes, const char*& failed_op);
+
+/**
+ * Clones a regular file sharing the data extents with the source
+ * (copy-on-write), "FICLONE" is used on linux and "clonefile" on mac.
+ * Permissions and modification time are copied. Target must not exist.
+ *
+ * @param from source path
+ * @param to target path
+ * @param failed_op description of the step that failed, for error messages
+ * @return error code, empty on success, "operation_not_supported"
+ *         if FS cannot share the extents between these files
+ */
+std::error_code clone_regular_file(const std::string& from, const std::string& to, const char*& failed_op);
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_FILE_COPY_HPP */
@@ -21,6 +21,7 @@
  * Created on February 6, 2017, 2:52 PM
  */
 
+#include <algorithm>
 #include <array>
 
 #include "staticlib/config.hpp"
@@ -28,10 +29,8 @@
 #include "staticlib/support/windows.hpp"
 #include "staticlib/utils/windows.hpp"
 #else // STATICLIB_WINDOWS
-#ifndef STATICLIB_MAC
-#include <sys/sendfile.h>
-#endif // STATICLIB_MAC
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <cstdlib>
@@ -44,32 +43,43 @@
 #include "staticlib/io/operations.hpp"
 #include "staticlib/tinydir/file_sink.hpp"
 #include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/io_buffer_pool.hpp"
 #include "staticlib/tinydir/path.hpp"
 
+#include "direct_io.hpp"
+#include "file_copy.hpp"
+#include "io_probe.hpp"
+#include "last_error.hpp"
+
 namespace staticlib {
 namespace tinydir {
 
 #ifdef STATICLIB_WINDOWS
 
-file_sink::file_sink(const std::string& file_path, open_mode mode) :
-file_path(file_path.data(), file_path.size()) {
-    std::wstring wpath = sl::utils::widen(this->file_path);
-    auto access = open_mode::append == mode ? FILE_APPEND_DATA : GENERIC_WRITE;
+namespace { // anonymous
+
+HANDLE open_handle(const std::string& file_path, file_sink::open_mode mode) {
+    std::wstring wpath = sl::utils::widen(file_path);
+    auto access = file_sink::open_mode::append == mode ? FILE_APPEND_DATA : GENERIC_WRITE;
     DWORD flags = 0;
     switch (mode) {
-    case open_mode::create:
+    case file_sink::open_mode::create:
         flags = CREATE_ALWAYS;
         break;
-    case open_mode::append:
+    case file_sink::open_mode::append:
         flags = OPEN_EXISTING;
         break;
-    case open_mode::from_file:
+    case file_sink::open_mode::from_file:
         flags = OPEN_ALWAYS;
         access |= GENERIC_READ;
         break;
+    case file_sink::open_mode::create_new:
+        flags = CREATE_NEW;
+        break;
     default: throw tinydir_exception(TRACEMSG("Invalid 'open_mode' specified"));
     }
-    handle = ::CreateFileW(
+    STATICLIB_TINYDIR_IO_BEGIN(probe, open, file_path);
+    auto res = ::CreateFileW(
             wpath.c_str(),
             access,
             FILE_SHARE_READ | FILE_SHARE_WRITE,
@@ -77,11 +87,31 @@ file_path(file_path.data(), file_path.size()) {
             flags,
             FILE_ATTRIBUTE_NORMAL,
             NULL);
+    STATICLIB_TINYDIR_IO_END(probe, 0, INVALID_HANDLE_VALUE == res);
+    return res;
+}
+
+} // namespace
+
+file_sink::file_sink(const std::string& file_path, open_mode mode) :
+file_path(file_path.data(), file_path.size()) {
+    handle = open_handle(this->file_path, mode);
     if (INVALID_HANDLE_VALUE == handle) throw tinydir_exception(TRACEMSG(
             "Error opening file descriptor: [" + sl::utils::errcode_to_string(::GetLastError()) + "]," +
             " specified path: [" + this->file_path + "]"));
 }
 
+file_sink::file_sink(const std::string& file_path, open_mode mode, std::error_code& ec) :
+file_path(file_path.data(), file_path.size()) {
+    handle = open_handle(this->file_path, mode);
+    if (INVALID_HANDLE_VALUE == handle) {
+        ec = last_error_code();
+        handle = nullptr;
+    } else {
+        ec.clear();
+    }
+}
+
 file_sink::file_sink(file_sink&& other) STATICLIB_NOEXCEPT :
 handle(other.handle),
 file_path(std::move(other.file_path)) {
@@ -101,8 +131,10 @@ std::streamsize file_sink::write(sl::io::span<const char> span) {
         DWORD ulen = span.size() <= std::numeric_limits<uint32_t>::max() ?
                 static_cast<uint32_t> (span.size()) :
                 std::numeric_limits<uint32_t>::max();
+        STATICLIB_TINYDIR_IO_BEGIN(probe, write, file_path);
         auto err = ::WriteFile(handle, static_cast<const void*> (span.data()), ulen,
                 std::addressof(res), nullptr);
+        STATICLIB_TINYDIR_IO_END(probe, 0 != err ? res : 0, 0 == err);
         if (0 != err) {
             return static_cast<std::streamsize> (res);
         }
@@ -111,9 +143,24 @@ std::streamsize file_sink::write(sl::io::span<const char> span) {
     } else throw tinydir_exception(TRACEMSG("Attempt to write into closed file: [" + file_path + "]"));
 }
 
+std::streamsize file_sink::write_vector(const std::vector<sl::io::span<const char>>& spans) {
+    // no gather writes for buffered handles, stops on the first partial write
+    std::streamsize res = 0;
+    for (auto& sp : spans) {
+        auto written = write(sp);
+        res += written;
+        if (static_cast<size_t> (written) < sp.size()) {
+            break;
+        }
+    }
+    return res;
+}
+
 std::streampos file_sink::seek(std::streamsize offset) {
     if (nullptr != handle) {
+        STATICLIB_TINYDIR_IO_BEGIN(probe, seek, file_path);
         auto res = ::SetFilePointer(handle, static_cast<LONG>(offset), nullptr, FILE_CURRENT);
+        STATICLIB_TINYDIR_IO_END(probe, 0, INVALID_SET_FILE_POINTER == res);
         if (INVALID_SET_FILE_POINTER != res) {
             return static_cast<std::streampos> (res);
         }
@@ -122,37 +169,116 @@ std::streampos file_sink::seek(std::streamsize offset) {
     } else throw tinydir_exception(TRACEMSG("Attempt to seek over closed file: [" + file_path + "]"));
 }
 
+void file_sink::reserve_space(uint64_t size) {
+    if (nullptr == handle) throw tinydir_exception(TRACEMSG(
+            "Attempt to reserve space for closed file: [" + file_path + "]"));
+    FILE_ALLOCATION_INFO info;
+    info.AllocationSize.QuadPart = static_cast<LONGLONG> (size);
+    STATICLIB_TINYDIR_IO_BEGIN(probe, resize, file_path);
+    auto err = ::SetFileInformationByHandle(handle, FileAllocationInfo,
+            std::addressof(info), sizeof(info));
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 == err);
+    if (0 == err) throw tinydir_exception(TRACEMSG("Error reserving space for file: [" + file_path + "]," +
+            " size: [" + sl::support::to_string(size) + "]," +
+            " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+}
+
+void file_sink::resize(uint64_t size) {
+    if (nullptr == handle) throw tinydir_exception(TRACEMSG(
+            "Attempt to resize closed file: [" + file_path + "]"));
+    FILE_END_OF_FILE_INFO eof;
+    eof.EndOfFile.QuadPart = static_cast<LONGLONG> (size);
+    FILE_ALLOCATION_INFO info;
+    info.AllocationSize.QuadPart = static_cast<LONGLONG> (size);
+    STATICLIB_TINYDIR_IO_BEGIN(probe, resize, file_path);
+    auto err = ::SetFileInformationByHandle(handle, FileEndOfFileInfo,
+            std::addressof(eof), sizeof(eof));
+    if (0 != err) {
+        // end of file alone does not release the allocation beyond it
+        err = ::SetFileInformationByHandle(handle, FileAllocationInfo,
+                std::addressof(info), sizeof(info));
+    }
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 == err);
+    if (0 == err) throw tinydir_exception(TRACEMSG("Error resizing file: [" + file_path + "]," +
+            " size: [" + sl::support::to_string(size) + "]," +
+            " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+}
+
+void file_sink::sync() {
+    if (nullptr == handle) throw tinydir_exception(TRACEMSG(
+            "Attempt to sync closed file: [" + file_path + "]"));
+    STATICLIB_TINYDIR_IO_BEGIN(probe, sync, file_path);
+    auto err = ::FlushFileBuffers(handle);
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 == err);
+    if (0 == err) throw tinydir_exception(TRACEMSG("Error syncing file: [" + file_path + "]," +
+            " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+}
+
 void file_sink::close() STATICLIB_NOEXCEPT {
     if (nullptr != handle) {
-        ::CloseHandle(handle);
+        STATICLIB_TINYDIR_IO_BEGIN(probe, close, file_path);
+        auto err = ::CloseHandle(handle);
+        STATICLIB_TINYDIR_IO_END(probe, 0, 0 == err);
+        (void) err;
         handle = nullptr;
     }
 }
 
 #else // STATICLIB_WINDOWS
 
-file_sink::file_sink(const std::string& file_path, open_mode mode) :
-file_path(file_path.data(), file_path.size()) {
+namespace { // anonymous
+
+// within IOV_MAX on all supported systems
+const size_t max_write_vector_size = 256;
+
+int open_fd(const std::string& file_path, file_sink::open_mode mode) {
     int flags = 0;
     switch (mode) {
-    case open_mode::create:
+    case file_sink::open_mode::create:
         flags = O_WRONLY | O_CREAT | O_TRUNC;
         break;
-    case open_mode::append:
+    case file_sink::open_mode::append:
         flags = O_WRONLY | O_APPEND;
         break;
-    case open_mode::from_file:
+    case file_sink::open_mode::from_file:
         flags = O_RDWR | O_CREAT;
         break;
+    case file_sink::open_mode::create_new:
+        flags = O_WRONLY | O_CREAT | O_EXCL;
+        break;
     default: throw tinydir_exception(TRACEMSG("Invalid 'open_mode' specified"));
     }
 
-    this->fd = ::open(this->file_path.c_str(), flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    STATICLIB_TINYDIR_IO_BEGIN(probe, open, file_path);
+    auto res = ::open(file_path.c_str(), flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    STATICLIB_TINYDIR_IO_END(probe, 0, -1 == res);
+    return res;
+}
+
+} // namespace
+
+file_sink::file_sink(const std::string& file_path, open_mode mode) :
+file_path(file_path.data(), file_path.size()) {
+    this->fd = open_fd(this->file_path, mode);
     if (-1 == this->fd) throw tinydir_exception(TRACEMSG(
             "Error opening file: [" + this->file_path + "]," +
             " error: [" + ::strerror(errno) + "]"));
 }
 
+file_sink::file_sink(const std::string& file_path, open_mode mode, std::error_code& ec) :
+file_path(file_path.data(), file_path.size()) {
+    this->fd = open_fd(this->file_path, mode);
+    if (-1 == this->fd) {
+        ec = last_error_code();
+    } else {
+        ec.clear();
+    }
+}
+
+file_sink::file_sink(int fd, std::string file_path) :
+fd(fd),
+file_path(std::move(file_path)) { }
+
 file_sink::file_sink(file_sink&& other) STATICLIB_NOEXCEPT :
 fd(other.fd),
 file_path(std::move(other.file_path)) {
@@ -168,23 +294,79 @@ file_sink& file_sink::operator=(file_sink&& other) STATICLIB_NOEXCEPT {
 
 std::streamsize file_sink::write(sl::io::span<const char> span) {
     if (-1 != fd) {
+        STATICLIB_TINYDIR_IO_BEGIN(probe, write, file_path);
         auto res = ::write(fd, span.data(), span.size());
+        STATICLIB_TINYDIR_IO_END(probe, -1 != res ? res : 0, -1 == res);
         if (-1 != res) return res;
         throw tinydir_exception(TRACEMSG("Write error to file: [" + file_path + "]," +
                 " error: [" + ::strerror(errno) + "]"));
     } else throw tinydir_exception(TRACEMSG("Attempt to write into closed file: [" + file_path + "]"));
 }
 
+std::streamsize file_sink::write_vector(const std::vector<sl::io::span<const char>>& spans) {
+    if (-1 == fd) throw tinydir_exception(TRACEMSG(
+            "Attempt to write into closed file: [" + file_path + "]"));
+    std::array<struct iovec, max_write_vector_size> iov;
+    auto count = std::min(spans.size(), iov.size());
+    for (size_t i = 0; i < count; i++) {
+        iov[i].iov_base = const_cast<char*> (spans[i].data());
+        iov[i].iov_len = spans[i].size();
+    }
+    STATICLIB_TINYDIR_IO_BEGIN(probe, write, file_path);
+    auto res = ::writev(fd, iov.data(), static_cast<int> (count));
+    STATICLIB_TINYDIR_IO_END(probe, -1 != res ? res : 0, -1 == res);
+    if (-1 != res) return res;
+    throw tinydir_exception(TRACEMSG("Write error to file: [" + file_path + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+}
+
+void file_sink::reserve_space(uint64_t size) {
+    if (-1 == fd) throw tinydir_exception(TRACEMSG(
+            "Attempt to reserve space for closed file: [" + file_path + "]"));
+    STATICLIB_TINYDIR_IO_BEGIN(probe, resize, file_path);
+    auto ec = reserve_fd_space(fd, size);
+    STATICLIB_TINYDIR_IO_END(probe, 0, static_cast<bool> (ec));
+    if (ec) throw tinydir_exception(TRACEMSG("Error reserving space for file: [" + file_path + "]," +
+            " size: [" + sl::support::to_string(size) + "]," +
+            " error: [" + ec.message() + "]"));
+}
+
+void file_sink::resize(uint64_t size) {
+    if (-1 == fd) throw tinydir_exception(TRACEMSG(
+            "Attempt to resize closed file: [" + file_path + "]"));
+    STATICLIB_TINYDIR_IO_BEGIN(probe, resize, file_path);
+    auto err = ::ftruncate(fd, static_cast<off_t> (size));
+    STATICLIB_TINYDIR_IO_END(probe, 0, -1 == err);
+    if (-1 == err) throw tinydir_exception(TRACEMSG("Error resizing file: [" + file_path + "]," +
+            " size: [" + sl::support::to_string(size) + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+}
+
+void file_sink::sync() {
+    if (-1 == fd) throw tinydir_exception(TRACEMSG(
+            "Attempt to sync closed file: [" + file_path + "]"));
+    STATICLIB_TINYDIR_IO_BEGIN(probe, sync, file_path);
+    auto err = ::fsync(fd);
+    STATICLIB_TINYDIR_IO_END(probe, 0, -1 == err);
+    if (-1 == err) throw tinydir_exception(TRACEMSG("Error syncing file: [" + file_path + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+}
+
 void file_sink::close() STATICLIB_NOEXCEPT {
     if (-1 != fd) {
-        ::close(fd);
+        STATICLIB_TINYDIR_IO_BEGIN(probe, close, file_path);
+        auto err = ::close(fd);
+        STATICLIB_TINYDIR_IO_END(probe, 0, -1 == err);
+        (void) err;
         fd = -1;
     }
 }
 
 std::streampos file_sink::seek(std::streamsize offset) {
     if (-1 != fd) {
+        STATICLIB_TINYDIR_IO_BEGIN(probe, seek, file_path);
         auto res = ::lseek(fd, offset, SEEK_CUR);
+        STATICLIB_TINYDIR_IO_END(probe, 0, static_cast<off_t> (-1) == res);
         if (static_cast<off_t> (-1) != res) return res;
         throw tinydir_exception(TRACEMSG("Seek error over file: [" + file_path + "]," +
                 " error: [" + ::strerror(errno) + "]"));
@@ -194,29 +376,65 @@ std::streampos file_sink::seek(std::streamsize offset) {
 #endif // STATICLIB_WINDOWS
 
 
+void file_sink::write_at(sl::io::span<const char> span, uint64_t offset) {
+#ifdef STATICLIB_WINDOWS
+    auto fh = handle;
+    bool open = nullptr != fh;
+#else // !STATICLIB_WINDOWS
+    auto fh = fd;
+    bool open = -1 != fh;
+#endif // STATICLIB_WINDOWS
+    if (!open) throw tinydir_exception(TRACEMSG(
+            "Attempt to write into closed file: [" + file_path + "]"));
+    STATICLIB_TINYDIR_IO_BEGIN(probe, write, file_path);
+    auto ec = direct_io_write_at(fh, span.data(), span.size(), offset);
+    STATICLIB_TINYDIR_IO_END(probe, ec ? 0 : span.size(), static_cast<bool> (ec));
+    if (ec) throw tinydir_exception(TRACEMSG("Write error to file: [" + file_path + "]," +
+            " offset: [" + sl::support::to_string(offset) + "]," +
+            " error: [" + ec.message() + "]"));
+}
+
 std::streamsize file_sink::write_from_file(const std::string& source_file) {
 #ifdef STATICLIB_LINUX
     if (-1 == fd) throw tinydir_exception(TRACEMSG(
             "Attempt to write into closed file: [" + file_path + "]"));
+    STATICLIB_TINYDIR_IO_BEGIN(open_probe, open, source_file);
     int source = ::open(source_file.c_str(), O_RDONLY, 0);
+    STATICLIB_TINYDIR_IO_END(open_probe, 0, -1 == source);
     if (-1 == source) throw sl::tinydir::tinydir_exception(TRACEMSG(
             "Error opening src file: [" + source_file + "]," +
             " error: [" + ::strerror(errno) + "]"));
-    auto deferred_src = sl::support::defer([source]() STATICLIB_NOEXCEPT {
-        ::close(source);
+    auto deferred_src = sl::support::defer([source, &source_file]() STATICLIB_NOEXCEPT {
+        STATICLIB_TINYDIR_IO_BEGIN(close_probe, close, source_file);
+        auto err = ::close(source);
+        STATICLIB_TINYDIR_IO_END(close_probe, 0, -1 == err);
+        (void) err;
     });
+    STATICLIB_TINYDIR_IO_BEGIN(stat_probe, stat, source_file);
     struct stat stat_source;
     auto err_stat = ::fstat(source, std::addressof(stat_source));
+    STATICLIB_TINYDIR_IO_END(stat_probe, 0, -1 == err_stat);
     if (-1 == err_stat) throw sl::tinydir::tinydir_exception(TRACEMSG(
             "Error obtaining file status: [" + source_file + "]," +
             " error: [" + ::strerror(errno) + "]"));
-    auto writed_bytes = ::sendfile(fd, source, NULL, stat_source.st_size);
-    if (-1 == writed_bytes) throw support::exception(TRACEMSG(
+    STATICLIB_TINYDIR_IO_BEGIN(copy_probe, copy, file_path);
+    uint64_t copied = 0;
+    auto ec = copy_fd_sparse(source, fd, static_cast<uint64_t> (stat_source.st_size), copied);
+    STATICLIB_TINYDIR_IO_END(copy_probe, copied, static_cast<bool> (ec));
+    if (ec) throw support::exception(TRACEMSG(
             "Error copying file: [" + source_file + "]," +
-            " target: [" + file_path + "]" + " error: [" + ::strerror(errno) + "]"));
+            " target: [" + file_path + "]" + " error: [" + ec.message() + "]"));
+    auto writed_bytes = static_cast<std::streamsize> (copied);
 #else // !STATICLIB_LINUX
     auto src = file_source(source_file);
-    auto writed_bytes = sl::io::copy_all(src, *this);
+    auto buf = acquire_io_buffer(1 << 16);
+    std::streamsize writed_bytes = 0;
+    for (;;) {
+        auto read = src.read(buf.span());
+        if (std::char_traits<char>::eof() == read) break;
+        sl::io::write_all(*this, {buf.data(), static_cast<size_t> (read)});
+        writed_bytes += read;
+    }
 #endif // STATICLIB_LINUX
     return writed_bytes;
 }
@@ -27,26 +27,45 @@
 #ifdef STATICLIB_WINDOWS
 #include "staticlib/support/windows.hpp"
 #include "staticlib/utils/windows.hpp"
+#include <winioctl.h>
 #else // STATICLIB_WINDOWS
 #include <sys/stat.h>
+#include <sys/types.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <cstdlib>
 #include <cstring>
 #include <cerrno>
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#else // !(STATICLIB_MAC || STATICLIB_IOS)
+#include <sys/sendfile.h>
+#endif // STATICLIB_MAC || STATICLIB_IOS
 #endif // STATICLIB_WINDOWS
 
+#include <algorithm>
+
 #include "staticlib/utils.hpp"
 
+#include "staticlib/tinydir/io_buffer_pool.hpp"
+
+#include "file_copy.hpp"
+#include "io_probe.hpp"
+#include "last_error.hpp"
+#include "native_stat.hpp"
+
 namespace staticlib {
 namespace tinydir {
 
 #ifdef STATICLIB_WINDOWS
 
-file_source::file_source(const std::string& file_path) :
-file_path(file_path.data(), file_path.size()) {
-    std::wstring wpath = sl::utils::widen(this->file_path);
-    handle = ::CreateFileW(
+namespace { // anonymous
+
+HANDLE open_handle(const std::string& file_path) {
+    std::wstring wpath = sl::utils::widen(file_path);
+    STATICLIB_TINYDIR_IO_BEGIN(probe, open, file_path);
+    auto res = ::CreateFileW(
             wpath.c_str(),
             GENERIC_READ,
             FILE_SHARE_READ | FILE_SHARE_WRITE,
@@ -54,11 +73,31 @@ file_path(file_path.data(), file_path.size()) {
             OPEN_EXISTING,
             FILE_ATTRIBUTE_NORMAL,
             NULL);
+    STATICLIB_TINYDIR_IO_END(probe, 0, INVALID_HANDLE_VALUE == res);
+    return res;
+}
+
+} // namespace
+
+file_source::file_source(const std::string& file_path) :
+file_path(file_path.data(), file_path.size()) {
+    handle = open_handle(this->file_path);
     if (INVALID_HANDLE_VALUE == handle) throw tinydir_exception(TRACEMSG(
             "Error opening file descriptor: [" + sl::utils::errcode_to_string(::GetLastError()) + "]" +
             ", specified path: [" + this->file_path + "]"));
 }
 
+file_source::file_source(const std::string& file_path, std::error_code& ec) :
+file_path(file_path.data(), file_path.size()) {
+    handle = open_handle(this->file_path);
+    if (INVALID_HANDLE_VALUE == handle) {
+        ec = last_error_code();
+        handle = nullptr;
+    } else {
+        ec.clear();
+    }
+}
+
 file_source::file_source(file_source&& other) STATICLIB_NOEXCEPT :
 handle(other.handle),
 file_path(std::move(other.file_path)) {
@@ -78,8 +117,10 @@ std::streamsize file_source::read(sl::io::span<char> span) {
         DWORD ulen = span.size() <= std::numeric_limits<uint32_t>::max() ?
                 static_cast<uint32_t> (span.size()) :
                 std::numeric_limits<uint32_t>::max();
+        STATICLIB_TINYDIR_IO_BEGIN(probe, read, file_path);
         auto err = ::ReadFile(handle, static_cast<void*> (span.data()), ulen,
                 std::addressof(res), nullptr);
+        STATICLIB_TINYDIR_IO_END(probe, 0 != err ? res : 0, 0 == err);
         if (0 != err) {
             return res > 0 ? static_cast<std::streamsize> (res) : std::char_traits<char>::eof();
         }
@@ -103,12 +144,15 @@ std::streampos file_source::seek(std::streamsize offset, char whence) {
         }
         LONG lDistanceToMove = static_cast<LONG> (offset & 0xffffffff);
         LONG lDistanceToMoveHigh = static_cast<LONG> (offset >> 32);
+        STATICLIB_TINYDIR_IO_BEGIN(probe, seek, file_path);
         DWORD dwResultLow = ::SetFilePointer(
                 handle,
                 lDistanceToMove,
                 std::addressof(lDistanceToMoveHigh),
                 dwMoveMethod);
-        if (INVALID_SET_FILE_POINTER != dwResultLow || ::GetLastError() == NO_ERROR) {
+        auto success = INVALID_SET_FILE_POINTER != dwResultLow || ::GetLastError() == NO_ERROR;
+        STATICLIB_TINYDIR_IO_END(probe, 0, !success);
+        if (success) {
             return (static_cast<long long int> (lDistanceToMoveHigh) << 32) +dwResultLow;
         }
         throw tinydir_exception(TRACEMSG("Seek error over file: [" + file_path + "]," +
@@ -118,15 +162,21 @@ std::streampos file_source::seek(std::streamsize offset, char whence) {
 
 void file_source::close() STATICLIB_NOEXCEPT {
     if (nullptr != handle) {
-        ::CloseHandle(handle);
+        STATICLIB_TINYDIR_IO_BEGIN(probe, close, file_path);
+        auto err = ::CloseHandle(handle);
+        STATICLIB_TINYDIR_IO_END(probe, 0, 0 == err);
+        (void) err;
         handle = nullptr;
     }
 }
 
 off_t file_source::size() {
     if (nullptr != handle) {
+        STATICLIB_TINYDIR_IO_BEGIN(probe, stat, file_path);
         DWORD res = ::GetFileSize(handle, nullptr);
-        if (INVALID_FILE_SIZE != res || ::GetLastError() == NO_ERROR) {
+        auto success = INVALID_FILE_SIZE != res || ::GetLastError() == NO_ERROR;
+        STATICLIB_TINYDIR_IO_END(probe, 0, !success);
+        if (success) {
             return static_cast<off_t> (res);
         }
         throw tinydir_exception(TRACEMSG("Error getting size of file: [" + file_path + "]," +
@@ -134,15 +184,138 @@ off_t file_source::size() {
     } else throw tinydir_exception(TRACEMSG("Attempt to get size of closed file: [" + file_path + "]"));
 }
 
+file_status file_source::status() {
+    if (nullptr != handle) {
+        BY_HANDLE_FILE_INFORMATION info;
+        STATICLIB_TINYDIR_IO_BEGIN(probe, stat, file_path);
+        auto err = ::GetFileInformationByHandle(handle, std::addressof(info));
+        STATICLIB_TINYDIR_IO_END(probe, 0, 0 == err);
+        if (0 != err) {
+            return status_from_native(info, true);
+        }
+        throw tinydir_exception(TRACEMSG("Error reading status of file: [" + file_path + "]," +
+                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+    } else throw tinydir_exception(TRACEMSG("Attempt to get status of closed file: [" + file_path + "]"));
+}
+
+std::vector<file_extent> file_source::data_extents() {
+    if (nullptr == handle) throw tinydir_exception(TRACEMSG(
+            "Attempt to read extents of closed file: [" + file_path + "]"));
+    auto fsize = static_cast<uint64_t> (size());
+    auto res = std::vector<file_extent>();
+    FILE_ALLOCATED_RANGE_BUFFER query;
+    query.FileOffset.QuadPart = 0;
+    query.Length.QuadPart = static_cast<LONGLONG> (fsize);
+    auto ranges = std::vector<FILE_ALLOCATED_RANGE_BUFFER>(64);
+    while (fsize > 0) {
+        DWORD bytes = 0;
+        STATICLIB_TINYDIR_IO_BEGIN(probe, seek, file_path);
+        auto success = ::DeviceIoControl(handle, FSCTL_QUERY_ALLOCATED_RANGES,
+                std::addressof(query), sizeof(query), ranges.data(),
+                static_cast<DWORD> (ranges.size() * sizeof(FILE_ALLOCATED_RANGE_BUFFER)),
+                std::addressof(bytes), nullptr);
+        auto err = success ? ERROR_SUCCESS : ::GetLastError();
+        STATICLIB_TINYDIR_IO_END(probe, 0, !success && ERROR_MORE_DATA != err);
+        if (!success && ERROR_MORE_DATA != err) {
+            if (res.empty() && ERROR_INVALID_FUNCTION == err) {
+                // FS does not support sparse files
+                res.emplace_back(0, fsize);
+                break;
+            }
+            throw tinydir_exception(TRACEMSG("Error reading extents of file: [" + file_path + "]," +
+                    " error: [" + sl::utils::errcode_to_string(err) + "]"));
+        }
+        auto count = bytes / sizeof(FILE_ALLOCATED_RANGE_BUFFER);
+        for (size_t i = 0; i < count; i++) {
+            res.emplace_back(static_cast<uint64_t> (ranges[i].FileOffset.QuadPart),
+                    static_cast<uint64_t> (ranges[i].Length.QuadPart));
+        }
+        if (success || 0 == count) {
+            break;
+        }
+        auto& last = ranges[count - 1];
+        auto next = last.FileOffset.QuadPart + last.Length.QuadPart;
+        query.FileOffset.QuadPart = next;
+        query.Length.QuadPart = static_cast<LONGLONG> (fsize) - next;
+    }
+    return res;
+}
+
+uint64_t file_source::transfer_to(int, uint64_t, uint64_t) {
+    throw tinydir_exception(TRACEMSG("Zero-copy transfer is not supported on windows," +
+            " file: [" + file_path + "]"));
+}
+
+uint64_t file_source::transfer_to(int, uint64_t, uint64_t, std::error_code& ec) {
+    ec = std::make_error_code(std::errc::not_supported);
+    return 0;
+}
+
 #else // STATICLIB_WINDOWS
 
+namespace { // anonymous
+
+// single call limit for "sendfile" and "splice" on linux
+const uint64_t transfer_chunk = 0x7ffff000;
+
+bool would_block(int errnum) {
+    return EAGAIN == errnum || EWOULDBLOCK == errnum;
+}
+
+// plain reads and writes, used when the kernel cannot transfer
+// between the descriptors directly
+ssize_t transfer_buffered(int src_fd, int dest_fd, uint64_t offset, uint64_t count, io_buffer& buf) {
+    if (0 == buf.size()) {
+        buf = acquire_io_buffer(static_cast<size_t> (std::min(count, static_cast<uint64_t> (1 << 16))));
+    }
+    auto len = static_cast<size_t> (std::min(count, static_cast<uint64_t> (buf.size())));
+    auto read = ::pread(src_fd, buf.data(), len, static_cast<off_t> (offset));
+    if (read <= 0) {
+        return read;
+    }
+    size_t written = 0;
+    while (written < static_cast<size_t> (read)) {
+        auto res = ::write(dest_fd, buf.data() + written, static_cast<size_t> (read) - written);
+        if (-1 == res) {
+            if (EINTR == errno) continue;
+            if (written > 0 && would_block(errno)) break;
+            return -1;
+        }
+        written += static_cast<size_t> (res);
+    }
+    return static_cast<ssize_t> (written);
+}
+
+int open_fd(const std::string& file_path) {
+    STATICLIB_TINYDIR_IO_BEGIN(probe, open, file_path);
+    auto res = ::open(file_path.c_str(), O_RDONLY);
+    STATICLIB_TINYDIR_IO_END(probe, 0, -1 == res);
+    return res;
+}
+
+} // namespace
+
 file_source::file_source(const std::string& file_path) :
 file_path(file_path.data(), file_path.size()) {
-    fd = ::open(this->file_path.c_str(), O_RDONLY);
+    fd = open_fd(this->file_path);
     if (-1 == fd) throw tinydir_exception(TRACEMSG("Error opening file: [" + this->file_path + "]," +
             " error: [" + ::strerror(errno) + "]"));
 }
 
+file_source::file_source(const std::string& file_path, std::error_code& ec) :
+file_path(file_path.data(), file_path.size()) {
+    fd = open_fd(this->file_path);
+    if (-1 == fd) {
+        ec = last_error_code();
+    } else {
+        ec.clear();
+    }
+}
+
+file_source::file_source(int fd, std::string file_path) :
+fd(fd),
+file_path(std::move(file_path)) { }
+
 file_source::file_source(file_source&& other) STATICLIB_NOEXCEPT :
 fd(other.fd),
 file_path(std::move(other.file_path)) {
@@ -158,7 +331,9 @@ file_source& file_source::operator=(file_source&& other) STATICLIB_NOEXCEPT {
 
 std::streamsize file_source::read(sl::io::span<char> span) {
     if (-1 != fd) {
+        STATICLIB_TINYDIR_IO_BEGIN(probe, read, file_path);
         auto res = ::read(fd, span.data(), span.size());
+        STATICLIB_TINYDIR_IO_END(probe, -1 != res ? res : 0, -1 == res);
         if (-1 != res) {
             return res > 0 ? res : std::char_traits<char>::eof();
         }
@@ -180,7 +355,9 @@ std::streampos file_source::seek(std::streamsize offset, char whence) {
         default: throw tinydir_exception(TRACEMSG("Invalid whence value: [" + whence + "]" +
                     " for seeking file: [" + file_path + "]"));
         }
+        STATICLIB_TINYDIR_IO_BEGIN(probe, seek, file_path);
         auto res = lseek(fd, offset, whence_int);
+        STATICLIB_TINYDIR_IO_END(probe, 0, static_cast<off_t> (-1) == res);
         if (static_cast<off_t> (-1) != res) return res;
         throw tinydir_exception(TRACEMSG("Seek error over file: [" + file_path + "]," +
                 " error: [" + ::strerror(errno) + "]"));
@@ -189,13 +366,17 @@ std::streampos file_source::seek(std::streamsize offset, char whence) {
 
 void file_source::close() STATICLIB_NOEXCEPT {
     if (-1 != fd) {
-        ::close(fd);
+        STATICLIB_TINYDIR_IO_BEGIN(probe, close, file_path);
+        auto err = ::close(fd);
+        STATICLIB_TINYDIR_IO_END(probe, 0, -1 == err);
+        (void) err;
         fd = -1;
     }
 }
 
 off_t file_source::size() {
     if (-1 != fd) {
+        STATICLIB_TINYDIR_IO_BEGIN(probe, stat, file_path);
 #if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
         struct stat stat_buf;
         int rc = ::fstat(fd, &stat_buf);
@@ -203,6 +384,7 @@ off_t file_source::size() {
         struct stat64 stat_buf;
         int rc = ::fstat64(fd, &stat_buf);
 #endif // STATICLIB_MAC || STATICLIB_IOS
+        STATICLIB_TINYDIR_IO_END(probe, 0, 0 != rc);
         if (0 == rc) {
             return stat_buf.st_size;
         }
@@ -211,6 +393,138 @@ off_t file_source::size() {
     } else throw tinydir_exception(TRACEMSG("Attempt to get size of closed file: [" + file_path + "]"));
 }
 
+file_status file_source::status() {
+    if (-1 != fd) {
+        native_stat st;
+        STATICLIB_TINYDIR_IO_BEGIN(probe, stat, file_path);
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+        int rc = ::fstat(fd, std::addressof(st));
+#else
+        int rc = ::fstat64(fd, std::addressof(st));
+#endif // STATICLIB_MAC || STATICLIB_IOS
+        STATICLIB_TINYDIR_IO_END(probe, 0, 0 != rc);
+        if (0 == rc) {
+            return status_from_native(st);
+        }
+        throw tinydir_exception(TRACEMSG("Error reading status of file: [" + file_path + "]," +
+                " error: [" + ::strerror(errno) + "]"));
+    } else throw tinydir_exception(TRACEMSG("Attempt to get status of closed file: [" + file_path + "]"));
+}
+
+std::vector<file_extent> file_source::data_extents() {
+    if (-1 == fd) throw tinydir_exception(TRACEMSG(
+            "Attempt to read extents of closed file: [" + file_path + "]"));
+    auto fsize = static_cast<uint64_t> (size());
+    auto pos = ::lseek(fd, 0, SEEK_CUR);
+    if (static_cast<off_t> (-1) == pos) throw tinydir_exception(TRACEMSG(
+            "Seek error over file: [" + file_path + "], error: [" + ::strerror(errno) + "]"));
+    auto res = std::vector<file_extent>();
+    STATICLIB_TINYDIR_IO_BEGIN(probe, seek, file_path);
+    auto ec = read_data_extents(fd, fsize, res);
+    auto err_restore = ::lseek(fd, pos, SEEK_SET);
+    STATICLIB_TINYDIR_IO_END(probe, 0, ec || static_cast<off_t> (-1) == err_restore);
+    if (ec) throw tinydir_exception(TRACEMSG("Error reading extents of file: [" + file_path + "]," +
+            " error: [" + ec.message() + "]"));
+    if (static_cast<off_t> (-1) == err_restore) throw tinydir_exception(TRACEMSG(
+            "Seek error over file: [" + file_path + "], error: [" + ::strerror(errno) + "]"));
+    return res;
+}
+
+uint64_t file_source::transfer_to(int dest_fd, uint64_t offset, uint64_t count) {
+    if (-1 == fd) throw tinydir_exception(TRACEMSG(
+            "Attempt to transfer from closed file: [" + file_path + "]"));
+    std::error_code ec;
+    auto res = transfer_to(dest_fd, offset, count, ec);
+    if (ec && (std::errc::operation_would_block != ec || 0 == res)) throw tinydir_exception(TRACEMSG(
+            "Error transferring file: [" + file_path + "]," +
+            " error: [" + ec.message() + "]"));
+    return res;
+}
+
+uint64_t file_source::transfer_to(int dest_fd, uint64_t offset, uint64_t count, std::error_code& ec) {
+    ec.clear();
+    if (-1 == fd) {
+        ec = std::make_error_code(std::errc::bad_file_descriptor);
+        return 0;
+    }
+#if !defined(STATICLIB_MAC) && !defined(STATICLIB_IOS)
+    native_stat st;
+    if (-1 == ::fstat64(dest_fd, std::addressof(st))) {
+        ec = last_error_code();
+        return 0;
+    }
+    bool to_pipe = S_ISFIFO(st.st_mode);
+    auto dest_flags = ::fcntl(dest_fd, F_GETFL);
+    unsigned int splice_flags = SPLICE_F_MOVE;
+    if (-1 != dest_flags && 0 != (dest_flags & O_NONBLOCK)) {
+        splice_flags |= SPLICE_F_NONBLOCK;
+    }
+#endif // !STATICLIB_MAC && !STATICLIB_IOS
+    bool use_kernel = true;
+    io_buffer buf;
+    uint64_t done = 0;
+    STATICLIB_TINYDIR_IO_BEGIN(probe, copy, file_path);
+    while (done < count) {
+        auto left = std::min(count - done, transfer_chunk);
+        auto off = offset + done;
+        ssize_t res = -1;
+        if (use_kernel) {
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+            // sockets only, sent length is reported on errors too
+            off_t len = static_cast<off_t> (left);
+            auto err = ::sendfile(fd, dest_fd, static_cast<off_t> (off), std::addressof(len), nullptr, 0);
+            if (-1 == err && 0 == len && 0 == done &&
+                    (ENOTSOCK == errno || EOPNOTSUPP == errno || EINVAL == errno)) {
+                use_kernel = false;
+                continue;
+            }
+            if (-1 == err && len > 0) {
+                // partial transfer, error is reported by the next call
+                done += static_cast<uint64_t> (len);
+                if (would_block(errno)) {
+                    ec = std::make_error_code(std::errc::operation_would_block);
+                    break;
+                }
+                continue;
+            }
+            res = -1 == err ? -1 : static_cast<ssize_t> (len);
+#else // !(STATICLIB_MAC || STATICLIB_IOS)
+            auto src_off = static_cast<loff_t> (off);
+            if (to_pipe) {
+                res = ::splice(fd, std::addressof(src_off), dest_fd, nullptr,
+                        static_cast<size_t> (left), splice_flags);
+            } else {
+                auto sf_off = static_cast<off_t> (off);
+                res = ::sendfile(dest_fd, fd, std::addressof(sf_off), static_cast<size_t> (left));
+            }
+            if (-1 == res && 0 == done && (EINVAL == errno || ENOSYS == errno)) {
+                use_kernel = false;
+                continue;
+            }
+#endif // STATICLIB_MAC || STATICLIB_IOS
+        } else {
+            res = transfer_buffered(fd, dest_fd, off, left, buf);
+        }
+        if (-1 == res) {
+            if (EINTR == errno) continue;
+            if (would_block(errno)) {
+                ec = std::make_error_code(std::errc::operation_would_block);
+                break;
+            }
+            STATICLIB_TINYDIR_IO_END(probe, done, true);
+            ec = last_error_code();
+            return done;
+        }
+        if (0 == res) {
+            // EOF
+            break;
+        }
+        done += static_cast<uint64_t> (res);
+    }
+    STATICLIB_TINYDIR_IO_END(probe, done, false);
+    return done;
+}
+
 #endif // STATICLIB_WINDOWS
 
 file_source::~file_source() STATICLIB_NOEXCEPT {
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_status.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:07 AM
+ */
+
+#include "staticlib/tinydir/file_status.hpp"
+
+#include "staticlib/config.hpp"
+
+#ifdef STATICLIB_WINDOWS
+#include "staticlib/support/windows.hpp"
+#include "staticlib/utils/windows.hpp"
+#else // !STATICLIB_WINDOWS
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "io_probe.hpp"
+#include "last_error.hpp"
+#include "native_stat.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+#ifdef STATICLIB_WINDOWS
+
+// difference between 1601-01-01 and 1970-01-01 in 100ns intervals
+const int64_t filetime_epoch_diff = 116444736000000000LL;
+
+int64_t filetime_to_ns(const FILETIME& ft) {
+    int64_t ticks = (static_cast<int64_t> (ft.dwHighDateTime) << 32) + ft.dwLowDateTime;
+    return (ticks - filetime_epoch_diff) * 100;
+}
+
+FILETIME ns_to_filetime(int64_t ns) {
+    int64_t ticks = ns / 100 + filetime_epoch_diff;
+    FILETIME res;
+    res.dwLowDateTime = static_cast<DWORD> (ticks & 0xffffffff);
+    res.dwHighDateTime = static_cast<DWORD> (ticks >> 32);
+    return res;
+}
+
+file_status read_status(const std::string& path, bool follow, std::error_code& ec) {
+    auto wpath = sl::utils::widen(path);
+    DWORD flags = FILE_FLAG_BACKUP_SEMANTICS;
+    if (!follow) {
+        flags |= FILE_FLAG_OPEN_REPARSE_POINT;
+    }
+    STATICLIB_TINYDIR_IO_BEGIN(probe, stat, path);
+    auto handle = ::CreateFileW(
+            wpath.c_str(),
+            FILE_READ_ATTRIBUTES,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            NULL, // lpSecurityAttributes
+            OPEN_EXISTING,
+            flags,
+            NULL);
+    if (INVALID_HANDLE_VALUE == handle) {
+        auto code = ::GetLastError();
+        auto not_found = ERROR_FILE_NOT_FOUND == code || ERROR_PATH_NOT_FOUND == code;
+        STATICLIB_TINYDIR_IO_END(probe, 0, !not_found);
+        if (!not_found) {
+            ec = std::error_code(static_cast<int> (code), std::system_category());
+        }
+        return file_status();
+    }
+    auto deferred = sl::support::defer([handle]() STATICLIB_NOEXCEPT {
+        ::CloseHandle(handle);
+    });
+    BY_HANDLE_FILE_INFORMATION info;
+    auto err = ::GetFileInformationByHandle(handle, std::addressof(info));
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 == err);
+    if (0 == err) {
+        ec = last_error_code();
+        return file_status();
+    }
+    return status_from_native(info, follow);
+}
+
+#else // !STATICLIB_WINDOWS
+
+// "stat" and "stat64" structs have the same fields
+template<typename Stat>
+file_status convert_stat(const Stat& st) {
+    file_status res;
+    if (S_ISREG(st.st_mode)) {
+        res.type = file_type::regular_file;
+    } else if (S_ISDIR(st.st_mode)) {
+        res.type = file_type::directory;
+    } else if (S_ISLNK(st.st_mode)) {
+        res.type = file_type::symlink;
+    } else {
+        res.type = file_type::other;
+    }
+    res.size = static_cast<uint64_t> (st.st_size);
+    res.allocated_size = static_cast<uint64_t> (st.st_blocks) * 512;
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    res.mtime_ns = static_cast<int64_t> (st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#elif defined(STATICLIB_ANDROID)
+    res.mtime_ns = static_cast<int64_t> (st.st_mtime) * 1000000000 + st.st_mtime_nsec;
+#else
+    res.mtime_ns = static_cast<int64_t> (st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif // STATICLIB_MAC || STATICLIB_IOS
+    res.mode = static_cast<uint32_t> (st.st_mode & 07777);
+    res.device = static_cast<uint64_t> (st.st_dev);
+    res.inode = static_cast<uint64_t> (st.st_ino);
+    res.links_count = static_cast<uint64_t> (st.st_nlink);
+    return res;
+}
+
+file_status read_status(const std::string& path, bool follow, std::error_code& ec) {
+    STATICLIB_TINYDIR_IO_BEGIN(probe, stat, path);
+    native_stat st;
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    auto err = follow ? ::stat(path.c_str(), std::addressof(st)) : ::lstat(path.c_str(), std::addressof(st));
+#else
+    auto err = follow ? ::stat64(path.c_str(), std::addressof(st)) : ::lstat64(path.c_str(), std::addressof(st));
+#endif // STATICLIB_MAC || STATICLIB_IOS
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != err && ENOENT != errno && ENOTDIR != errno);
+    if (0 != err) {
+        if (ENOENT != errno && ENOTDIR != errno) {
+            ec = last_error_code();
+        }
+        return file_status();
+    }
+    return status_from_native(st);
+}
+
+#endif // STATICLIB_WINDOWS
+
+file_status read_status(const std::string& path, bool follow) {
+    std::error_code ec;
+    auto res = read_status(path, follow, ec);
+    if (ec) throw tinydir_exception(TRACEMSG("Error reading file status, path: [" + path + "]," +
+            " error: [" + ec.message() + "]"));
+    return res;
+}
+
+} // namespace
+
+#ifdef STATICLIB_WINDOWS
+
+file_status status_from_native(const BY_HANDLE_FILE_INFORMATION& info, bool follow) {
+    file_status res;
+    if (!follow && (info.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)) {
+        res.type = file_type::symlink;
+    } else if (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+        res.type = file_type::directory;
+    } else {
+        res.type = file_type::regular_file;
+    }
+    res.size = (static_cast<uint64_t> (info.nFileSizeHigh) << 32) + info.nFileSizeLow;
+    res.allocated_size = res.size;
+    res.mtime_ns = filetime_to_ns(info.ftLastWriteTime);
+    res.mode = (info.dwFileAttributes & FILE_ATTRIBUTE_READONLY) ? 0444 : 0644;
+    res.device = info.dwVolumeSerialNumber;
+    res.inode = (static_cast<uint64_t> (info.nFileIndexHigh) << 32) + info.nFileIndexLow;
+    res.links_count = info.nNumberOfLinks;
+    return res;
+}
+
+#else // !STATICLIB_WINDOWS
+
+file_status status_from_native(const native_stat& st) {
+    return convert_stat(st);
+}
+
+#if !(defined(STATICLIB_MAC) || defined(STATICLIB_IOS))
+file_status status_from_native(const struct stat& st) {
+    return convert_stat(st);
+}
+#endif // !(STATICLIB_MAC || STATICLIB_IOS)
+
+#endif // STATICLIB_WINDOWS
+
+file_status status(const std::string& path) {
+    return read_status(path, true);
+}
+
+file_status status(const std::string& path, std::error_code& ec) {
+    ec.clear();
+    return read_status(path, true, ec);
+}
+
+file_status symlink_status(const std::string& path) {
+    return read_status(path, false);
+}
+
+void set_modification_time(const std::string& path, int64_t mtime_ns) {
+#ifdef STATICLIB_WINDOWS
+    auto wpath = sl::utils::widen(path);
+    auto handle = ::CreateFileW(
+            wpath.c_str(),
+            FILE_WRITE_ATTRIBUTES,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            NULL, // lpSecurityAttributes
+            OPEN_EXISTING,
+            FILE_FLAG_BACKUP_SEMANTICS,
+            NULL);
+    if (INVALID_HANDLE_VALUE == handle) throw tinydir_exception(TRACEMSG(
+            "Error opening file descriptor: [" + sl::utils::errcode_to_string(::GetLastError()) + "]" +
+            ", specified path: [" + path + "]"));
+    auto deferred = sl::support::defer([handle]() STATICLIB_NOEXCEPT {
+        ::CloseHandle(handle);
+    });
+    auto ft = ns_to_filetime(mtime_ns);
+    STATICLIB_TINYDIR_IO_BEGIN(probe, set_times, path);
+    auto err = ::SetFileTime(handle, nullptr, std::addressof(ft), std::addressof(ft));
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 == err);
+    if (0 == err) throw tinydir_exception(TRACEMSG("Error setting modification time, path: [" + path + "]," +
+            " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+#else
+    struct timespec times[2];
+    times[0].tv_sec = static_cast<time_t> (mtime_ns / 1000000000);
+    times[0].tv_nsec = static_cast<long> (mtime_ns % 1000000000);
+    times[1] = times[0];
+    STATICLIB_TINYDIR_IO_BEGIN(probe, set_times, path);
+    auto err = ::utimensat(AT_FDCWD, path.c_str(), times, 0);
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != err);
+    if (0 != err) throw tinydir_exception(TRACEMSG("Error setting modification time, path: [" + path + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+#endif // STATICLIB_WINDOWS
+}
+
+} // namespace
+}
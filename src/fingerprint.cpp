@@ -0,0 +1,523 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fingerprint.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 2:25 PM
+ */
+
+#include "staticlib/tinydir/fingerprint.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <tuple>
+#include <utility>
+
+#include "staticlib/config.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/io_buffer_pool.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/tree_diff.hpp"
+
+#include "task_pool.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+class xxh64_state {
+    static const uint64_t prime1 = 11400714785074694791ULL;
+    static const uint64_t prime2 = 14029467366897019727ULL;
+    static const uint64_t prime3 = 1609587929392839161ULL;
+    static const uint64_t prime4 = 9650029242287828579ULL;
+    static const uint64_t prime5 = 2870177450012600261ULL;
+
+    uint64_t acc[4];
+    unsigned char stripe[32];
+    size_t stripe_len = 0;
+    uint64_t total_len = 0;
+
+public:
+    xxh64_state() {
+        acc[0] = prime1 + prime2;
+        acc[1] = prime2;
+        acc[2] = 0;
+        acc[3] = 0 - prime1;
+    }
+
+    void update(const char* data, size_t len) {
+        auto p = reinterpret_cast<const unsigned char*> (data);
+        auto end = p + len;
+        total_len += len;
+        if (stripe_len > 0) {
+            auto fill = std::min(sizeof(stripe) - stripe_len, len);
+            std::memcpy(stripe + stripe_len, p, fill);
+            stripe_len += fill;
+            p += fill;
+            if (stripe_len < sizeof(stripe)) return;
+            consume(stripe);
+            stripe_len = 0;
+        }
+        while (end - p >= 32) {
+            consume(p);
+            p += 32;
+        }
+        stripe_len = static_cast<size_t> (end - p);
+        std::memcpy(stripe, p, stripe_len);
+    }
+
+    uint64_t digest() const {
+        uint64_t h;
+        if (total_len >= 32) {
+            h = rotl(acc[0], 1) + rotl(acc[1], 7) + rotl(acc[2], 12) + rotl(acc[3], 18);
+            for (size_t i = 0; i < 4; i++) {
+                h ^= round(0, acc[i]);
+                h = h * prime1 + prime4;
+            }
+        } else {
+            h = prime5;
+        }
+        h += total_len;
+        auto p = stripe;
+        auto end = stripe + stripe_len;
+        while (end - p >= 8) {
+            h ^= round(0, read64(p));
+            h = rotl(h, 27) * prime1 + prime4;
+            p += 8;
+        }
+        if (end - p >= 4) {
+            h ^= static_cast<uint64_t> (read32(p)) * prime1;
+            h = rotl(h, 23) * prime2 + prime3;
+            p += 4;
+        }
+        while (p < end) {
+            h ^= static_cast<uint64_t> (*p) * prime5;
+            h = rotl(h, 11) * prime1;
+            p += 1;
+        }
+        h ^= h >> 33;
+        h *= prime2;
+        h ^= h >> 29;
+        h *= prime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+private:
+    void consume(const unsigned char* p) {
+        for (size_t i = 0; i < 4; i++) {
+            acc[i] = round(acc[i], read64(p + i * 8));
+        }
+    }
+
+    static uint64_t rotl(uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    static uint64_t round(uint64_t acc, uint64_t input) {
+        acc += input * prime2;
+        acc = rotl(acc, 31);
+        return acc * prime1;
+    }
+
+    // little-endian hosts only
+    static uint64_t read64(const unsigned char* p) {
+        uint64_t res;
+        std::memcpy(std::addressof(res), p, sizeof(res));
+        return res;
+    }
+
+    static uint32_t read32(const unsigned char* p) {
+        uint32_t res;
+        std::memcpy(std::addressof(res), p, sizeof(res));
+        return res;
+    }
+};
+
+// FIPS 180-4
+class sha256_state {
+    uint32_t h[8];
+    unsigned char block[64];
+    size_t block_len = 0;
+    uint64_t total_len = 0;
+
+public:
+    sha256_state() {
+        static const uint32_t init[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+        };
+        std::memcpy(h, init, sizeof(h));
+    }
+
+    void update(const char* data, size_t len) {
+        auto p = reinterpret_cast<const unsigned char*> (data);
+        total_len += len;
+        while (len > 0) {
+            auto fill = std::min(sizeof(block) - block_len, len);
+            std::memcpy(block + block_len, p, fill);
+            block_len += fill;
+            p += fill;
+            len -= fill;
+            if (sizeof(block) == block_len) {
+                consume();
+                block_len = 0;
+            }
+        }
+    }
+
+    std::string hex_digest() {
+        uint64_t bits = total_len * 8;
+        unsigned char pad = 0x80;
+        update(reinterpret_cast<const char*> (std::addressof(pad)), 1);
+        unsigned char zero = 0;
+        while (56 != block_len) {
+            update(reinterpret_cast<const char*> (std::addressof(zero)), 1);
+        }
+        unsigned char len_be[8];
+        for (size_t i = 0; i < 8; i++) {
+            len_be[i] = static_cast<unsigned char> (bits >> (56 - i * 8));
+        }
+        update(reinterpret_cast<const char*> (len_be), sizeof(len_be));
+        static const char* hexchars = "0123456789abcdef";
+        auto res = std::string();
+        for (size_t i = 0; i < 8; i++) {
+            for (int shift = 28; shift >= 0; shift -= 4) {
+                res.push_back(hexchars[(h[i] >> shift) & 0xf]);
+            }
+        }
+        return res;
+    }
+
+private:
+    static uint32_t rotr(uint32_t x, int r) {
+        return (x >> r) | (x << (32 - r));
+    }
+
+    void consume() {
+        static const uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+        uint32_t w[64];
+        for (size_t i = 0; i < 16; i++) {
+            w[i] = (static_cast<uint32_t> (block[i * 4]) << 24) |
+                    (static_cast<uint32_t> (block[i * 4 + 1]) << 16) |
+                    (static_cast<uint32_t> (block[i * 4 + 2]) << 8) |
+                    static_cast<uint32_t> (block[i * 4 + 3]);
+        }
+        for (size_t i = 16; i < 64; i++) {
+            auto s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            auto s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+        for (size_t i = 0; i < 64; i++) {
+            auto s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            auto ch = (e & f) ^ (~e & g);
+            auto t1 = hh + s1 + ch + k[i] + w[i];
+            auto s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            auto maj = (a & b) ^ (a & c) ^ (b & c);
+            auto t2 = s0 + maj;
+            hh = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+    }
+};
+
+// reads up to "limit" bytes, returns number of bytes hashed
+uint64_t hash_stream(file_source& src, sl::io::span<char> buf, uint64_t limit,
+        xxh64_state& xxh, sha256_state* sha) {
+    uint64_t done = 0;
+    while (done < limit) {
+        auto len = static_cast<size_t> (std::min(static_cast<uint64_t> (buf.size()), limit - done));
+        auto read = src.read({buf.data(), len});
+        if (std::char_traits<char>::eof() == read) break;
+        xxh.update(buf.data(), static_cast<size_t> (read));
+        if (nullptr != sha) {
+            sha->update(buf.data(), static_cast<size_t> (read));
+        }
+        done += static_cast<uint64_t> (read);
+    }
+    return done;
+}
+
+file_fingerprint fingerprint_with_buffer(const std::string& file_path, bool with_sha256,
+        sl::io::span<char> buf) {
+    auto src = file_source(file_path);
+    auto xxh = xxh64_state();
+    auto sha = sha256_state();
+    auto res = file_fingerprint();
+    res.filepath = file_path;
+    res.size = hash_stream(src, buf, std::numeric_limits<uint64_t>::max(), xxh,
+            with_sha256 ? std::addressof(sha) : nullptr);
+    res.xxh64 = xxh.digest();
+    if (with_sha256) {
+        res.sha256 = sha.hex_digest();
+    }
+    return res;
+}
+
+uint64_t partial_hash(const std::string& file_path, uint64_t size, size_t partial_size,
+        sl::io::span<char> buf) {
+    auto src = file_source(file_path);
+    auto xxh = xxh64_state();
+    hash_stream(src, buf, partial_size, xxh, nullptr);
+    src.seek(static_cast<std::streamsize> (size - partial_size));
+    hash_stream(src, buf, partial_size, xxh, nullptr);
+    return xxh.digest();
+}
+
+// reads until the buffer is full or EOF, returns number of bytes read
+size_t read_chunk(file_source& src, sl::io::span<char> buf) {
+    size_t done = 0;
+    while (done < buf.size()) {
+        auto read = src.read({buf.data() + done, buf.size() - done});
+        if (std::char_traits<char>::eof() == read) break;
+        done += static_cast<size_t> (read);
+    }
+    return done;
+}
+
+bool same_contents(const std::string& path1, const std::string& path2, sl::io::span<char> buf1,
+        sl::io::span<char> buf2) {
+    auto src1 = file_source(path1);
+    auto src2 = file_source(path2);
+    for (;;) {
+        auto len1 = read_chunk(src1, buf1);
+        auto len2 = read_chunk(src2, buf2);
+        if (len1 != len2 || 0 != std::memcmp(buf1.data(), buf2.data(), len1)) {
+            return false;
+        }
+        if (len1 < buf1.size()) {
+            return true;
+        }
+    }
+}
+
+struct candidate {
+    std::string filepath;
+    uint64_t size;
+    uint64_t partial;
+    uint64_t full;
+    std::string sha256;
+
+    candidate(std::string filepath, uint64_t size) :
+    filepath(std::move(filepath)),
+    size(size),
+    partial(0),
+    full(0) { }
+};
+
+// keeps only the groups of candidates with the same key
+template<typename KeyFun>
+std::vector<std::vector<candidate>> regroup(std::vector<std::vector<candidate>> groups, KeyFun key) {
+    auto res = std::vector<std::vector<candidate>>();
+    for (auto& gr : groups) {
+        std::stable_sort(gr.begin(), gr.end(), [&key](const candidate& a, const candidate& b) {
+            return key(a) < key(b);
+        });
+        size_t begin = 0;
+        for (size_t i = 1; i <= gr.size(); i++) {
+            if (i == gr.size() || key(gr[begin]) < key(gr[i])) {
+                if (i - begin > 1) {
+                    res.emplace_back(std::make_move_iterator(gr.begin() + begin),
+                            std::make_move_iterator(gr.begin() + i));
+                }
+                begin = i;
+            }
+        }
+    }
+    return res;
+}
+
+// runs the function over all candidates in parallel
+template<typename Fun>
+void for_each_candidate(std::vector<std::vector<candidate>>& groups, const duplicates_options& options,
+        Fun fun) {
+    task_pool pool(options.threads_count);
+    auto buffer_size = options.buffer_size;
+    for (auto& gr : groups) {
+        for (auto& ca : gr) {
+            auto pca = std::addressof(ca);
+            pool.submit([pca, buffer_size, &fun] {
+                // small files do not need a full-sized buffer
+                auto len = std::max(std::min(static_cast<uint64_t> (buffer_size), pca->size),
+                        static_cast<uint64_t> (1));
+                auto buf = acquire_io_buffer(static_cast<size_t> (len));
+                fun(*pca, buf.span());
+            });
+        }
+    }
+    pool.wait();
+}
+
+// splits groups of hash matches into groups of byte-identical files
+std::vector<std::vector<candidate>> confirm_contents(std::vector<std::vector<candidate>> groups,
+        const duplicates_options& options) {
+    auto confirmed = std::vector<std::vector<std::vector<candidate>>>(groups.size());
+    task_pool pool(options.threads_count);
+    auto buffer_size = options.buffer_size;
+    for (size_t i = 0; i < groups.size(); i++) {
+        pool.submit([i, buffer_size, &groups, &confirmed] {
+            auto& gr = groups[i];
+            auto len = std::max(std::min(static_cast<uint64_t> (buffer_size), gr.front().size),
+                    static_cast<uint64_t> (1));
+            auto buf1 = acquire_io_buffer(static_cast<size_t> (len));
+            auto buf2 = acquire_io_buffer(static_cast<size_t> (len));
+            // usually all members match the first one
+            auto& classes = confirmed[i];
+            for (auto& ca : gr) {
+                bool found = false;
+                for (auto& cl : classes) {
+                    if (same_contents(cl.front().filepath, ca.filepath, buf1.span(), buf2.span())) {
+                        cl.emplace_back(std::move(ca));
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found) {
+                    classes.emplace_back();
+                    classes.back().emplace_back(std::move(ca));
+                }
+            }
+        });
+    }
+    pool.wait();
+    auto res = std::vector<std::vector<candidate>>();
+    for (auto& classes : confirmed) {
+        for (auto& cl : classes) {
+            if (cl.size() > 1) {
+                res.emplace_back(std::move(cl));
+            }
+        }
+    }
+    return res;
+}
+
+} // namespace
+
+file_fingerprint fingerprint_file(const std::string& file_path, const fingerprint_options& options) {
+    auto buf = acquire_io_buffer(options.buffer_size);
+    return fingerprint_with_buffer(file_path, options.sha256, buf.span());
+}
+
+std::vector<file_fingerprint> fingerprint_files(const std::vector<std::string>& file_paths,
+        const fingerprint_options& options) {
+    auto res = std::vector<file_fingerprint>(file_paths.size());
+    task_pool pool(options.threads_count);
+    for (size_t i = 0; i < file_paths.size(); i++) {
+        pool.submit([i, &file_paths, &options, &res] {
+            auto buf = acquire_io_buffer(options.buffer_size);
+            res[i] = fingerprint_with_buffer(file_paths[i], options.sha256, buf.span());
+        });
+    }
+    pool.wait();
+    return res;
+}
+
+std::vector<std::vector<std::string>> find_duplicates(const std::vector<std::string>& root_dirs,
+        const duplicates_options& options) {
+    // collect regular files, grouped by size
+    auto by_size = std::map<uint64_t, std::vector<candidate>>();
+    auto inodes = std::set<std::pair<uint64_t, uint64_t>>();
+    for (auto& root_dir : root_dirs) {
+        auto root = normalize_path(root_dir);
+        auto snapshot = snapshot_tree(root, options.threads_count);
+        for (auto& en : snapshot.entries()) {
+            auto& st = en.status;
+            if (file_type::regular_file != st.type || st.size < options.min_size) continue;
+            if (st.links_count > 1 && !inodes.insert(std::make_pair(st.device, st.inode)).second) continue;
+            by_size[st.size].emplace_back(root + "/" + en.relpath, st.size);
+        }
+    }
+    auto groups = std::vector<std::vector<candidate>>();
+    for (auto& pa : by_size) {
+        if (pa.second.size() > 1) {
+            groups.emplace_back(std::move(pa.second));
+        }
+    }
+
+    // hash of head and tail, small files are hashed fully
+    uint64_t partial_size = options.partial_size;
+    for_each_candidate(groups, options, [partial_size](candidate& ca, sl::io::span<char> buf) {
+        if (ca.size <= partial_size * 2) {
+            auto fp = fingerprint_with_buffer(ca.filepath, false, buf);
+            ca.partial = fp.xxh64;
+            ca.full = fp.xxh64;
+        } else {
+            ca.partial = partial_hash(ca.filepath, ca.size, static_cast<size_t> (partial_size), buf);
+        }
+    });
+    groups = regroup(std::move(groups), [](const candidate& ca) {
+        return ca.partial;
+    });
+
+    // full hash of remaining collisions
+    bool with_sha256 = options.sha256;
+    for_each_candidate(groups, options, [partial_size, with_sha256](candidate& ca, sl::io::span<char> buf) {
+        if (ca.size > partial_size * 2 || with_sha256) {
+            auto fp = fingerprint_with_buffer(ca.filepath, with_sha256, buf);
+            ca.full = fp.xxh64;
+            ca.sha256 = std::move(fp.sha256);
+        }
+    });
+    groups = regroup(std::move(groups), [](const candidate& ca) {
+        return std::make_pair(ca.full, ca.sha256);
+    });
+
+    // XXH64 matches are confirmed by comparing contents
+    if (!with_sha256) {
+        groups = confirm_contents(std::move(groups), options);
+    }
+
+    auto res = std::vector<std::vector<std::string>>();
+    for (auto& gr : groups) {
+        auto paths = std::vector<std::string>();
+        for (auto& ca : gr) {
+            paths.emplace_back(std::move(ca.filepath));
+        }
+        std::sort(paths.begin(), paths.end());
+        res.emplace_back(std::move(paths));
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+} // namespace
+}
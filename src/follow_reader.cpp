@@ -0,0 +1,278 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   follow_reader.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 12:55 AM
+ */
+
+#include "staticlib/tinydir/follow_reader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ios>
+#include <thread>
+#include <utility>
+
+#ifdef STATICLIB_LINUX
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif // STATICLIB_LINUX
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+#ifdef STATICLIB_LINUX
+
+const uint32_t dir_events = IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB;
+
+std::string parent_dir(const std::string& path) {
+    auto pos = path.rfind('/');
+    if (std::string::npos == pos) {
+        return ".";
+    }
+    return 0 == pos ? "/" : path.substr(0, pos);
+}
+
+std::string file_name(const std::string& path) {
+    auto pos = path.rfind('/');
+    return std::string::npos == pos ? path : path.substr(pos + 1);
+}
+
+#endif // STATICLIB_LINUX
+
+bool same_file(const file_status& a, const file_status& b) {
+    return a.device == b.device && a.inode == b.inode;
+}
+
+} // namespace
+
+follow_reader::follow_reader(const std::string& file_path, follow_options options) :
+file_path(file_path.data(), file_path.size()),
+options(options) {
+#ifdef STATICLIB_LINUX
+    // polling is used if notifications are not available
+    notify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (-1 != notify_fd) {
+        // directory is watched to see the file re-created after rotation
+        dir_watch = ::inotify_add_watch(notify_fd, parent_dir(this->file_path).c_str(), dir_events);
+        if (-1 == dir_watch) {
+            close_notify();
+        }
+    }
+#endif // STATICLIB_LINUX
+    open_file(true);
+}
+
+follow_reader::~follow_reader() STATICLIB_NOEXCEPT {
+    close_notify();
+}
+
+follow_reader::follow_reader(follow_reader&& other) STATICLIB_NOEXCEPT :
+file_path(std::move(other.file_path)),
+options(other.options),
+src(std::move(other.src)),
+opened(other.opened),
+position(other.position),
+reopens(other.reopens) {
+#ifndef STATICLIB_WINDOWS
+    notify_fd = other.notify_fd;
+    other.notify_fd = -1;
+    dir_watch = other.dir_watch;
+    file_watch = other.file_watch;
+#endif // !STATICLIB_WINDOWS
+}
+
+follow_reader& follow_reader::operator=(follow_reader&& other) STATICLIB_NOEXCEPT {
+    close_notify();
+    file_path = std::move(other.file_path);
+    options = other.options;
+    src = std::move(other.src);
+    opened = other.opened;
+    position = other.position;
+    reopens = other.reopens;
+#ifndef STATICLIB_WINDOWS
+    notify_fd = other.notify_fd;
+    other.notify_fd = -1;
+    dir_watch = other.dir_watch;
+    file_watch = other.file_watch;
+#endif // !STATICLIB_WINDOWS
+    return *this;
+}
+
+std::streamsize follow_reader::read(sl::io::span<char> span) {
+    if (0 == span.size()) {
+        return 0;
+    }
+    if (!src.get() && !open_file(false)) {
+        return 0;
+    }
+    for (;;) {
+        auto res = src->read(span);
+        if (std::char_traits<char>::eof() != res) {
+            position += static_cast<uint64_t> (res);
+            return res;
+        }
+        auto current = src->status();
+        if (current.size < position) {
+            // truncated, data written after truncation is read from the start
+            src->seek(0);
+            position = 0;
+            continue;
+        }
+        auto named = status(file_path);
+        if (file_type::not_found == named.type || same_file(named, opened)) {
+            return 0;
+        }
+        // rotated, old file may have received the last writes after EOF above
+        res = src->read(span);
+        if (std::char_traits<char>::eof() != res) {
+            position += static_cast<uint64_t> (res);
+            return res;
+        }
+        if (!open_file(false)) {
+            return 0;
+        }
+    }
+}
+
+std::streamsize follow_reader::read(sl::io::span<char> span, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        auto res = read(span);
+        if (res > 0) {
+            return res;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return 0;
+        }
+        wait(std::chrono::duration_cast<std::chrono::milliseconds> (deadline - now));
+    }
+}
+
+bool follow_reader::wait(std::chrono::milliseconds timeout) {
+#ifdef STATICLIB_LINUX
+    if (-1 != notify_fd) {
+        struct pollfd pfd;
+        pfd.fd = notify_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        auto err = ::poll(std::addressof(pfd), 1, static_cast<int> (timeout.count()));
+        if (-1 == err && EINTR != errno) throw tinydir_exception(TRACEMSG(
+                "Error waiting for changes of file: [" + file_path + "]," +
+                " error: [" + ::strerror(errno) + "]"));
+        if (err <= 0) {
+            return false;
+        }
+        auto name = file_name(file_path);
+        bool changed = false;
+        alignas(struct inotify_event) char buf[4096];
+        for (;;) {
+            auto len = ::read(notify_fd, buf, sizeof(buf));
+            if (len <= 0) {
+                break;
+            }
+            for (ssize_t off = 0; off < len;) {
+                auto ev = reinterpret_cast<const struct inotify_event*> (buf + off);
+                // other files of the directory are ignored
+                if (ev->wd == file_watch || 0 != (ev->mask & IN_Q_OVERFLOW) ||
+                        (ev->len > 0 && name == ev->name)) {
+                    changed = true;
+                }
+                off += static_cast<ssize_t> (sizeof(struct inotify_event) + ev->len);
+            }
+        }
+        return changed;
+    }
+#endif // STATICLIB_LINUX
+    std::this_thread::sleep_for(std::min(timeout, options.poll_interval));
+    return true;
+}
+
+uint64_t follow_reader::offset() const {
+    return position;
+}
+
+uint64_t follow_reader::reopens_count() const {
+    return reopens;
+}
+
+bool follow_reader::is_notified() const {
+#ifdef STATICLIB_LINUX
+    return -1 != notify_fd;
+#else // !STATICLIB_LINUX
+    return false;
+#endif // STATICLIB_LINUX
+}
+
+const std::string& follow_reader::path() const {
+    return file_path;
+}
+
+bool follow_reader::open_file(bool initial) {
+    std::error_code ec;
+    auto fs = std::unique_ptr<file_source>(new file_source(file_path, ec));
+    if (ec) {
+        if (std::errc::no_such_file_or_directory == ec) {
+            return false;
+        }
+        throw tinydir_exception(TRACEMSG("Error opening followed file: [" + file_path + "]," +
+                " error: [" + ec.message() + "]"));
+    }
+    opened = fs->status();
+    position = 0;
+    if (initial && options.start_at_end) {
+        position = static_cast<uint64_t> (fs->seek(0, 'e'));
+    }
+    if (src.get()) {
+        reopens += 1;
+    }
+    src = std::move(fs);
+#ifdef STATICLIB_LINUX
+    if (-1 != notify_fd) {
+        if (-1 != file_watch) {
+            ::inotify_rm_watch(notify_fd, file_watch);
+        }
+        // follows symlinks, so appends are seen when the directory watch does not cover the target
+        file_watch = ::inotify_add_watch(notify_fd, file_path.c_str(), IN_MODIFY);
+    }
+#endif // STATICLIB_LINUX
+    return true;
+}
+
+void follow_reader::close_notify() STATICLIB_NOEXCEPT {
+#ifdef STATICLIB_LINUX
+    if (-1 != notify_fd) {
+        ::close(notify_fd);
+        notify_fd = -1;
+        dir_watch = -1;
+        file_watch = -1;
+    }
+#endif // STATICLIB_LINUX
+}
+
+} // namespace
+}
@@ -0,0 +1,354 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   io_buffer_pool.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 8:50 PM
+ */
+
+#include "staticlib/tinydir/io_buffer_pool.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#ifdef STATICLIB_WINDOWS
+#include <malloc.h>
+#endif // STATICLIB_WINDOWS
+
+// destructors of thread-local objects are not supported by vs2013,
+// buffers are cached only in the shared pool there
+#if !(defined(_MSC_VER) && _MSC_VER < 1900)
+#define STATICLIB_TINYDIR_IO_BUFFER_THREAD_CACHE
+#endif
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+const size_t alignment = 4096;
+const size_t classes_count = 11;
+const std::array<size_t, classes_count> class_sizes = {{
+    1 << 12, 1 << 13, 1 << 14, 1 << 15, 1 << 16, 1 << 17,
+    1 << 18, 1 << 19, 1 << 20, 1 << 21, 1 << 22
+}};
+const size_t thread_cache_max_count = 4;
+const size_t thread_cache_max_bytes = 8 << 20;
+const size_t default_max_cached_bytes = 64 << 20;
+
+struct pool_counters {
+    std::atomic<uint64_t> acquired{0};
+    std::atomic<uint64_t> thread_cache_hits{0};
+    std::atomic<uint64_t> shared_cache_hits{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> in_use_bytes{0};
+    std::atomic<uint64_t> cached_bytes{0};
+};
+
+struct shared_pool {
+    std::mutex mtx;
+    std::array<std::vector<char*>, classes_count> free_lists;
+    size_t cached_bytes = 0;
+    size_t max_cached_bytes = default_max_cached_bytes;
+};
+
+// never destroyed, thread caches may be flushed during process exit
+pool_counters& counters() {
+    static pool_counters* co = new pool_counters();
+    return *co;
+}
+
+shared_pool& shared() {
+    static shared_pool* sp = new shared_pool();
+    return *sp;
+}
+
+size_t class_index(size_t size) {
+    for (size_t i = 0; i < classes_count; i++) {
+        if (size <= class_sizes[i]) {
+            return i;
+        }
+    }
+    return classes_count;
+}
+
+char* allocate_aligned(size_t size) {
+#ifdef STATICLIB_WINDOWS
+    auto res = static_cast<char*> (::_aligned_malloc(size, alignment));
+#else // !STATICLIB_WINDOWS
+    void* res = nullptr;
+    if (0 != ::posix_memalign(std::addressof(res), alignment, size)) {
+        res = nullptr;
+    }
+#endif // STATICLIB_WINDOWS
+    if (nullptr == res) {
+        throw std::bad_alloc();
+    }
+    counters().allocations.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<char*> (res);
+}
+
+void free_aligned(char* ptr) {
+#ifdef STATICLIB_WINDOWS
+    ::_aligned_free(ptr);
+#else // !STATICLIB_WINDOWS
+    std::free(ptr);
+#endif // STATICLIB_WINDOWS
+    counters().deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool shared_put(size_t idx, char* ptr) {
+    auto& sp = shared();
+    std::lock_guard<std::mutex> guard{sp.mtx};
+    auto size = class_sizes[idx];
+    if (sp.cached_bytes + size > sp.max_cached_bytes) {
+        return false;
+    }
+    try {
+        sp.free_lists[idx].push_back(ptr);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+    sp.cached_bytes += size;
+    return true;
+}
+
+char* shared_take(size_t idx) {
+    auto& sp = shared();
+    std::lock_guard<std::mutex> guard{sp.mtx};
+    auto& li = sp.free_lists[idx];
+    if (li.empty()) {
+        return nullptr;
+    }
+    auto res = li.back();
+    li.pop_back();
+    sp.cached_bytes -= class_sizes[idx];
+    return res;
+}
+
+void shared_free_excess(size_t max_cached_bytes) {
+    auto& sp = shared();
+    auto freed = std::vector<std::pair<char*, size_t>>();
+    {
+        std::lock_guard<std::mutex> guard{sp.mtx};
+        sp.max_cached_bytes = max_cached_bytes;
+        // larger buffers are dropped first
+        for (size_t i = classes_count; i > 0 && sp.cached_bytes > max_cached_bytes; i--) {
+            auto& li = sp.free_lists[i - 1];
+            while (!li.empty() && sp.cached_bytes > max_cached_bytes) {
+                freed.emplace_back(li.back(), class_sizes[i - 1]);
+                li.pop_back();
+                sp.cached_bytes -= class_sizes[i - 1];
+            }
+        }
+    }
+    for (auto& pa : freed) {
+        counters().cached_bytes.fetch_sub(pa.second, std::memory_order_relaxed);
+        free_aligned(pa.first);
+    }
+}
+
+// returns a buffer that cannot be kept in thread cache
+void release_to_shared(size_t idx, char* ptr) {
+    if (!shared_put(idx, ptr)) {
+        counters().cached_bytes.fetch_sub(class_sizes[idx], std::memory_order_relaxed);
+        free_aligned(ptr);
+    }
+}
+
+#ifdef STATICLIB_TINYDIR_IO_BUFFER_THREAD_CACHE
+
+class thread_cache {
+    std::array<std::array<char*, thread_cache_max_count>, classes_count> buffers;
+    std::array<size_t, classes_count> counts;
+    size_t cached_bytes = 0;
+
+public:
+    thread_cache() {
+        counts.fill(0);
+    }
+
+    ~thread_cache() STATICLIB_NOEXCEPT {
+        flush();
+    }
+
+    thread_cache(const thread_cache&) = delete;
+
+    thread_cache& operator=(const thread_cache&) = delete;
+
+    bool put(size_t idx, char* ptr) {
+        if (counts[idx] == thread_cache_max_count ||
+                cached_bytes + class_sizes[idx] > thread_cache_max_bytes) {
+            return false;
+        }
+        buffers[idx][counts[idx]] = ptr;
+        counts[idx] += 1;
+        cached_bytes += class_sizes[idx];
+        return true;
+    }
+
+    char* take(size_t idx) {
+        if (0 == counts[idx]) {
+            return nullptr;
+        }
+        counts[idx] -= 1;
+        cached_bytes -= class_sizes[idx];
+        return buffers[idx][counts[idx]];
+    }
+
+    void flush() STATICLIB_NOEXCEPT {
+        for (size_t i = 0; i < classes_count; i++) {
+            while (counts[i] > 0) {
+                counts[i] -= 1;
+                cached_bytes -= class_sizes[i];
+                release_to_shared(i, buffers[i][counts[i]]);
+            }
+        }
+    }
+};
+
+thread_cache& current_cache() {
+    thread_local thread_cache cache;
+    return cache;
+}
+
+#endif // STATICLIB_TINYDIR_IO_BUFFER_THREAD_CACHE
+
+} // namespace
+
+io_buffer::io_buffer(char* ptr, size_t len) :
+ptr(ptr),
+len(len) { }
+
+io_buffer::~io_buffer() STATICLIB_NOEXCEPT {
+    release();
+}
+
+io_buffer::io_buffer(io_buffer&& other) STATICLIB_NOEXCEPT :
+ptr(other.ptr),
+len(other.len) {
+    other.ptr = nullptr;
+    other.len = 0;
+}
+
+io_buffer& io_buffer::operator=(io_buffer&& other) STATICLIB_NOEXCEPT {
+    release();
+    ptr = other.ptr;
+    len = other.len;
+    other.ptr = nullptr;
+    other.len = 0;
+    return *this;
+}
+
+void io_buffer::release() STATICLIB_NOEXCEPT {
+    if (nullptr == ptr) return;
+    auto& co = counters();
+    co.in_use_bytes.fetch_sub(len, std::memory_order_relaxed);
+    auto idx = class_index(len);
+    if (classes_count == idx) {
+        free_aligned(ptr);
+    } else {
+        co.cached_bytes.fetch_add(len, std::memory_order_relaxed);
+#ifdef STATICLIB_TINYDIR_IO_BUFFER_THREAD_CACHE
+        if (!current_cache().put(idx, ptr)) {
+            release_to_shared(idx, ptr);
+        }
+#else // !STATICLIB_TINYDIR_IO_BUFFER_THREAD_CACHE
+        release_to_shared(idx, ptr);
+#endif // STATICLIB_TINYDIR_IO_BUFFER_THREAD_CACHE
+    }
+    ptr = nullptr;
+    len = 0;
+}
+
+io_buffer acquire_io_buffer(size_t min_size) {
+    auto& co = counters();
+    co.acquired.fetch_add(1, std::memory_order_relaxed);
+    auto idx = class_index(min_size);
+    if (classes_count == idx) {
+        auto size = (min_size + alignment - 1) / alignment * alignment;
+        auto res = io_buffer(allocate_aligned(size), size);
+        co.in_use_bytes.fetch_add(size, std::memory_order_relaxed);
+        return res;
+    }
+    auto size = class_sizes[idx];
+    char* ptr = nullptr;
+#ifdef STATICLIB_TINYDIR_IO_BUFFER_THREAD_CACHE
+    ptr = current_cache().take(idx);
+    if (nullptr != ptr) {
+        co.thread_cache_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+#endif // STATICLIB_TINYDIR_IO_BUFFER_THREAD_CACHE
+    if (nullptr == ptr) {
+        ptr = shared_take(idx);
+        if (nullptr != ptr) {
+            co.shared_cache_hits.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (nullptr != ptr) {
+        co.cached_bytes.fetch_sub(size, std::memory_order_relaxed);
+    } else {
+        ptr = allocate_aligned(size);
+    }
+    co.in_use_bytes.fetch_add(size, std::memory_order_relaxed);
+    return io_buffer(ptr, size);
+}
+
+io_buffer_pool_stats io_buffer_pool_snapshot() {
+    auto& co = counters();
+    auto res = io_buffer_pool_stats();
+    res.acquired = co.acquired.load(std::memory_order_relaxed);
+    res.thread_cache_hits = co.thread_cache_hits.load(std::memory_order_relaxed);
+    res.shared_cache_hits = co.shared_cache_hits.load(std::memory_order_relaxed);
+    res.allocations = co.allocations.load(std::memory_order_relaxed);
+    res.deallocations = co.deallocations.load(std::memory_order_relaxed);
+    res.in_use_bytes = co.in_use_bytes.load(std::memory_order_relaxed);
+    res.cached_bytes = co.cached_bytes.load(std::memory_order_relaxed);
+    return res;
+}
+
+void io_buffer_pool_set_limit(size_t max_cached_bytes) {
+    shared_free_excess(max_cached_bytes);
+}
+
+void io_buffer_pool_trim() {
+    size_t limit = 0;
+    {
+        auto& sp = shared();
+        std::lock_guard<std::mutex> guard{sp.mtx};
+        limit = sp.max_cached_bytes;
+        sp.max_cached_bytes = 0;
+    }
+#ifdef STATICLIB_TINYDIR_IO_BUFFER_THREAD_CACHE
+    // limit is zero, so the buffers are freed
+    current_cache().flush();
+#endif // STATICLIB_TINYDIR_IO_BUFFER_THREAD_CACHE
+    shared_free_excess(0);
+    std::lock_guard<std::mutex> guard{shared().mtx};
+    shared().max_cached_bytes = limit;
+}
+
+} // namespace
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   io_probe.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:20 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_IO_PROBE_HPP
+#define STATICLIB_TINYDIR_IO_PROBE_HPP
+
+#include "staticlib/tinydir/io_stats.hpp"
+
+#ifdef STATICLIB_TINYDIR_ENABLE_IO_STATS
+
+#include <cerrno>
+#include <chrono>
+#include <string>
+#include <utility>
+
+#include "staticlib/config.hpp"
+
+#ifdef STATICLIB_WINDOWS
+#include "staticlib/support/windows.hpp"
+#endif // STATICLIB_WINDOWS
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Records a single call into the counters of the current thread
+ */
+void io_stats_record(io_op op, const std::string& path, uint64_t bytes, uint64_t duration_ns, bool failed);
+
+/**
+ * Measures the duration of a single call, nothing is recorded
+ * if "finish" is not called. Error code of the measured call
+ * is preserved, so "finish" can be called before reporting the error.
+ * Path passed as a temporary is kept by the probe, so callers can
+ * build it inside the macro and pay for it only when stats are enabled.
+ */
+class io_probe {
+    io_op op;
+    std::string owned_path;
+    const std::string& path;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    io_probe(io_op op, const std::string& path) :
+    op(op),
+    path(path),
+    start(std::chrono::steady_clock::now()) { }
+
+    io_probe(io_op op, std::string&& path) :
+    op(op),
+    owned_path(std::move(path)),
+    path(owned_path),
+    start(std::chrono::steady_clock::now()) { }
+
+    io_probe(const io_probe&) = delete;
+
+    io_probe& operator=(const io_probe&) = delete;
+
+    void finish(uint64_t bytes, bool failed) {
+        auto dur = std::chrono::steady_clock::now() - start;
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count();
+        auto saved_errno = errno;
+#ifdef STATICLIB_WINDOWS
+        auto saved_error = ::GetLastError();
+#endif // STATICLIB_WINDOWS
+        io_stats_record(op, path, bytes, static_cast<uint64_t> (ns), failed);
+#ifdef STATICLIB_WINDOWS
+        ::SetLastError(saved_error);
+#endif // STATICLIB_WINDOWS
+        errno = saved_errno;
+    }
+};
+
+} // namespace
+}
+
+#define STATICLIB_TINYDIR_IO_BEGIN(probe, op_name, path) \
+    sl::tinydir::io_probe probe(sl::tinydir::io_op::op_name, path)
+#define STATICLIB_TINYDIR_IO_END(probe, bytes, failed) \
+    probe.finish(static_cast<uint64_t> (bytes), failed)
+
+#else // !STATICLIB_TINYDIR_ENABLE_IO_STATS
+
+#define STATICLIB_TINYDIR_IO_BEGIN(probe, op_name, path) ((void) 0)
+#define STATICLIB_TINYDIR_IO_END(probe, bytes, failed) ((void) 0)
+
+#endif // STATICLIB_TINYDIR_ENABLE_IO_STATS
+
+#endif /* STATICLIB_TINYDIR_IO_PROBE_HPP */
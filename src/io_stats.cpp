@@ -0,0 +1,289 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   io_stats.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:31 PM
+ */
+
+#include "staticlib/tinydir/io_stats.hpp"
+
+#include "io_probe.hpp"
+
+#ifdef STATICLIB_TINYDIR_ENABLE_IO_STATS
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#endif // STATICLIB_TINYDIR_ENABLE_IO_STATS
+
+#include "staticlib/config.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+#ifdef STATICLIB_TINYDIR_ENABLE_IO_STATS
+
+namespace { // anonymous
+
+const size_t ops_count = static_cast<size_t> (io_op::count);
+
+// written only by the owner thread, read by snapshots
+struct atomic_op_stats {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> errors;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> total_ns;
+    std::array<std::atomic<uint64_t>, io_latency_buckets_count> latency_histogram;
+
+    atomic_op_stats() {
+        reset();
+    }
+
+    void reset() {
+        calls.store(0, std::memory_order_relaxed);
+        errors.store(0, std::memory_order_relaxed);
+        bytes.store(0, std::memory_order_relaxed);
+        total_ns.store(0, std::memory_order_relaxed);
+        for (auto& bu : latency_histogram) {
+            bu.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void add_to(atomic_op_stats& dest) const {
+        dest.calls.fetch_add(calls.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        dest.errors.fetch_add(errors.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        dest.bytes.fetch_add(bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        dest.total_ns.fetch_add(total_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        for (size_t i = 0; i < io_latency_buckets_count; i++) {
+            dest.latency_histogram[i].fetch_add(latency_histogram[i].load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+        }
+    }
+
+    void add_to(io_op_stats& dest) const {
+        dest.calls += calls.load(std::memory_order_relaxed);
+        dest.errors += errors.load(std::memory_order_relaxed);
+        dest.bytes += bytes.load(std::memory_order_relaxed);
+        dest.total_ns += total_ns.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < io_latency_buckets_count; i++) {
+            dest.latency_histogram[i] += latency_histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+};
+
+struct thread_stats {
+    std::array<atomic_op_stats, ops_count> ops;
+};
+
+typedef std::function<void(const io_trace_event&)> callback_type;
+
+// guards the list of live threads, retired counters and callback updates
+std::mutex& registry_mutex() {
+    static std::mutex mtx;
+    return mtx;
+}
+
+std::vector<thread_stats*>& registry() {
+    static std::vector<thread_stats*> vec;
+    return vec;
+}
+
+// counters of finished threads are folded here to preserve process-wide totals
+thread_stats& retired() {
+    static thread_stats st;
+    return st;
+}
+
+std::atomic<bool>& callback_set() {
+    static std::atomic<bool> flag{false};
+    return flag;
+}
+
+// accessed only with "std::atomic_load" and "std::atomic_store"
+std::shared_ptr<callback_type>& callback() {
+    static std::shared_ptr<callback_type> cb;
+    return cb;
+}
+
+// registers counters on first call in a thread, retires them on thread exit
+class thread_slot {
+    thread_stats* st = nullptr;
+
+public:
+    thread_slot() { }
+
+    ~thread_slot() STATICLIB_NOEXCEPT {
+        if (nullptr == st) return;
+        std::lock_guard<std::mutex> guard{registry_mutex()};
+        auto& ret = retired();
+        for (size_t i = 0; i < ops_count; i++) {
+            st->ops[i].add_to(ret.ops[i]);
+        }
+        auto& vec = registry();
+        for (size_t i = 0; i < vec.size(); i++) {
+            if (st == vec[i]) {
+                vec[i] = vec.back();
+                vec.pop_back();
+                break;
+            }
+        }
+        delete st;
+    }
+
+    thread_slot(const thread_slot&) = delete;
+
+    thread_slot& operator=(const thread_slot&) = delete;
+
+    thread_stats& get() {
+        if (nullptr == st) {
+            std::unique_ptr<thread_stats> created{new thread_stats()};
+            std::lock_guard<std::mutex> guard{registry_mutex()};
+            registry().push_back(created.get());
+            st = created.release();
+        }
+        return *st;
+    }
+};
+
+thread_stats& current_thread_stats() {
+    thread_local thread_slot slot;
+    return slot.get();
+}
+
+size_t bucket_idx(uint64_t ns) {
+    size_t res = 0;
+    while (ns > 1 && res < io_latency_buckets_count - 1) {
+        ns >>= 1;
+        res += 1;
+    }
+    return res;
+}
+
+} // namespace
+
+void io_stats_record(io_op op, const std::string& path, uint64_t bytes, uint64_t duration_ns, bool failed) {
+    auto& st = current_thread_stats().ops[static_cast<size_t> (op)];
+    st.calls.fetch_add(1, std::memory_order_relaxed);
+    if (failed) {
+        st.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+    st.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    st.total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+    st.latency_histogram[bucket_idx(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+    if (callback_set().load(std::memory_order_acquire)) {
+        auto cb = std::atomic_load(std::addressof(callback()));
+        if (cb) {
+            io_trace_event ev = {op, path, bytes, duration_ns, failed};
+            (*cb)(ev);
+        }
+    }
+}
+
+bool io_stats_enabled() {
+    return true;
+}
+
+io_stats io_stats_snapshot() {
+    auto res = io_stats();
+    std::lock_guard<std::mutex> guard{registry_mutex()};
+    for (size_t i = 0; i < ops_count; i++) {
+        retired().ops[i].add_to(res.ops[i]);
+    }
+    for (auto th : registry()) {
+        for (size_t i = 0; i < ops_count; i++) {
+            th->ops[i].add_to(res.ops[i]);
+        }
+    }
+    return res;
+}
+
+io_stats io_stats_thread_snapshot() {
+    auto res = io_stats();
+    auto& th = current_thread_stats();
+    for (size_t i = 0; i < ops_count; i++) {
+        th.ops[i].add_to(res.ops[i]);
+    }
+    return res;
+}
+
+void io_stats_reset() {
+    std::lock_guard<std::mutex> guard{registry_mutex()};
+    for (auto& op : retired().ops) {
+        op.reset();
+    }
+    for (auto th : registry()) {
+        for (auto& op : th->ops) {
+            op.reset();
+        }
+    }
+}
+
+void io_stats_set_trace_callback(std::function<void(const io_trace_event&)> cb) {
+    auto empty = !cb;
+    auto ptr = empty ? std::shared_ptr<callback_type>() : std::make_shared<callback_type>(std::move(cb));
+    std::lock_guard<std::mutex> guard{registry_mutex()};
+    std::atomic_store(std::addressof(callback()), std::move(ptr));
+    callback_set().store(!empty, std::memory_order_release);
+}
+
+#else // !STATICLIB_TINYDIR_ENABLE_IO_STATS
+
+bool io_stats_enabled() {
+    return false;
+}
+
+io_stats io_stats_snapshot() {
+    return io_stats();
+}
+
+io_stats io_stats_thread_snapshot() {
+    return io_stats();
+}
+
+void io_stats_reset() { }
+
+void io_stats_set_trace_callback(std::function<void(const io_trace_event&)>) { }
+
+#endif // STATICLIB_TINYDIR_ENABLE_IO_STATS
+
+const char* io_op_name(io_op op) {
+    switch (op) {
+    case io_op::open: return "open";
+    case io_op::close: return "close";
+    case io_op::read: return "read";
+    case io_op::write: return "write";
+    case io_op::seek: return "seek";
+    case io_op::stat: return "stat";
+    case io_op::read_directory: return "read_directory";
+    case io_op::create_directory: return "create_directory";
+    case io_op::rename: return "rename";
+    case io_op::remove: return "remove";
+    case io_op::copy: return "copy";
+    case io_op::symlink: return "symlink";
+    case io_op::resize: return "resize";
+    case io_op::full_path: return "full_path";
+    case io_op::set_times: return "set_times";
+    case io_op::sync: return "sync";
+    case io_op::link: return "link";
+    default: return "unknown";
+    }
+}
+
+} // namespace
+}
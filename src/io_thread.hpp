@@ -0,0 +1,158 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   io_thread.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 5:40 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_IO_THREAD_HPP
+#define STATICLIB_TINYDIR_IO_THREAD_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "staticlib/config.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Private long-lived background thread that runs one IO job at a time,
+ * used by direct sink and source for their double buffering, so no
+ * thread is started per buffer. Instance is owned through a pointer,
+ * so it stays in place when its owner is moved.
+ */
+class io_thread {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::function<size_t()> job;
+    bool submitted = false;
+    bool finished = false;
+    size_t result = 0;
+    std::exception_ptr error;
+    bool stopping = false;
+    // must be the last member, started after all other are initialized
+    std::thread thread;
+
+public:
+    io_thread() :
+    thread([this] { run(); }) { }
+
+    /**
+     * Destructor, waits for the submitted job and joins the thread
+     */
+    ~io_thread() STATICLIB_NOEXCEPT {
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            stopping = true;
+        }
+        cv.notify_all();
+        thread.join();
+    }
+
+    io_thread(const io_thread&) = delete;
+
+    io_thread& operator=(const io_thread&) = delete;
+
+    /**
+     * Starts the job, previous job must be waited for
+     *
+     * @param task job returning the number of bytes processed
+     */
+    void submit(std::function<size_t()> task) {
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            job = std::move(task);
+            submitted = true;
+            finished = false;
+            result = 0;
+            error = nullptr;
+        }
+        cv.notify_all();
+    }
+
+    /**
+     * Whether a job was submitted and is not waited for yet
+     *
+     * @return true if there is a job to wait for
+     */
+    bool pending() {
+        std::lock_guard<std::mutex> guard{mtx};
+        return submitted;
+    }
+
+    /**
+     * Waits for the submitted job
+     *
+     * @return job result
+     * @throws exception thrown by the job
+     */
+    size_t wait() {
+        std::unique_lock<std::mutex> lock{mtx};
+        cv.wait(lock, [this] {
+            return finished;
+        });
+        submitted = false;
+        finished = false;
+        if (nullptr != error) {
+            auto err = error;
+            error = nullptr;
+            std::rethrow_exception(err);
+        }
+        return result;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock{mtx};
+        for (;;) {
+            cv.wait(lock, [this] {
+                return stopping || (submitted && !finished && job);
+            });
+            if (submitted && !finished && job) {
+                auto task = std::move(job);
+                job = nullptr;
+                lock.unlock();
+                size_t res = 0;
+                std::exception_ptr err;
+                try {
+                    res = task();
+                } catch (...) {
+                    err = std::current_exception();
+                }
+                lock.lock();
+                result = res;
+                error = err;
+                finished = true;
+                cv.notify_all();
+            } else {
+                return;
+            }
+        }
+    }
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_IO_THREAD_HPP */
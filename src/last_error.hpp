@@ -0,0 +1,55 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   last_error.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 5:10 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_LAST_ERROR_HPP
+#define STATICLIB_TINYDIR_LAST_ERROR_HPP
+
+#include <cerrno>
+#include <system_error>
+
+#include "staticlib/config.hpp"
+
+#ifdef STATICLIB_WINDOWS
+#include "staticlib/support/windows.hpp"
+#endif // STATICLIB_WINDOWS
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Captures the error of the last failed system call
+ *
+ * @return "GetLastError" value on windows, "errno" value otherwise
+ */
+inline std::error_code last_error_code() {
+#ifdef STATICLIB_WINDOWS
+    return std::error_code(static_cast<int> (::GetLastError()), std::system_category());
+#else // !STATICLIB_WINDOWS
+    return std::error_code(errno, std::generic_category());
+#endif // STATICLIB_WINDOWS
+}
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_LAST_ERROR_HPP */
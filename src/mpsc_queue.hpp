@@ -0,0 +1,144 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   mpsc_queue.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 2:40 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_MPSC_QUEUE_HPP
+#define STATICLIB_TINYDIR_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "staticlib/config.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Private bounded lock-free queue for multiple producers and a single
+ * consumer, ring of cells with sequence numbers (D. Vyukov's scheme).
+ * Producers reserve cells with CAS, consumer does not use atomic RMW.
+ * Element type must be default-constructible and movable.
+ */
+template<typename T>
+class mpsc_queue {
+    struct cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    // head and tail are kept on separate cache lines
+    static const size_t cache_line_size = 64;
+
+    std::unique_ptr<cell[]> cells;
+    size_t mask;
+    char pad1[cache_line_size];
+    std::atomic<size_t> enqueue_pos;
+    char pad2[cache_line_size];
+    size_t dequeue_pos = 0;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param capacity minimal capacity, rounded up to a power of two
+     */
+    explicit mpsc_queue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        cells = std::unique_ptr<cell[]>(new cell[size]);
+        for (size_t i = 0; i < size; i++) {
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        mask = size - 1;
+        enqueue_pos.store(0, std::memory_order_relaxed);
+    }
+
+    mpsc_queue(const mpsc_queue&) = delete;
+
+    mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+    /**
+     * Adds the value to the queue, may be called from any thread
+     *
+     * @param value value to move into the queue, left untouched if the queue is full
+     * @return false if the queue is full
+     */
+    bool try_push(T& value) {
+        auto pos = enqueue_pos.load(std::memory_order_relaxed);
+        cell* ce = nullptr;
+        for (;;) {
+            ce = std::addressof(cells[pos & mask]);
+            auto seq = ce->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t> (seq) - static_cast<intptr_t> (pos);
+            if (0 == diff) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        ce->value = std::move(value);
+        ce->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Takes the oldest value from the queue, must be called only
+     * from the consumer thread
+     *
+     * @param value destination value
+     * @return false if the queue is empty or the oldest push is not completed yet
+     */
+    bool try_pop(T& value) {
+        auto& ce = cells[dequeue_pos & mask];
+        auto seq = ce.seq.load(std::memory_order_acquire);
+        if (seq != dequeue_pos + 1) {
+            return false;
+        }
+        value = std::move(ce.value);
+        ce.seq.store(dequeue_pos + mask + 1, std::memory_order_release);
+        dequeue_pos += 1;
+        return true;
+    }
+
+    /**
+     * Whether the queue is empty, exact only on the consumer thread
+     *
+     * @return true if there is nothing to pop
+     */
+    bool empty() const {
+        return enqueue_pos.load(std::memory_order_acquire) == dequeue_pos;
+    }
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_MPSC_QUEUE_HPP */
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   native_stat.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:05 PM
+ */
+
+#ifndef STATICLIB_TINYDIR_NATIVE_STAT_HPP
+#define STATICLIB_TINYDIR_NATIVE_STAT_HPP
+
+#include "staticlib/config.hpp"
+
+#ifdef STATICLIB_WINDOWS
+
+#include "staticlib/support/windows.hpp"
+
+#include "staticlib/tinydir/file_status.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Converts the result of "GetFileInformationByHandle" call into a public metadata struct
+ *
+ * @param info "GetFileInformationByHandle" call result
+ * @param follow whether the handle was opened following reparse points
+ * @return metadata of the entry
+ */
+file_status status_from_native(const BY_HANDLE_FILE_INFORMATION& info, bool follow);
+
+} // namespace
+}
+
+#else // !STATICLIB_WINDOWS
+
+#include <sys/stat.h>
+
+#include "staticlib/tinydir/file_status.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+typedef struct stat native_stat;
+#else
+typedef struct stat64 native_stat;
+#endif // STATICLIB_MAC || STATICLIB_IOS
+
+/**
+ * Converts the result of "stat" call into a public metadata struct
+ *
+ * @param st "stat" call result
+ * @return metadata of the entry
+ */
+file_status status_from_native(const native_stat& st);
+
+#if !(defined(STATICLIB_MAC) || defined(STATICLIB_IOS))
+/**
+ * Converts the result of plain "stat" call (as stored by tinydir
+ * for directory entries) into a public metadata struct
+ *
+ * @param st "stat" call result
+ * @return metadata of the entry
+ */
+file_status status_from_native(const struct stat& st);
+#endif // !(STATICLIB_MAC || STATICLIB_IOS)
+
+} // namespace
+}
+
+#endif // STATICLIB_WINDOWS
+
+#endif /* STATICLIB_TINYDIR_NATIVE_STAT_HPP */
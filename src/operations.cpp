@@ -38,16 +38,22 @@ typedef BOOLEAN(*CreateSymbolicLinkW_type)(LPCWSTR lpSymlinkFileName, LPCWSTR lp
 
 #include "tinydir.h"
 
+#include "staticlib/tinydir/file_status.hpp"
+
 #include "staticlib/config.hpp"
 #include "staticlib/support.hpp"
 #include "staticlib/utils.hpp"
 
+#include "io_probe.hpp"
+#include "last_error.hpp"
+
 namespace staticlib {
 namespace tinydir {
 
 std::vector<path> list_directory(const std::string& dirpath) {
     tinydir_dir dir;
     std::string errstr;
+    STATICLIB_TINYDIR_IO_BEGIN(probe, read_directory, dirpath);
 #ifdef STATICLIB_WINDOWS
     auto err_open = tinydir_open(std::addressof(dir), sl::utils::widen(dirpath).c_str());
     if (err_open) {
@@ -59,8 +65,11 @@ std::vector<path> list_directory(const std::string& dirpath) {
         errstr = ::strerror(errno);
     }
 #endif    
-    if (err_open) throw tinydir_exception(TRACEMSG("Error opening directory," +
-            " path: [" + dirpath + "], error: [" + errstr + "]"));
+    if (err_open) {
+        STATICLIB_TINYDIR_IO_END(probe, 0, true);
+        throw tinydir_exception(TRACEMSG("Error opening directory," +
+                " path: [" + dirpath + "], error: [" + errstr + "]"));
+    }
     auto deferred = sl::support::defer([&dir]() STATICLIB_NOEXCEPT {
         tinydir_close(std::addressof(dir));
     });
@@ -75,8 +84,12 @@ std::vector<path> list_directory(const std::string& dirpath) {
             }
         }
         auto err_next = tinydir_next(std::addressof(dir));
-        if (err_next) throw tinydir_exception(TRACEMSG("Error iterating directory, path: [" + dirpath + "]"));
+        if (err_next) {
+            STATICLIB_TINYDIR_IO_END(probe, 0, true);
+            throw tinydir_exception(TRACEMSG("Error iterating directory, path: [" + dirpath + "]"));
+        }
     }
+    STATICLIB_TINYDIR_IO_END(probe, 0, false);
     std::sort(res.begin(), res.end(), [](const path& a, const path& b) {
         if (a.is_directory() && !b.is_directory()) {
             return true;
@@ -89,25 +102,84 @@ std::vector<path> list_directory(const std::string& dirpath) {
 }
 
 void create_directory(const std::string& dirpath) {
+    std::error_code ec;
+    create_directory(dirpath, ec);
+    if (ec) throw tinydir_exception(TRACEMSG(
+            "Error creating directory, path: [" + dirpath + "],"
+            " error: [" + ec.message() + "]"));
+}
+
+void create_directory(const std::string& dirpath, std::error_code& ec) {
     bool success = false;
-    std::string error;
+    STATICLIB_TINYDIR_IO_BEGIN(probe, create_directory, dirpath);
 #ifdef STATICLIB_WINDOWS
     auto wpath = sl::utils::widen(dirpath);
     auto res = ::CreateDirectoryW(wpath.c_str(), nullptr);
     success = 0 != res;
-    if (!success) {
-        error = sl::utils::errcode_to_string(::GetLastError());
-    }
 #else // !STATICLIB_WINDOWS
     auto res = ::mkdir(dirpath.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
     success = 0 == res;
-    if (!success) {
-        error = ::strerror(errno);
+#endif // STATICLIB_WINDOWS
+    STATICLIB_TINYDIR_IO_END(probe, 0, !success);
+    if (success) {
+        ec.clear();
+    } else {
+        ec = last_error_code();
+    }
+}
+
+void create_directories(const std::string& dirpath) {
+    std::error_code ec;
+    create_directories(dirpath, ec);
+    if (ec) throw tinydir_exception(TRACEMSG(
+            "Error creating directories, path: [" + dirpath + "],"
+            " error: [" + ec.message() + "]"));
+}
+
+void create_directories(const std::string& dirpath, std::error_code& ec) {
+    auto norm = normalize_path(dirpath);
+    // probe from the leaf upward, most calls find the parent existing
+    auto missing = std::vector<size_t>();
+    auto end = norm.length();
+    for (;;) {
+        create_directory(norm.substr(0, end), ec);
+        if (!ec) {
+            break;
+        }
+        if (std::errc::file_exists == ec) {
+            if (norm.length() == end) {
+                std::error_code st_ec;
+                auto st = status(norm, st_ec);
+                if (st_ec) {
+                    ec = st_ec;
+                    return;
+                }
+                if (file_type::directory != st.type) {
+                    return;
+                }
+            }
+            ec.clear();
+            break;
+        }
+        if (std::errc::no_such_file_or_directory != ec) {
+            return;
+        }
+        missing.push_back(end);
+        auto pos = norm.rfind('/', end - 1);
+        if (std::string::npos == pos || 0 == pos) {
+            return;
+        }
+        end = pos;
+    }
+    // create the missing suffix, concurrent creators are fine
+    while (!missing.empty()) {
+        create_directory(norm.substr(0, missing.back()), ec);
+        if (ec && std::errc::file_exists != ec) {
+            return;
+        }
+        ec.clear();
+        missing.pop_back();
     }
-#endif // STATICLIB_WINDOWS    
-    if (!success) throw tinydir_exception(TRACEMSG(
-            "Error creating directory, path: [" + dirpath + "],"
-            " error: [" + error + "]"));
 }
 
 std::string normalize_path(const std::string& path) {
@@ -124,12 +196,25 @@ std::string normalize_path(const std::string& path) {
 }
 
 std::string full_path(const std::string& fpath) {
+    std::error_code ec;
+    auto res = full_path(fpath, ec);
+    if (ec) throw tinydir_exception(TRACEMSG(
+            "Error determining full path, path: [" + fpath + "],"
+            " error: [" + ec.message() + "]"));
+    return res;
+}
+
+std::string full_path(const std::string& fpath, std::error_code& ec) {
 #ifdef STATICLIB_WINDOWS
     auto wpath = sl::utils::widen(fpath);
+    STATICLIB_TINYDIR_IO_BEGIN(probe, full_path, fpath);
     auto wabs = ::_wfullpath(nullptr, wpath.c_str(), _MAX_PATH);
-    if (nullptr == wabs) throw tinydir_exception(TRACEMSG(
-            "Error determining full path, path: [" + fpath + "],"
-            " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+    STATICLIB_TINYDIR_IO_END(probe, 0, nullptr == wabs);
+    if (nullptr == wabs) {
+        ec = last_error_code();
+        return std::string();
+    }
+    ec.clear();
     auto deferred = sl::support::defer([wabs] () STATICLIB_NOEXCEPT {
         std::free(wabs);
     });
@@ -138,10 +223,14 @@ std::string full_path(const std::string& fpath) {
     sl::utils::replace_all(res, "\\", "/");
     return res;
 #else // !STATICLIB_WINDOWS
+    STATICLIB_TINYDIR_IO_BEGIN(probe, full_path, fpath);
     auto abs = ::realpath(fpath.c_str(), nullptr);
-    if (nullptr == abs) throw tinydir_exception(TRACEMSG(
-            "Error determining full path, path: [" + fpath + "],"
-            " error: [" + ::strerror(errno) + "]"));
+    STATICLIB_TINYDIR_IO_END(probe, 0, nullptr == abs);
+    if (nullptr == abs) {
+        ec = last_error_code();
+        return std::string();
+    }
+    ec.clear();
     auto deferred = sl::support::defer([abs] () STATICLIB_NOEXCEPT {
         std::free(abs);
     });
@@ -158,7 +247,9 @@ void create_symlink(const std::string& dest, const std::string& spath) {
     if (path(dest).is_directory()) {
         flags |= 0x1; // SYMBOLIC_LINK_FLAG_DIRECTORY
     }
+    STATICLIB_TINYDIR_IO_BEGIN(probe, symlink, spath);
     auto res = ::CreateSymbolicLinkW(wspath.c_str(), wdest.c_str(), flags);
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 == res);
     if (0 == res) throw tinydir_exception(TRACEMSG(
         "Error creating symbolic link, dest: [" + dest + "], link: [" + spath + "]" +
         " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
@@ -168,12 +259,34 @@ void create_symlink(const std::string& dest, const std::string& spath) {
     throw tinydir_exception(TRACEMSG("Symbolic links are not supported in 32-bit mode"));
 #endif
 #else // !STATICLIB_WINDOWS
+    STATICLIB_TINYDIR_IO_BEGIN(probe, symlink, spath);
     auto res = ::symlink(dest.c_str(), spath.c_str());
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != res);
     if (0 != res) throw tinydir_exception(TRACEMSG(
         "Error creating symbolic link, dest: [" + dest + "], link: [" + spath + "]" +
         " error: [" + ::strerror(errno) + "]"));
 #endif // STATICLIB_WINDOWS
 }
 
+void create_hardlink(const std::string& dest, const std::string& lpath) {
+#ifdef STATICLIB_WINDOWS
+    auto wdest = sl::utils::widen(dest);
+    auto wlpath = sl::utils::widen(lpath);
+    STATICLIB_TINYDIR_IO_BEGIN(probe, link, lpath);
+    auto res = ::CreateHardLinkW(wlpath.c_str(), wdest.c_str(), nullptr);
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 == res);
+    if (0 == res) throw tinydir_exception(TRACEMSG(
+        "Error creating hard link, dest: [" + dest + "], link: [" + lpath + "]" +
+        " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+#else // !STATICLIB_WINDOWS
+    STATICLIB_TINYDIR_IO_BEGIN(probe, link, lpath);
+    auto res = ::link(dest.c_str(), lpath.c_str());
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != res);
+    if (0 != res) throw tinydir_exception(TRACEMSG(
+        "Error creating hard link, dest: [" + dest + "], link: [" + lpath + "]" +
+        " error: [" + ::strerror(errno) + "]"));
+#endif // STATICLIB_WINDOWS
+}
+
 } // namespace
 }
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   parallel_copy.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:00 PM
+ */
+
+#include "staticlib/tinydir/parallel_copy.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifndef STATICLIB_WINDOWS
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif // !STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "staticlib/tinydir/file_status.hpp"
+#include "staticlib/tinydir/operations.hpp"
+
+#include "file_copy.hpp"
+#include "io_probe.hpp"
+#include "last_error.hpp"
+#include "native_stat.hpp"
+#include "task_pool.hpp"
+#include "temp_sibling.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+// granularity of progress reports
+const uint64_t progress_step = 16 << 20;
+
+#ifndef STATICLIB_WINDOWS
+
+void copy_ranges(int source, int dest, const std::string& from, uint64_t size,
+        const parallel_copy_options& options) {
+    auto chunk_size = std::max(options.chunk_size, static_cast<uint64_t> (1));
+    auto ranges = std::vector<file_chunk>();
+    for (uint64_t off = 0; off < size; off += chunk_size) {
+        ranges.emplace_back(ranges.size(), off, std::min(chunk_size, size - off));
+    }
+    if (ranges.empty()) {
+        return;
+    }
+    auto threads_count = 0 != options.threads_count ? options.threads_count :
+            task_pool::default_threads_count();
+    std::mutex progress_mtx;
+    task_pool pool(std::min(threads_count, ranges.size()));
+    for (auto& ra : ranges) {
+        pool.submit([source, dest, &from, &options, &progress_mtx, &ra] {
+            uint64_t done = 0;
+            while (done < ra.length) {
+                auto step = std::min(progress_step, ra.length - done);
+                uint64_t copied = 0;
+                STATICLIB_TINYDIR_IO_BEGIN(probe, copy, from);
+                auto ec = copy_fd_range(source, dest, ra.offset + done, step, copied);
+                STATICLIB_TINYDIR_IO_END(probe, copied, static_cast<bool> (ec));
+                if (ec) throw tinydir_exception(TRACEMSG("Error copying file range: [" + from + "]," +
+                        " offset: [" + sl::support::to_string(ra.offset + done) + "]," +
+                        " error: [" + ec.message() + "]"));
+                if (copied < step) throw tinydir_exception(TRACEMSG(
+                        "Source file was truncated during copy: [" + from + "]," +
+                        " offset: [" + sl::support::to_string(ra.offset + done + copied) + "]"));
+                done += copied;
+                if (options.on_progress) {
+                    std::lock_guard<std::mutex> guard{progress_mtx};
+                    options.on_progress(ra, done);
+                }
+            }
+        });
+    }
+    pool.wait();
+}
+
+void copy_into(const std::string& from, const std::string& tmp, const parallel_copy_options& options) {
+    STATICLIB_TINYDIR_IO_BEGIN(src_probe, open, from);
+    int source = ::open(from.c_str(), O_RDONLY, 0);
+    STATICLIB_TINYDIR_IO_END(src_probe, 0, -1 == source);
+    if (-1 == source) throw tinydir_exception(TRACEMSG("Error opening src file: [" + from + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    auto deferred_src = sl::support::defer([source]() STATICLIB_NOEXCEPT {
+        ::close(source);
+    });
+    native_stat st;
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    auto err_stat = ::fstat(source, std::addressof(st));
+#else
+    auto err_stat = ::fstat64(source, std::addressof(st));
+#endif // STATICLIB_MAC || STATICLIB_IOS
+    if (-1 == err_stat) throw tinydir_exception(TRACEMSG("Error obtaining file status: [" + from + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    if (!S_ISREG(st.st_mode)) throw tinydir_exception(TRACEMSG(
+            "Cannot copy non-regular file: [" + from + "]"));
+    auto size = static_cast<uint64_t> (st.st_size);
+
+    STATICLIB_TINYDIR_IO_BEGIN(dest_probe, open, tmp);
+    int dest = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_EXCL, st.st_mode & 0777);
+    STATICLIB_TINYDIR_IO_END(dest_probe, 0, -1 == dest);
+    if (-1 == dest) throw tinydir_exception(TRACEMSG("Error opening dest file: [" + tmp + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    bool closed = false;
+    auto deferred_dest = sl::support::defer([dest, &closed]() STATICLIB_NOEXCEPT {
+        if (!closed) {
+            ::close(dest);
+        }
+    });
+
+    STATICLIB_TINYDIR_IO_BEGIN(resize_probe, resize, tmp);
+    auto ec = preallocate_fd(dest, size);
+    STATICLIB_TINYDIR_IO_END(resize_probe, 0, static_cast<bool> (ec));
+    if (ec) throw tinydir_exception(TRACEMSG("Error allocating file: [" + tmp + "]," +
+            " size: [" + sl::support::to_string(size) + "]," +
+            " error: [" + ec.message() + "]"));
+
+    copy_ranges(source, dest, from, size, options);
+
+    // data must be on disk before the rename makes it visible
+    STATICLIB_TINYDIR_IO_BEGIN(sync_probe, sync, tmp);
+    auto err_sync = ::fsync(dest);
+    STATICLIB_TINYDIR_IO_END(sync_probe, 0, -1 == err_sync);
+    if (-1 == err_sync) throw tinydir_exception(TRACEMSG("Error flushing file: [" + tmp + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    closed = true;
+    STATICLIB_TINYDIR_IO_BEGIN(close_probe, close, tmp);
+    auto err_close = ::close(dest);
+    STATICLIB_TINYDIR_IO_END(close_probe, 0, -1 == err_close);
+    if (-1 == err_close) throw tinydir_exception(TRACEMSG("Error closing file: [" + tmp + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+}
+
+#else // STATICLIB_WINDOWS
+
+void copy_into(const std::string& from, const std::string& tmp, const parallel_copy_options& options) {
+    const char* failed_op = nullptr;
+    auto ec = copy_regular_file(from, tmp, false, failed_op);
+    if (ec) throw tinydir_exception(TRACEMSG(std::string(failed_op) + ": [" + from + "]," +
+            " to: [" + tmp + "]," +
+            " error: [" + ec.message() + "]"));
+    auto size = symlink_status(tmp).size;
+    if (options.on_progress && size > 0) {
+        options.on_progress(file_chunk(0, 0, size), size);
+    }
+}
+
+#endif // !STATICLIB_WINDOWS
+
+} // namespace
+
+path parallel_copy_file(const std::string& from, const std::string& to, const parallel_copy_options& options) {
+    temp_sibling sibling(to, "tinydir_copy");
+    auto& tmp = sibling.path();
+    copy_into(from, tmp, options);
+    std::error_code ec;
+    path(tmp).rename(to, ec);
+    if (ec) throw tinydir_exception(TRACEMSG("Cannot rename file: [" + tmp + "]," +
+            " to: [" + to + "]," +
+            " error: [" + ec.message() + "]"));
+    return path(to);
+}
+
+} // namespace
+}
@@ -22,6 +22,9 @@
  */
 
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
 
 #include "staticlib/io.hpp"
 
@@ -32,31 +35,49 @@
 #include "staticlib/utils/windows.hpp"
 #else // !STATICLIB_WINDOWS
 #include <cstdio>
+#include <cstring>
 #include <fcntl.h>
 #include <unistd.h>
-#ifndef STATICLIB_MAC
 #include <sys/stat.h>
-#include <sys/sendfile.h>
 #include <sys/types.h> 
-#else // STATICLIB_MAC
-#include <copyfile.h>
+#ifndef STATICLIB_MAC
+#include <sys/syscall.h>
 #endif // !STATICLIB_MAC
 #endif // STATICLIB_WINDOWS
 
 #include "tinydir.h"
 
+#ifndef STATICLIB_WINDOWS
+// same condition tinydir uses to choose "lstat" over "stat" when reading entries,
+// tinydir falls back to "stat" otherwise (i.e. on macOS with default feature macros)
+#if defined(__MINGW32__) || defined(_BSD_SOURCE) || defined(_DEFAULT_SOURCE) || \
+        (defined(_XOPEN_SOURCE) && _XOPEN_SOURCE >= 500) || \
+        (defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L)
+#define STATICLIB_TINYDIR_READFILE_LSTAT
+#endif
+#endif // !STATICLIB_WINDOWS
+
 #include "staticlib/config.hpp"
 #include "staticlib/support.hpp"
 #include "staticlib/utils.hpp"
 
+#include "staticlib/tinydir/file_status.hpp"
 #include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/tree_diff.hpp"
+
+#include "file_copy.hpp"
+#include "io_probe.hpp"
+#include "last_error.hpp"
+#include "native_stat.hpp"
+#include "task_pool.hpp"
+#include "temp_sibling.hpp"
 
 namespace staticlib {
 namespace tinydir {
 
 namespace { // anonymous
 
-std::string file_type(const path& tf) {
+std::string type_name(const path& tf) {
     if (tf.is_directory()) return "directory";
     if (tf.is_regular_file()) return "regular_file";
     if (tf.exists()) return "unexistent";
@@ -65,6 +86,7 @@ std::string file_type(const path& tf) {
 
 std::string delete_file_or_dir(const std::string& path) {
     std::string error;
+    STATICLIB_TINYDIR_IO_BEGIN(probe, remove, path);
 #ifdef STATICLIB_WINDOWS
     auto wpath = sl::utils::widen(path);
     // flip read-only attribute if any
@@ -96,71 +118,78 @@ std::string delete_file_or_dir(const std::string& path) {
         error = TRACEMSG(::strerror(errno));
     }
 #endif // STATICLIB_WINDOWS
+    STATICLIB_TINYDIR_IO_END(probe, 0, !error.empty());
     return error;
 }
 
-std::string move_file_or_dir(const std::string& from, const std::string& to) {
-    std::string error;
-#ifdef STATICLIB_WINDOWS
-    auto wfrom = sl::utils::widen(from);
-    auto wto = sl::utils::widen(to);
-    auto err = ::MoveFileExW(wfrom.c_str(), wto.c_str(),
-            MOVEFILE_COPY_ALLOWED | MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
-    if (0 == err) {
-        error = "MoveFileExW: " + sl::utils::errcode_to_string(::GetLastError());
-    }
-#else // !STATICLIB_WINDOWS
-    auto err = std::rename(from.c_str(), to.c_str());
-    if (0 != err) {
-        error = TRACEMSG(::strerror(errno));
-    }
-#endif // STATICLIB_WINDOWS
-    return error;
+#if !defined(STATICLIB_WINDOWS) && !defined(STATICLIB_MAC) && !defined(STATICLIB_IOS)
+// flags from linux/fs.h, not exposed by older libc headers
+const unsigned int rename_noreplace_flag = 1;
+const unsigned int rename_exchange_flag = 2;
+
+int rename_with_flags(const std::string& from, const std::string& to, unsigned int flags) {
+#ifdef SYS_renameat2
+    return static_cast<int> (::syscall(SYS_renameat2, AT_FDCWD, from.c_str(), AT_FDCWD, to.c_str(), flags));
+#else // !SYS_renameat2
+    (void) from;
+    (void) to;
+    (void) flags;
+    errno = ENOSYS;
+    return -1;
+#endif // SYS_renameat2
 }
+#endif // !STATICLIB_WINDOWS && !STATICLIB_MAC && !STATICLIB_IOS
 
-// https://stackoverflow.com/q/10195343/314015
-void copy_single_file(const path& from_path, const std::string& to) {
-    const std::string& from = from_path.filepath();
+std::error_code move_file_or_dir(const std::string& from, const std::string& to,
+        path::rename_mode mode = path::rename_mode::replace) {
 #ifdef STATICLIB_WINDOWS
+    if (path::rename_mode::exchange == mode) {
+        return std::make_error_code(std::errc::not_supported);
+    }
     auto wfrom = sl::utils::widen(from);
     auto wto = sl::utils::widen(to);
-    auto err = ::CopyFileW(wfrom.c_str(), wto.c_str(), false);
+    DWORD flags = MOVEFILE_COPY_ALLOWED | MOVEFILE_WRITE_THROUGH;
+    if (path::rename_mode::replace == mode) {
+        flags |= MOVEFILE_REPLACE_EXISTING;
+    }
+    STATICLIB_TINYDIR_IO_BEGIN(probe, rename, from);
+    auto err = ::MoveFileExW(wfrom.c_str(), wto.c_str(), flags);
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 == err);
     if (0 == err) {
-        throw tinydir_exception(TRACEMSG("Error copying file: [" + from + "]," +
-                " target: [" + to + "]" +
-                " error: [" + sl::utils::errcode_to_string(::GetLastError()) + "]"));
+        return last_error_code();
     }
 #else // !STATICLIB_WINDOWS
-#ifndef STATICLIB_MAC
-    int source = ::open(from.c_str(), O_RDONLY, 0);
-    if (-1 == source) throw tinydir_exception(TRACEMSG("Error opening src file: [" + from + "]," +
-            " error: [" + ::strerror(errno) + "]"));
-    auto deferred_src = sl::support::defer([source]() STATICLIB_NOEXCEPT {
-        ::close(source);
-    });
-    struct stat stat_source;
-    auto err_stat = ::fstat(source, std::addressof(stat_source));
-    if (-1 == err_stat) throw tinydir_exception(TRACEMSG("Error obtaining file status: [" + from + "]," +
-            " error: [" + ::strerror(errno) + "]"));
-    
-    int dest = ::open(to.c_str(), O_WRONLY | O_CREAT | O_TRUNC, stat_source.st_mode);
-    if (-1 == dest) throw tinydir_exception(TRACEMSG("Error opening dest file: [" + to + "]," +
-            " error: [" + ::strerror(errno) + "]"));
-    auto deferred_dest = sl::support::defer([dest]() STATICLIB_NOEXCEPT {
-        ::close(dest);
-    });
-
-    auto err_sf = ::sendfile(dest, source, 0, stat_source.st_size);
-    if (-1 == err_sf) throw tinydir_exception(TRACEMSG("Error copying file: [" + from + "]," +
-            " target: [" + to + "]" +
-            " error: [" + ::strerror(errno) + "]"));
-#else // STATICLIB_MAC
-    auto err_cf = ::copyfile(from.c_str(), to.c_str(), nullptr, COPYFILE_ALL);
-    if (0 != err_cf) throw tinydir_exception(TRACEMSG("Error copying file: [" + from + "]," +
-            " target: [" + to + "]" +
-            " error code: [" + sl::support::to_string(err_cf) + "]"));
-#endif // !STATICLIB_MAC
+    STATICLIB_TINYDIR_IO_BEGIN(probe, rename, from);
+    int err = 0;
+    switch (mode) {
+    case path::rename_mode::replace:
+        err = std::rename(from.c_str(), to.c_str());
+        break;
+#if defined(STATICLIB_MAC) || defined(STATICLIB_IOS)
+    case path::rename_mode::no_replace:
+        err = ::renamex_np(from.c_str(), to.c_str(), RENAME_EXCL);
+        break;
+    case path::rename_mode::exchange:
+        err = ::renamex_np(from.c_str(), to.c_str(), RENAME_SWAP);
+        break;
+#else // !(STATICLIB_MAC || STATICLIB_IOS)
+    case path::rename_mode::no_replace:
+        err = rename_with_flags(from, to, rename_noreplace_flag);
+        break;
+    case path::rename_mode::exchange:
+        err = rename_with_flags(from, to, rename_exchange_flag);
+        break;
+#endif // STATICLIB_MAC || STATICLIB_IOS
+    default:
+        err = -1;
+        errno = EINVAL;
+    }
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != err);
+    if (0 != err) {
+        return last_error_code();
+    }
 #endif // STATICLIB_WINDOWS
+    return std::error_code();
 }
 
 std::string delete_dir_recursively(const std::string& path) STATICLIB_NOEXCEPT {
@@ -176,6 +205,110 @@ std::string delete_dir_recursively(const std::string& path) STATICLIB_NOEXCEPT {
     return delete_file_or_dir(path);
 }
 
+void copy_file_preserving(const std::string& from, const std::string& to) {
+    const char* failed_op = nullptr;
+    auto ec = copy_regular_file(from, to, true, failed_op);
+    if (ec) throw tinydir_exception(TRACEMSG(std::string(failed_op) + ": [" + from + "]," +
+            " target: [" + to + "]," +
+            " error: [" + ec.message() + "]"));
+}
+
+void copy_symlink(const std::string& from, const std::string& to) {
+#ifdef STATICLIB_WINDOWS
+    (void) to;
+    throw tinydir_exception(TRACEMSG("Copying symbolic links is not supported on windows," +
+            " path: [" + from + "]"));
+#else // !STATICLIB_WINDOWS
+    auto buf = std::vector<char>(256);
+    for (;;) {
+        auto len = ::readlink(from.c_str(), buf.data(), buf.size());
+        if (-1 == len) throw tinydir_exception(TRACEMSG("Error reading symbolic link, path: [" + from + "]," +
+                " error: [" + ::strerror(errno) + "]"));
+        if (static_cast<size_t> (len) < buf.size()) {
+            create_symlink(std::string(buf.data(), static_cast<size_t> (len)), to);
+            return;
+        }
+        buf.resize(buf.size() * 2);
+    }
+#endif // STATICLIB_WINDOWS
+}
+
+void set_dir_attributes(const std::string& dirpath, const file_status& st) {
+#ifndef STATICLIB_WINDOWS
+    auto err = ::chmod(dirpath.c_str(), static_cast<mode_t> (st.mode));
+    if (0 != err) throw tinydir_exception(TRACEMSG("Error setting directory permissions," +
+            " path: [" + dirpath + "], error: [" + ::strerror(errno) + "]"));
+#endif // !STATICLIB_WINDOWS
+    set_modification_time(dirpath, st.mtime_ns);
+}
+
+void clone_file(const std::string& from, const std::string& to, path::clone_mode mode) {
+    if (path::clone_mode::hardlink == mode) {
+        create_hardlink(from, to);
+        return;
+    }
+    const char* failed_op = nullptr;
+    auto ec = clone_regular_file(from, to, failed_op);
+    if (std::errc::operation_not_supported == ec) {
+        copy_file_preserving(from, to);
+        return;
+    }
+    if (ec) throw tinydir_exception(TRACEMSG(std::string(failed_op) + ": [" + from + "]," +
+            " target: [" + to + "]," +
+            " error: [" + ec.message() + "]"));
+}
+
+void copy_tree_preserving(const std::string& from, const std::string& to, size_t threads_count,
+        std::function<void(const std::string&, const std::string&)> copy_file_fun) {
+    auto snap = snapshot_tree(from, threads_count);
+    create_directory(to);
+    task_pool pool(threads_count);
+    for (auto& en : snap.entries()) {
+        auto spath = from + "/" + en.relpath;
+        auto tpath = to + "/" + en.relpath;
+        switch (en.status.type) {
+        case file_type::directory:
+            create_directory(tpath);
+            break;
+        case file_type::symlink:
+            copy_symlink(spath, tpath);
+            break;
+        case file_type::regular_file:
+            pool.submit([spath, tpath, &copy_file_fun] {
+                copy_file_fun(spath, tpath);
+            });
+            break;
+        default:
+            throw tinydir_exception(TRACEMSG("Cannot copy special file, path: [" + spath + "]"));
+        }
+    }
+    pool.wait();
+    // directories are modified while being filled, deepest ones go first
+    auto& entries = snap.entries();
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        if (file_type::directory == it->status.type) {
+            set_dir_attributes(to + "/" + it->relpath, it->status);
+        }
+    }
+    set_dir_attributes(to, status(from));
+}
+
+// joined path with "." or ".." components would not point to a child of this directory
+bool has_dot_component(const std::string& name) {
+    size_t begin = 0;
+    for (;;) {
+        auto end = name.find_first_of("/\\", begin);
+        auto len = (std::string::npos == end ? name.length() : end) - begin;
+        if ((1 == len && '.' == name[begin]) || (2 == len && '.' == name[begin] && '.' == name[begin + 1])) {
+            return true;
+        }
+        if (std::string::npos == end) {
+            return false;
+        }
+        begin = end + 1;
+    }
+}
+
 } // namespace
 
 path::path(const std::string& path) :
@@ -191,6 +324,8 @@ fname(sl::utils::strip_parent_dir(this->fpath)) {
             this->is_dir = tf.is_directory();
             this->is_reg = tf.is_regular_file();
             this->is_exist = true;
+            this->has_status = tf.has_status;
+            this->fstatus = tf.fstatus;
             break;
         }
     }
@@ -208,14 +343,39 @@ path::path(std::nullptr_t, void* /* tinydir_file* */ pfile) {
     this->is_dir = 0 != file->is_dir;
     this->is_reg = 0 != file->is_reg;
     this->is_exist = true;
+#ifndef STATICLIB_WINDOWS
+#ifdef STATICLIB_TINYDIR_READFILE_LSTAT
+    this->fstatus = status_from_native(file->_s);
+    this->has_status = true;
+#else // !STATICLIB_TINYDIR_READFILE_LSTAT
+    // tinydir followed symlinks, entry itself is described by "lstat"
+    struct stat st;
+    if (0 == ::lstat(file->path, std::addressof(st))) {
+        this->fstatus = status_from_native(st);
+        this->has_status = true;
+        if (S_ISLNK(st.st_mode)) {
+            this->is_dir = false;
+            this->is_reg = false;
+        }
+    }
+#endif // STATICLIB_TINYDIR_READFILE_LSTAT
+#endif // !STATICLIB_WINDOWS
 }
 
+path::path(std::string&& fpath, std::string&& fname) :
+fpath(std::move(fpath)),
+fname(std::move(fname)),
+is_lazy(true) { }
+
 path::path(const path& other) :
 fpath(other.fpath.data(), other.fpath.length()),
 fname(other.fname.data(), other.fname.length()),
 is_dir(other.is_dir),
 is_reg(other.is_reg),
-is_exist(other.is_exist) { }
+is_exist(other.is_exist),
+has_status(other.has_status),
+is_lazy(other.is_lazy),
+fstatus(other.fstatus) { }
 
 path& path::operator=(const path& other) {
     fpath = std::string(other.fpath.data(), other.fpath.length());
@@ -223,6 +383,9 @@ path& path::operator=(const path& other) {
     is_dir = other.is_dir;
     is_reg = other.is_reg;
     is_exist = other.is_exist;
+    has_status = other.has_status;
+    is_lazy = other.is_lazy;
+    fstatus = other.fstatus;
     return *this;
 }
 
@@ -231,10 +394,15 @@ fpath(std::move(other.fpath)),
 fname(std::move(other.fname)),
 is_dir(other.is_dir),
 is_reg(other.is_reg),
-is_exist(other.is_exist) { 
+is_exist(other.is_exist),
+has_status(other.has_status),
+is_lazy(other.is_lazy),
+fstatus(other.fstatus) { 
     other.is_dir = false;
     other.is_reg = false;
     other.is_exist = false;
+    other.has_status = false;
+    other.is_lazy = false;
 }
 
 path& path::operator=(path&& other) STATICLIB_NOEXCEPT {
@@ -246,9 +414,36 @@ path& path::operator=(path&& other) STATICLIB_NOEXCEPT {
     other.is_reg = false;
     is_exist = other.is_exist;
     other.is_exist = false;
+    has_status = other.has_status;
+    other.has_status = false;
+    is_lazy = other.is_lazy;
+    other.is_lazy = false;
+    fstatus = other.fstatus;
     return *this;
 }
 
+path path::operator/(const std::string& name) const {
+    if (name.empty()) throw tinydir_exception(TRACEMSG("Invalid empty child name, path: [" + fpath + "]"));
+    if (has_dot_component(name)) throw tinydir_exception(TRACEMSG("Invalid child name: [" + name + "]," +
+            " path: [" + fpath + "]"));
+    if (std::string::npos != name.find_first_of("/\\")) {
+        auto joined = normalize_path(fpath + "/" + name);
+        auto joined_name = sl::utils::strip_parent_dir(joined);
+        if (joined_name.empty()) throw tinydir_exception(TRACEMSG("Invalid child name: [" + name + "]," +
+                " path: [" + fpath + "]"));
+        return path(std::move(joined), std::move(joined_name));
+    }
+    // this path is already normalized, only the root one ends with a slash
+    auto joined = std::string();
+    joined.reserve(fpath.length() + 1 + name.length());
+    joined.append(fpath);
+    if (joined.empty() || '/' != joined.back()) {
+        joined.push_back('/');
+    }
+    joined.append(name);
+    return path(std::move(joined), std::string(name.data(), name.length()));
+}
+
 const std::string& path::filepath() const {
     return fpath;
 }
@@ -258,17 +453,33 @@ const std::string& path::filename() const {
 }
 
 bool path::exists() const {
+    if (is_lazy) {
+        return file_type::not_found != tinydir::symlink_status(fpath).type;
+    }
     return is_exist;
 }
 
 bool path::is_directory() const {
+    if (is_lazy) {
+        return file_type::directory == tinydir::symlink_status(fpath).type;
+    }
     return is_dir;
 }
 
 bool path::is_regular_file() const {
+    if (is_lazy) {
+        return file_type::regular_file == tinydir::symlink_status(fpath).type;
+    }
     return is_reg;
 }
 
+file_status path::symlink_status() const {
+    if (has_status) {
+        return fstatus;
+    }
+    return tinydir::symlink_status(fpath);
+}
+
 file_source path::open_read() const {
     return file_source(fpath);
 }
@@ -278,36 +489,126 @@ file_sink path::open_write(file_sink::open_mode mode) const {
 }
 
 void path::remove() const {
-    auto err = is_dir ? delete_dir_recursively(fpath) : delete_file_or_dir(fpath);
+    auto err = is_directory() ? delete_dir_recursively(fpath) : delete_file_or_dir(fpath);
     if (!err.empty()) {
         throw tinydir_exception(TRACEMSG("Cannot remove file: [" + fpath + "]," +
-                " type: [" + file_type(*this) + "], error: [" + err + "]"));
+                " type: [" + type_name(*this) + "], error: [" + err + "]"));
     }
 }
 
 bool path::remove_quietly() const STATICLIB_NOEXCEPT {
-    auto err = is_dir ? delete_dir_recursively(fpath) : delete_file_or_dir(fpath);
+    bool dir = false;
+    try {
+        dir = is_directory();
+    } catch (const std::exception&) {
+        return false;
+    }
+    auto err = dir ? delete_dir_recursively(fpath) : delete_file_or_dir(fpath);
     return err.empty();
 }
 
-path path::rename(const std::string& target) const {
-    auto err = move_file_or_dir(fpath, target);
-    if (!err.empty()) {
+path path::rename(const std::string& target, rename_mode mode) const {
+    auto ec = move_file_or_dir(fpath, target, mode);
+    if (ec) {
         throw tinydir_exception(TRACEMSG("Cannot rename file: [" + fpath + "]," +
-                " type: [" + file_type(*this) + "]," +
+                " type: [" + type_name(*this) + "]," +
                 " to: [" + target + "]," +
-                " error: [" + err + "]"));
+                " error: [" + ec.message() + "]"));
     }
     return path(target);
 }
 
+void path::rename(const std::string& target, std::error_code& ec) const {
+    ec = move_file_or_dir(fpath, target);
+}
+
+void path::rename(const std::string& target, rename_mode mode, std::error_code& ec) const {
+    ec = move_file_or_dir(fpath, target, mode);
+}
+
 path path::copy_file(const std::string& target) const {
     if (!is_regular_file()) {
         throw tinydir_exception(TRACEMSG("Cannot copy invalid file," +
                 " path: [" + fpath + "]," +
                 " target path: [" + target + "]"));
     }
-    copy_single_file(fpath, target);
+    const char* failed_op = nullptr;
+    auto ec = copy_regular_file(fpath, target, false, failed_op);
+    if (ec) {
+        throw tinydir_exception(TRACEMSG(std::string(failed_op) + ": [" + fpath + "]," +
+                " target: [" + target + "]," +
+                " error: [" + ec.message() + "]"));
+    }
+    return path(target);
+}
+
+void path::copy_file(const std::string& target, std::error_code& ec) const {
+    if (!is_regular_file()) {
+        ec = std::make_error_code(exists() ? std::errc::invalid_argument : std::errc::no_such_file_or_directory);
+        return;
+    }
+    const char* failed_op = nullptr;
+    ec = copy_regular_file(fpath, target, false, failed_op);
+}
+
+path path::move(const std::string& target, size_t threads_count) const {
+    auto ec = move_file_or_dir(fpath, target);
+    if (!ec) {
+        return path(target);
+    }
+    if (std::errc::cross_device_link != ec) throw tinydir_exception(TRACEMSG("Cannot move file: [" + fpath + "]," +
+            " to: [" + target + "]," +
+            " error: [" + ec.message() + "]"));
+
+    auto st = tinydir::symlink_status(fpath);
+    {
+        temp_sibling sibling(target, "tinydir_move");
+        auto& tmp = sibling.path();
+        switch (st.type) {
+        case file_type::regular_file:
+            copy_file_preserving(fpath, tmp);
+            break;
+        case file_type::directory:
+            copy_tree_preserving(fpath, tmp, threads_count, copy_file_preserving);
+            break;
+        case file_type::symlink:
+            copy_symlink(fpath, tmp);
+            break;
+        default:
+            throw tinydir_exception(TRACEMSG("Cannot move special file, path: [" + fpath + "]"));
+        }
+        auto ec_tmp = move_file_or_dir(tmp, target);
+        if (ec_tmp) throw tinydir_exception(TRACEMSG("Cannot rename file: [" + tmp + "]," +
+                " to: [" + target + "]," +
+                " error: [" + ec_tmp.message() + "]"));
+    }
+
+    // source is removed only after the copy is in place
+    auto err = file_type::directory == st.type ? delete_dir_recursively(fpath) : delete_file_or_dir(fpath);
+    if (!err.empty()) throw tinydir_exception(TRACEMSG("Cannot remove moved file: [" + fpath + "]," +
+            " target: [" + target + "], error: [" + err + "]"));
+    return path(target);
+}
+
+path path::clone(const std::string& target, clone_mode mode, size_t threads_count) const {
+    auto st = tinydir::symlink_status(fpath);
+    switch (st.type) {
+    case file_type::regular_file:
+        clone_file(fpath, target, mode);
+        break;
+    case file_type::directory:
+        copy_tree_preserving(fpath, target, threads_count, [mode](const std::string& from, const std::string& to) {
+            clone_file(from, to, mode);
+        });
+        break;
+    case file_type::symlink:
+        copy_symlink(fpath, target);
+        break;
+    case file_type::not_found:
+        throw tinydir_exception(TRACEMSG("Cannot clone not existing file, path: [" + fpath + "]"));
+    default:
+        throw tinydir_exception(TRACEMSG("Cannot clone special file, path: [" + fpath + "]"));
+    }
     return path(target);
 }
 
@@ -340,7 +641,9 @@ void path::resize(size_t size){
                 "], error: [" + sl::utils::errcode_to_string(::GetLastError()) + 
                 "], specified path: [" + fpath + "]"));
     }
+    STATICLIB_TINYDIR_IO_BEGIN(probe, resize, fpath);
     auto res = ::SetEndOfFile(handle);
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 == res);
     if (0 == res) throw tinydir_exception(TRACEMSG(
             "Error SetEndOfFile: [" + sl::utils::errcode_to_string(::GetLastError()) + "]" +
             ", specified path: [" + fpath + "]"));
@@ -351,7 +654,9 @@ void path::resize(size_t size){
     auto deferred_src = sl::support::defer([dest]() STATICLIB_NOEXCEPT {
                                                ::close(dest);
                                            });
+    STATICLIB_TINYDIR_IO_BEGIN(probe, resize, fpath);
     auto result = ftruncate(dest, size);
+    STATICLIB_TINYDIR_IO_END(probe, 0, -1 == result);
     if (-1 == result) throw support::exception(TRACEMSG("Cannot resize file: [" + fpath + "]," +
                                                         " error: [" + ::strerror(errno) + "]"));
 #endif
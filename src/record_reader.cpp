@@ -0,0 +1,140 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   record_reader.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 12:05 AM
+ */
+
+#include "staticlib/tinydir/record_reader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ios>
+#include <utility>
+
+#include "staticlib/support.hpp"
+
+#include "byte_scan.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+record_reader::record_reader(file_source&& src, char delimiter, size_t buffer_size) :
+src(std::move(src)),
+delimiter(delimiter),
+buffer(acquire_io_buffer(std::max(buffer_size, static_cast<size_t> (1)))) {
+    buffer_offset = static_cast<uint64_t> (this->src.seek(0, 'c'));
+    record_offset = buffer_offset;
+}
+
+record_reader::record_reader(const std::string& file_path, char delimiter, size_t buffer_size) :
+record_reader(file_source(file_path), delimiter, buffer_size) { }
+
+record_reader::record_reader(record_reader&& other) STATICLIB_NOEXCEPT :
+src(std::move(other.src)),
+delimiter(other.delimiter),
+buffer(std::move(other.buffer)),
+begin(other.begin),
+scanned(other.scanned),
+end(other.end),
+buffer_offset(other.buffer_offset),
+record_offset(other.record_offset),
+eof(other.eof) {
+    other.begin = 0;
+    other.scanned = 0;
+    other.end = 0;
+}
+
+record_reader& record_reader::operator=(record_reader&& other) STATICLIB_NOEXCEPT {
+    src = std::move(other.src);
+    delimiter = other.delimiter;
+    buffer = std::move(other.buffer);
+    begin = other.begin;
+    other.begin = 0;
+    scanned = other.scanned;
+    other.scanned = 0;
+    end = other.end;
+    other.end = 0;
+    buffer_offset = other.buffer_offset;
+    record_offset = other.record_offset;
+    eof = other.eof;
+    return *this;
+}
+
+bool record_reader::next(sl::io::span<const char>& record) {
+    if (nullptr == buffer.data()) throw tinydir_exception(TRACEMSG(
+            "Attempt to read records from closed file: [" + src.path() + "]"));
+    for (;;) {
+        auto data = buffer.data();
+        auto found = scan_for_byte(data + scanned, data + end, delimiter);
+        if (data + end != found) {
+            auto pos = static_cast<size_t> (found - data);
+            record = {data + begin, pos - begin};
+            record_offset = buffer_offset + begin;
+            begin = pos + 1;
+            scanned = begin;
+            return true;
+        }
+        // delimiter is not searched twice in the same data
+        scanned = end;
+        if (eof) {
+            if (begin == end) {
+                return false;
+            }
+            record = {data + begin, end - begin};
+            record_offset = buffer_offset + begin;
+            begin = end;
+            return true;
+        }
+        fill();
+    }
+}
+
+uint64_t record_reader::offset() const {
+    return record_offset;
+}
+
+file_source& record_reader::source() {
+    return src;
+}
+
+void record_reader::fill() {
+    // only the partial record is copied
+    if (begin > 0) {
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        buffer_offset += begin;
+        end -= begin;
+        scanned -= begin;
+        begin = 0;
+    }
+    if (end == buffer.size()) {
+        auto larger = acquire_io_buffer(buffer.size() * 2);
+        std::memcpy(larger.data(), buffer.data(), end);
+        buffer = std::move(larger);
+    }
+    auto read = src.read({buffer.data() + end, buffer.size() - end});
+    if (std::char_traits<char>::eof() == read) {
+        eof = true;
+    } else {
+        end += static_cast<size_t> (read);
+    }
+}
+
+} // namespace
+}
@@ -0,0 +1,335 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   rotating_file_sink.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 2:00 AM
+ */
+
+#include "staticlib/tinydir/rotating_file_sink.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <system_error>
+#include <utility>
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "staticlib/tinydir/path.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+std::string segment_name(const std::string& prefix, uint64_t idx) {
+    return prefix + "." + sl::support::to_string(idx);
+}
+
+bool preallocated(const rotation_options& options) {
+    return options.preallocate && options.max_segment_size > 0;
+}
+
+void reserve_segment(file_sink& fs, const rotation_options& options) {
+    if (preallocated(options)) {
+        fs.reserve_space(options.max_segment_size);
+    }
+}
+
+// existing files are never truncated, their indices are skipped
+std::unique_ptr<file_sink> create_segment(const std::string& prefix, uint64_t& idx,
+        const rotation_options& options) {
+    for (;;) {
+        auto path = segment_name(prefix, idx);
+        std::error_code ec;
+        auto res = std::unique_ptr<file_sink>(new file_sink(path, file_sink::open_mode::create_new, ec));
+        if (std::errc::file_exists == ec) {
+            idx += 1;
+            continue;
+        }
+        if (ec) throw tinydir_exception(TRACEMSG("Error creating segment: [" + path + "]," +
+                " error: [" + ec.message() + "]"));
+        try {
+            reserve_segment(*res, options);
+        } catch (...) {
+            res.reset();
+            tinydir::path(path).remove_quietly();
+            throw;
+        }
+        return res;
+    }
+}
+
+} // namespace
+
+class rotation_worker {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::string prefix;
+    rotation_options options;
+    uint64_t next_index;
+    bool prepare_requested = true;
+    std::unique_ptr<file_sink> prepared;
+    uint64_t prepared_index = 0;
+    std::exception_ptr prepare_error;
+    // segments with the number of bytes written into them
+    std::deque<std::pair<std::unique_ptr<file_sink>, uint64_t>> retired;
+    std::exception_ptr retire_error;
+    bool stopping = false;
+    // must be the last member, started after all other are initialized
+    std::thread thread;
+
+public:
+    rotation_worker(const std::string& prefix, const rotation_options& options, uint64_t next_index) :
+    prefix(prefix.data(), prefix.size()),
+    options(options),
+    next_index(next_index),
+    thread([this] { run(); }) { }
+
+    ~rotation_worker() STATICLIB_NOEXCEPT {
+        stop();
+    }
+
+    rotation_worker(const rotation_worker&) = delete;
+
+    rotation_worker& operator=(const rotation_worker&) = delete;
+
+    void swap(std::unique_ptr<file_sink>& current, uint64_t& index, uint64_t written) {
+        std::unique_lock<std::mutex> lock{mtx};
+        if (nullptr != retire_error) {
+            auto err = retire_error;
+            retire_error = nullptr;
+            std::rethrow_exception(err);
+        }
+        // normally the segment is prepared long before it is needed
+        cv.wait(lock, [this] {
+            return nullptr != prepared.get() || nullptr != prepare_error;
+        });
+        if (nullptr != prepare_error) {
+            // preparation is retried on the next rotation
+            auto err = prepare_error;
+            prepare_error = nullptr;
+            prepare_requested = true;
+            cv.notify_all();
+            std::rethrow_exception(err);
+        }
+        retired.emplace_back(std::move(current), written);
+        current = std::move(prepared);
+        index = prepared_index;
+        prepare_requested = true;
+        cv.notify_all();
+    }
+
+    void finish(std::unique_ptr<file_sink> current, uint64_t written) {
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            if (nullptr != current.get()) {
+                retired.emplace_back(std::move(current), written);
+            }
+        }
+        stop();
+        if (nullptr != prepared.get()) {
+            auto unused = prepared->path();
+            if (preallocated(options)) {
+                // space stays reserved if the file cannot be removed
+                try {
+                    prepared->resize(0);
+                } catch (...) {
+                    // ignore
+                }
+            }
+            prepared.reset();
+            tinydir::path(unused).remove_quietly();
+        }
+        if (nullptr != retire_error) {
+            std::rethrow_exception(retire_error);
+        }
+    }
+
+private:
+    void stop() STATICLIB_NOEXCEPT {
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            stopping = true;
+        }
+        cv.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    void run() STATICLIB_NOEXCEPT {
+        std::unique_lock<std::mutex> lock{mtx};
+        for (;;) {
+            cv.wait(lock, [this] {
+                return stopping || prepare_requested || !retired.empty();
+            });
+            // next segment first, writer may be waiting for it
+            if (prepare_requested && !stopping) {
+                prepare_requested = false;
+                auto idx = next_index;
+                lock.unlock();
+                std::unique_ptr<file_sink> fs;
+                std::exception_ptr err;
+                try {
+                    fs = create_segment(prefix, idx, options);
+                } catch (...) {
+                    err = std::current_exception();
+                }
+                lock.lock();
+                if (nullptr != fs.get()) {
+                    prepared = std::move(fs);
+                    prepared_index = idx;
+                    next_index = idx + 1;
+                } else {
+                    prepare_error = err;
+                }
+                cv.notify_all();
+            } else if (!retired.empty()) {
+                auto fs = std::move(retired.front().first);
+                auto size = retired.front().second;
+                retired.pop_front();
+                lock.unlock();
+                std::exception_ptr err;
+                try {
+                    // releases reserved space beyond the written data
+                    if (preallocated(options)) {
+                        fs->resize(size);
+                    }
+                    if (options.sync_retired) {
+                        fs->sync();
+                    }
+                } catch (...) {
+                    err = std::current_exception();
+                }
+                fs.reset();
+                lock.lock();
+                if (nullptr != err && nullptr == retire_error) {
+                    retire_error = err;
+                }
+            } else if (stopping) {
+                return;
+            }
+        }
+    }
+};
+
+rotating_file_sink::rotating_file_sink(const std::string& path_prefix, rotation_options options) :
+prefix(path_prefix.data(), path_prefix.size()),
+options(options),
+index(options.first_index) {
+    current = create_segment(this->prefix, index, options);
+    opened_at = std::chrono::steady_clock::now();
+    worker = std::unique_ptr<rotation_worker>(new rotation_worker(this->prefix, options, index + 1));
+}
+
+rotating_file_sink::~rotating_file_sink() STATICLIB_NOEXCEPT {
+    try {
+        close();
+    } catch (...) {
+        // ignore
+    }
+}
+
+rotating_file_sink::rotating_file_sink(rotating_file_sink&& other) STATICLIB_NOEXCEPT :
+prefix(std::move(other.prefix)),
+options(other.options),
+worker(std::move(other.worker)),
+current(std::move(other.current)),
+index(other.index),
+written(other.written),
+opened_at(other.opened_at) { }
+
+rotating_file_sink& rotating_file_sink::operator=(rotating_file_sink&& other) STATICLIB_NOEXCEPT {
+    try {
+        close();
+    } catch (...) {
+        // ignore
+    }
+    prefix = std::move(other.prefix);
+    options = other.options;
+    worker = std::move(other.worker);
+    current = std::move(other.current);
+    index = other.index;
+    written = other.written;
+    opened_at = other.opened_at;
+    return *this;
+}
+
+std::streamsize rotating_file_sink::write(sl::io::span<const char> span) {
+    if (nullptr == current.get()) throw tinydir_exception(TRACEMSG(
+            "Attempt to write into closed rotating sink: [" + prefix + "]"));
+    if (written > 0) {
+        bool by_size = options.max_segment_size > 0 &&
+                written + span.size() > options.max_segment_size;
+        bool by_age = options.max_segment_age.count() > 0 &&
+                std::chrono::steady_clock::now() - opened_at >= options.max_segment_age;
+        if (by_size || by_age) {
+            rotate();
+        }
+    }
+    size_t off = 0;
+    while (off < span.size()) {
+        auto res = current->write({span.data() + off, span.size() - off});
+        off += static_cast<size_t> (res);
+        written += static_cast<uint64_t> (res);
+    }
+    return static_cast<std::streamsize> (span.size());
+}
+
+std::streamsize rotating_file_sink::flush() {
+    return 0;
+}
+
+void rotating_file_sink::rotate() {
+    if (nullptr == current.get()) throw tinydir_exception(TRACEMSG(
+            "Attempt to rotate closed rotating sink: [" + prefix + "]"));
+    if (0 == written) {
+        return;
+    }
+    worker->swap(current, index, written);
+    written = 0;
+    opened_at = std::chrono::steady_clock::now();
+}
+
+void rotating_file_sink::close() {
+    if (nullptr == worker.get()) {
+        return;
+    }
+    auto wr = std::move(worker);
+    wr->finish(std::move(current), written);
+}
+
+uint64_t rotating_file_sink::segment_index() const {
+    return index;
+}
+
+uint64_t rotating_file_sink::segment_size() const {
+    return written;
+}
+
+std::string rotating_file_sink::segment_path(uint64_t idx) const {
+    return segment_name(prefix, idx);
+}
+
+} // namespace
+}
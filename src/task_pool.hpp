@@ -0,0 +1,167 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   task_pool.hpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:31 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_TASK_POOL_HPP
+#define STATICLIB_TINYDIR_TASK_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Private fixed-size thread pool used by parallel tree operations,
+ * tasks may submit new tasks to the same pool. First exception
+ * thrown from a task cancels all pending tasks and is rethrown from "wait".
+ */
+class task_pool {
+    std::mutex mtx;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    std::deque<std::function<void()>> queue;
+    std::vector<std::thread> threads;
+    size_t active = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param threads_count number of worker threads, zero to use
+     *        the number of hardware threads
+     */
+    explicit task_pool(size_t threads_count) {
+        auto count = 0 != threads_count ? threads_count : default_threads_count();
+        for (size_t i = 0; i < count; i++) {
+            threads.emplace_back([this] {
+                this->run();
+            });
+        }
+    }
+
+    /**
+     * Destructor, cancels pending tasks and joins worker threads
+     */
+    ~task_pool() STATICLIB_NOEXCEPT {
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            stopping = true;
+            queue.clear();
+        }
+        work_cv.notify_all();
+        for (auto& th : threads) {
+            th.join();
+        }
+    }
+
+    task_pool(const task_pool&) = delete;
+
+    task_pool& operator=(const task_pool&) = delete;
+
+    /**
+     * Enqueues the task for the execution, task is dropped if the
+     * pool is already failed
+     *
+     * @param task task to run
+     */
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> guard{mtx};
+            if (nullptr != error || stopping) return;
+            queue.emplace_back(std::move(task));
+        }
+        work_cv.notify_one();
+    }
+
+    /**
+     * Blocks until all submitted tasks (including the ones submitted
+     * by other tasks) are finished
+     *
+     * @throws first exception thrown by any of the tasks
+     */
+    void wait() {
+        std::unique_lock<std::mutex> lock{mtx};
+        done_cv.wait(lock, [this] {
+            return queue.empty() && 0 == active;
+        });
+        if (nullptr != error) {
+            auto err = error;
+            error = nullptr;
+            std::rethrow_exception(err);
+        }
+    }
+
+    /**
+     * Number of worker threads used when zero is passed to constructor
+     *
+     * @return number of hardware threads, at least 1
+     */
+    static size_t default_threads_count() {
+        auto res = std::thread::hardware_concurrency();
+        return res > 0 ? res : 1;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock{mtx};
+        for (;;) {
+            work_cv.wait(lock, [this] {
+                return stopping || !queue.empty();
+            });
+            if (stopping) return;
+            auto task = std::move(queue.front());
+            queue.pop_front();
+            active += 1;
+            lock.unlock();
+            std::exception_ptr err;
+            try {
+                task();
+            } catch (...) {
+                err = std::current_exception();
+            }
+            lock.lock();
+            active -= 1;
+            if (nullptr != err && nullptr == error) {
+                error = err;
+                queue.clear();
+            }
+            if (queue.empty() && 0 == active) {
+                done_cv.notify_all();
+            }
+        }
+    }
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_TASK_POOL_HPP */
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   temp_sibling.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 5:25 AM
+ */
+
+#include "temp_sibling.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <system_error>
+
+#ifdef STATICLIB_WINDOWS
+#include "staticlib/support/windows.hpp"
+#else // !STATICLIB_WINDOWS
+#include <unistd.h>
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+std::atomic<uint64_t> names_counter(0);
+
+uint64_t process_id() {
+#ifdef STATICLIB_WINDOWS
+    return static_cast<uint64_t> (::GetCurrentProcessId());
+#else // !STATICLIB_WINDOWS
+    return static_cast<uint64_t> (::getpid());
+#endif // STATICLIB_WINDOWS
+}
+
+std::string create_unique_dir(const std::string& target, const std::string& tag) {
+    auto prefix = normalize_path(target) + "." + tag + "_" + sl::support::to_string(process_id()) + "_";
+    for (;;) {
+        auto dirpath = prefix + sl::support::to_string(names_counter.fetch_add(1));
+        std::error_code ec;
+        // directory creation is exclusive, existing entries are skipped
+        create_directory(dirpath, ec);
+        if (!ec) {
+            return dirpath;
+        }
+        if (std::errc::file_exists != ec) throw tinydir_exception(TRACEMSG(
+                "Error creating temporary directory, path: [" + dirpath + "]," +
+                " error: [" + ec.message() + "]"));
+    }
+}
+
+} // namespace
+
+temp_sibling::temp_sibling(const std::string& target, const std::string& tag) :
+dir_path(create_unique_dir(target, tag)),
+entry_path(dir_path + "/entry") { }
+
+temp_sibling::~temp_sibling() STATICLIB_NOEXCEPT {
+    try {
+        tinydir::path(dir_path).remove_quietly();
+    } catch (...) {
+        // ignore
+    }
+}
+
+const std::string& temp_sibling::path() const {
+    return entry_path;
+}
+
+} // namespace
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   temp_sibling.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 5:20 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_TEMP_SIBLING_HPP
+#define STATICLIB_TINYDIR_TEMP_SIBLING_HPP
+
+#include <string>
+
+#include "staticlib/config.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+/**
+ * Private helper for operations that prepare an entry under a temporary
+ * name and rename it over the target. Instead of a fixed temporary name,
+ * that may clash with user files or with concurrent operations on the same
+ * target, an empty directory with a unique name (process ID and counter)
+ * is created exclusively next to the target, entry is prepared inside it,
+ * so the final rename stays on the same FS and is atomic.
+ */
+class temp_sibling {
+    std::string dir_path;
+    std::string entry_path;
+
+public:
+    /**
+     * Constructor, creates the temporary directory
+     *
+     * @param target path to the target entry
+     * @param tag operation name, included in the directory name
+     * @throws tinydir_exception if directory cannot be created
+     */
+    temp_sibling(const std::string& target, const std::string& tag);
+
+    /**
+     * Destructor, removes the temporary directory with all its contents
+     */
+    ~temp_sibling() STATICLIB_NOEXCEPT;
+
+    temp_sibling(const temp_sibling&) = delete;
+
+    temp_sibling& operator=(const temp_sibling&) = delete;
+
+    /**
+     * Path inside the temporary directory where the entry is prepared,
+     * does not exist initially
+     *
+     * @return path to the temporary entry
+     */
+    const std::string& path() const;
+};
+
+} // namespace
+}
+
+#endif /* STATICLIB_TINYDIR_TEMP_SIBLING_HPP */
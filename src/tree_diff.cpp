@@ -0,0 +1,451 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   tree_diff.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:02 AM
+ */
+
+#include "staticlib/tinydir/tree_diff.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <set>
+
+#include "staticlib/config.hpp"
+
+#ifndef STATICLIB_WINDOWS
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif // !STATICLIB_WINDOWS
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "file_copy.hpp"
+#include "io_probe.hpp"
+#include "task_pool.hpp"
+
+namespace staticlib {
+namespace tinydir {
+
+namespace { // anonymous
+
+const std::string snapshot_header = "# staticlib_tinydir tree snapshot 1";
+
+char type_to_char(file_type type) {
+    switch (type) {
+    case file_type::regular_file: return 'f';
+    case file_type::directory: return 'd';
+    case file_type::symlink: return 'l';
+    default: return 'o';
+    }
+}
+
+file_type char_to_type(char ch) {
+    switch (ch) {
+    case 'f': return file_type::regular_file;
+    case 'd': return file_type::directory;
+    case 'l': return file_type::symlink;
+    case 'o': return file_type::other;
+    default: throw tinydir_exception(TRACEMSG("Invalid entry type: [" + ch + "]"));
+    }
+}
+
+bool entry_less(const tree_entry& a, const tree_entry& b) {
+    return a.relpath < b.relpath;
+}
+
+std::string join(const std::string& root, const std::string& relpath) {
+    return relpath.empty() ? root : root + "/" + relpath;
+}
+
+size_t read_fully(file_source& src, std::vector<char>& buf) {
+    size_t filled = 0;
+    while (filled < buf.size()) {
+        auto read = src.read({buf.data() + filled, buf.size() - filled});
+        if (std::char_traits<char>::eof() == read) break;
+        filled += static_cast<size_t> (read);
+    }
+    return filled;
+}
+
+bool same_content(const std::string& first, const std::string& second) {
+    auto src1 = file_source(first);
+    auto src2 = file_source(second);
+    auto buf1 = std::vector<char>(1 << 16);
+    auto buf2 = std::vector<char>(buf1.size());
+    for (;;) {
+        auto read1 = read_fully(src1, buf1);
+        auto read2 = read_fully(src2, buf2);
+        if (read1 != read2 || 0 != std::memcmp(buf1.data(), buf2.data(), read1)) {
+            return false;
+        }
+        if (read1 < buf1.size()) {
+            return true;
+        }
+    }
+}
+
+bool entries_differ(const file_status& src, const file_status& tgt, bool compare_mtime) {
+    switch (src.type) {
+    case file_type::regular_file:
+    case file_type::symlink:
+        return src.size != tgt.size || (compare_mtime && src.mtime_ns != tgt.mtime_ns);
+    default:
+        return false;
+    }
+}
+
+std::vector<tree_change> diff_snapshots(const tree_snapshot& source, const tree_snapshot& target,
+        bool compare_mtime, std::vector<std::string>& same_size_files) {
+    auto& src = source.entries();
+    auto& tgt = target.entries();
+    auto res = std::vector<tree_change>();
+    size_t i = 0;
+    size_t j = 0;
+    while (i < src.size() || j < tgt.size()) {
+        if (j == tgt.size() || (i < src.size() && src[i].relpath < tgt[j].relpath)) {
+            res.emplace_back(tree_change_kind::added, src[i].relpath, src[i].status.type);
+            i += 1;
+        } else if (i == src.size() || tgt[j].relpath < src[i].relpath) {
+            res.emplace_back(tree_change_kind::removed, tgt[j].relpath, tgt[j].status.type);
+            j += 1;
+        } else {
+            auto& se = src[i].status;
+            auto& te = tgt[j].status;
+            if (se.type != te.type) {
+                res.emplace_back(tree_change_kind::removed, tgt[j].relpath, te.type);
+                res.emplace_back(tree_change_kind::added, src[i].relpath, se.type);
+            } else if (entries_differ(se, te, compare_mtime)) {
+                res.emplace_back(tree_change_kind::modified, src[i].relpath, se.type);
+            } else if (file_type::regular_file == se.type) {
+                same_size_files.push_back(src[i].relpath);
+            }
+            i += 1;
+            j += 1;
+        }
+    }
+    return res;
+}
+
+std::vector<tree_change> diff_dirs(const tree_snapshot& source, const tree_snapshot& target,
+        const std::string& source_dir, const std::string& target_dir, const tree_diff_options& options,
+        std::vector<std::string>& same_content_files) {
+    auto same_size = std::vector<std::string>();
+    auto compare_mtime = options.compare_mtime && !options.verify_content;
+    auto res = diff_snapshots(source, target, compare_mtime, same_size);
+    if (!options.verify_content || same_size.empty()) {
+        return res;
+    }
+    std::mutex mtx;
+    task_pool pool(options.threads_count);
+    for (auto& rel : same_size) {
+        pool.submit([&mtx, &res, &same_content_files, &rel, &source_dir, &target_dir] {
+            bool same = same_content(join(source_dir, rel), join(target_dir, rel));
+            std::lock_guard<std::mutex> guard{mtx};
+            if (same) {
+                same_content_files.push_back(rel);
+            } else {
+                res.emplace_back(tree_change_kind::modified, rel, file_type::regular_file);
+            }
+        });
+    }
+    pool.wait();
+    std::stable_sort(res.begin(), res.end(), [](const tree_change& a, const tree_change& b) {
+        return a.relpath < b.relpath;
+    });
+    return res;
+}
+
+std::string read_symlink(const std::string& link_path, uint64_t size_hint) {
+#ifdef STATICLIB_WINDOWS
+    (void) size_hint;
+    throw tinydir_exception(TRACEMSG("Mirroring symbolic links is not supported on Windows," +
+            " path: [" + link_path + "]"));
+#else // !STATICLIB_WINDOWS
+    auto buf = std::vector<char>(static_cast<size_t> (size_hint) + 2);
+    for (;;) {
+        auto len = ::readlink(link_path.c_str(), buf.data(), buf.size());
+        if (-1 == len) throw tinydir_exception(TRACEMSG("Error reading symbolic link," +
+                " path: [" + link_path + "], error: [" + ::strerror(errno) + "]"));
+        if (static_cast<size_t> (len) < buf.size()) {
+            return std::string(buf.data(), static_cast<size_t> (len));
+        }
+        buf.resize(buf.size() * 2);
+    }
+#endif // STATICLIB_WINDOWS
+}
+
+// "create_symlink" gives the link a current time, that would be reported
+// as modified by the next diff
+void set_symlink_modification_time(const std::string& link_path, int64_t mtime_ns) {
+#ifdef STATICLIB_WINDOWS
+    (void) link_path;
+    (void) mtime_ns;
+#else // !STATICLIB_WINDOWS
+    struct timespec times[2];
+    times[0].tv_sec = static_cast<time_t> (mtime_ns / 1000000000);
+    times[0].tv_nsec = static_cast<long> (mtime_ns % 1000000000);
+    times[1] = times[0];
+    STATICLIB_TINYDIR_IO_BEGIN(probe, set_times, link_path);
+    auto err = ::utimensat(AT_FDCWD, link_path.c_str(), times, AT_SYMLINK_NOFOLLOW);
+    STATICLIB_TINYDIR_IO_END(probe, 0, 0 != err);
+    if (0 != err) throw tinydir_exception(TRACEMSG("Error setting symbolic link modification time," +
+            " path: [" + link_path + "], error: [" + ::strerror(errno) + "]"));
+#endif // STATICLIB_WINDOWS
+}
+
+bool has_removed_parent(const std::set<std::string>& removed_dirs, const std::string& relpath) {
+    auto pos = relpath.find('/');
+    while (std::string::npos != pos) {
+        if (removed_dirs.count(relpath.substr(0, pos)) > 0) {
+            return true;
+        }
+        pos = relpath.find('/', pos + 1);
+    }
+    return false;
+}
+
+} // namespace
+
+tree_snapshot::tree_snapshot(std::vector<tree_entry> entries) :
+entries_list(std::move(entries)) {
+    std::sort(entries_list.begin(), entries_list.end(), entry_less);
+}
+
+const std::vector<tree_entry>& tree_snapshot::entries() const {
+    return entries_list;
+}
+
+const tree_entry* tree_snapshot::find(const std::string& relpath) const {
+    auto key = tree_entry();
+    key.relpath = relpath;
+    auto it = std::lower_bound(entries_list.begin(), entries_list.end(), key, entry_less);
+    if (entries_list.end() != it && relpath == it->relpath) {
+        return std::addressof(*it);
+    }
+    return nullptr;
+}
+
+void tree_snapshot::save(const std::string& file_path) const {
+    auto sink = file_sink(file_path);
+    auto line = std::string();
+    line.append(snapshot_header).push_back('\n');
+    for (auto& en : entries_list) {
+        if (std::string::npos != en.relpath.find('\n')) throw tinydir_exception(TRACEMSG(
+                "Cannot save entry with a line break in its name, path: [" + en.relpath + "]"));
+        auto& st = en.status;
+        line.push_back(type_to_char(st.type));
+        line.append(" " + sl::support::to_string(st.size));
+        line.append(" " + sl::support::to_string(st.allocated_size));
+        line.append(" " + sl::support::to_string(st.mtime_ns));
+        line.append(" " + sl::support::to_string(st.mode));
+        line.append(" " + sl::support::to_string(st.device));
+        line.append(" " + sl::support::to_string(st.inode));
+        line.append(" " + sl::support::to_string(st.links_count));
+        line.append(" " + en.relpath);
+        line.push_back('\n');
+        if (line.length() >= (1 << 16)) {
+            sl::io::write_all(sink, {line.data(), line.length()});
+            line.clear();
+        }
+    }
+    sl::io::write_all(sink, {line.data(), line.length()});
+}
+
+tree_snapshot tree_snapshot::load(const std::string& file_path) {
+    auto src = file_source(file_path);
+    auto sink = sl::io::string_sink();
+    sl::io::copy_all(src, sink);
+    auto& data = sink.get_string();
+    auto entries = std::vector<tree_entry>();
+    size_t pos = 0;
+    bool header_checked = false;
+    while (pos < data.length()) {
+        auto end = data.find('\n', pos);
+        if (std::string::npos == end) {
+            end = data.length();
+        }
+        auto line = data.substr(pos, end - pos);
+        pos = end + 1;
+        if (!header_checked) {
+            if (snapshot_header != line) throw tinydir_exception(TRACEMSG(
+                    "Invalid snapshot file header, path: [" + file_path + "]"));
+            header_checked = true;
+            continue;
+        }
+        if (line.empty()) continue;
+        auto en = tree_entry();
+        en.status.type = char_to_type(line[0]);
+        const char* cur = line.c_str() + 1;
+        auto read_num = [&cur, &line, &file_path]() -> uint64_t {
+            char* num_end = nullptr;
+            auto num = std::strtoull(cur, std::addressof(num_end), 10);
+            if (num_end == cur || ' ' != *num_end) throw tinydir_exception(TRACEMSG(
+                    "Invalid snapshot file line: [" + line + "], path: [" + file_path + "]"));
+            cur = num_end + 1;
+            return static_cast<uint64_t> (num);
+        };
+        en.status.size = read_num();
+        en.status.allocated_size = read_num();
+        en.status.mtime_ns = static_cast<int64_t> (read_num());
+        en.status.mode = static_cast<uint32_t> (read_num());
+        en.status.device = read_num();
+        en.status.inode = read_num();
+        en.status.links_count = read_num();
+        en.relpath = std::string(cur);
+        entries.emplace_back(std::move(en));
+    }
+    if (!header_checked) throw tinydir_exception(TRACEMSG(
+            "Invalid empty snapshot file, path: [" + file_path + "]"));
+    return tree_snapshot(std::move(entries));
+}
+
+tree_snapshot snapshot_tree(const std::string& root_dir, size_t threads_count) {
+    auto root = normalize_path(root_dir);
+    if (file_type::directory != status(root).type) throw tinydir_exception(TRACEMSG(
+            "Invalid tree root directory, path: [" + root_dir + "]"));
+    std::mutex mtx;
+    auto entries = std::vector<tree_entry>();
+    std::function<void(const std::string&, const std::string&)> walk;
+    task_pool pool(threads_count);
+    walk = [&walk, &pool, &mtx, &entries](const std::string& dirpath, const std::string& relprefix) {
+        auto local = std::vector<tree_entry>();
+        for (auto& ch : list_directory(dirpath)) {
+            auto en = tree_entry();
+            en.relpath = relprefix + ch.filename();
+            en.status = ch.symlink_status();
+            // entry removed concurrently
+            if (file_type::not_found == en.status.type) continue;
+            if (file_type::directory == en.status.type) {
+                auto child = ch.filepath();
+                auto child_prefix = en.relpath + "/";
+                pool.submit([&walk, child, child_prefix] {
+                    walk(child, child_prefix);
+                });
+            }
+            local.emplace_back(std::move(en));
+        }
+        std::lock_guard<std::mutex> guard{mtx};
+        std::move(local.begin(), local.end(), std::back_inserter(entries));
+    };
+    pool.submit([&walk, &root] {
+        walk(root, "");
+    });
+    pool.wait();
+    return tree_snapshot(std::move(entries));
+}
+
+std::vector<tree_change> diff_trees(const tree_snapshot& source, const tree_snapshot& target,
+        const tree_diff_options& options) {
+    auto same_size = std::vector<std::string>();
+    return diff_snapshots(source, target, options.compare_mtime, same_size);
+}
+
+std::vector<tree_change> diff_trees(const std::string& source_dir, const std::string& target_dir,
+        const tree_diff_options& options) {
+    auto source = snapshot_tree(source_dir, options.threads_count);
+    auto target = snapshot_tree(target_dir, options.threads_count);
+    auto same_content_files = std::vector<std::string>();
+    return diff_dirs(source, target, normalize_path(source_dir), normalize_path(target_dir), options,
+            same_content_files);
+}
+
+std::vector<tree_change> mirror_tree(const std::string& source_dir, const std::string& target_dir,
+        const tree_diff_options& options) {
+    auto sdir = normalize_path(source_dir);
+    auto tdir = normalize_path(target_dir);
+    if (file_type::not_found == status(tdir).type) {
+        create_directory(tdir);
+    }
+    auto source = snapshot_tree(sdir, options.threads_count);
+    auto target = snapshot_tree(tdir, options.threads_count);
+    auto same_content_files = std::vector<std::string>();
+    auto changes = diff_dirs(source, target, sdir, tdir, options, same_content_files);
+
+    // otherwise these files are reported again by the next sync that compares times
+    for (auto& rel : same_content_files) {
+        auto mtime = source.find(rel)->status.mtime_ns;
+        if (mtime != target.find(rel)->status.mtime_ns) {
+            set_modification_time(join(tdir, rel), mtime);
+        }
+    }
+
+    // descendants of a removed directory are deleted together with it
+    auto removed_dirs = std::set<std::string>();
+    for (auto& ch : changes) {
+        if (tree_change_kind::removed != ch.kind) continue;
+        if (has_removed_parent(removed_dirs, ch.relpath)) continue;
+        path(join(tdir, ch.relpath)).remove();
+        if (file_type::directory == ch.type) {
+            removed_dirs.insert(ch.relpath);
+        }
+    }
+
+    // directories and symlinks are created sequentially, parents first
+    for (auto& ch : changes) {
+        if (tree_change_kind::removed == ch.kind) continue;
+        auto tpath = join(tdir, ch.relpath);
+        if (file_type::directory == ch.type) {
+            create_directory(tpath);
+        } else if (file_type::symlink == ch.type) {
+            auto spath = join(sdir, ch.relpath);
+            auto& sst = source.find(ch.relpath)->status;
+            auto dest = read_symlink(spath, sst.size);
+            if (tree_change_kind::modified == ch.kind) {
+                path(tpath).remove();
+            }
+            create_symlink(dest, tpath);
+            set_symlink_modification_time(tpath, sst.mtime_ns);
+        }
+    }
+
+    // regular files are copied in parallel
+    task_pool pool(options.threads_count);
+    for (auto& ch : changes) {
+        if (tree_change_kind::removed == ch.kind || file_type::regular_file != ch.type) continue;
+        auto spath = join(sdir, ch.relpath);
+        auto tpath = join(tdir, ch.relpath);
+        pool.submit([spath, tpath] {
+            // modification time is preserved
+            const char* failed_op = nullptr;
+            auto ec = copy_regular_file(spath, tpath, true, failed_op);
+            if (ec) throw tinydir_exception(TRACEMSG(std::string(failed_op) + ": [" + spath + "]," +
+                    " target: [" + tpath + "]," +
+                    " error: [" + ec.message() + "]"));
+        });
+    }
+    pool.wait();
+    return changes;
+}
+
+} // namespace
+}
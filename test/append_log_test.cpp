@@ -0,0 +1,140 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   append_log_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 3:55 AM
+ */
+
+#include "staticlib/tinydir/append_log.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "append_log_test";
+
+std::string make_record(size_t thread, size_t idx) {
+    // variable length, no zero bytes
+    return sl::support::to_string(thread) + ":" + sl::support::to_string(idx) +
+            std::string(idx % 7, 'x') + "\n";
+}
+
+void test_concurrent() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_log.file";
+    {
+        auto sink = sl::tinydir::file_sink(filename);
+        sl::io::write_all(sink, {"head\n", 5});
+    }
+    // not movable, shared by writer threads
+    sl::tinydir::append_log log(filename);
+    slassert(filename == log.path());
+    slassert(5 == log.size());
+    slassert(5 == log.committed_size());
+
+    const size_t threads_count = 8;
+    const size_t records_count = 1000;
+    auto offsets = std::vector<std::vector<uint64_t>>(threads_count);
+    auto threads = std::vector<std::thread>();
+    for (size_t t = 0; t < threads_count; t++) {
+        threads.emplace_back([&log, &offsets, t, records_count] {
+            for (size_t i = 0; i < records_count; i++) {
+                auto rec = make_record(t, i);
+                offsets[t].push_back(log.append({rec.data(), rec.length()}));
+            }
+        });
+    }
+
+    // committed prefix never contains unwritten ranges
+    std::atomic<bool> done(false);
+    std::atomic<size_t> holes(0);
+    auto reader = std::thread([&log, &done, &holes, &filename] {
+        auto buf = std::vector<char>(1 << 16);
+        while (!done.load()) {
+            auto committed = log.committed_size();
+            auto src = sl::tinydir::file_source(filename);
+            uint64_t pos = 0;
+            while (pos < committed) {
+                auto read = src.read({buf.data(), buf.size()});
+                if (std::char_traits<char>::eof() == read) break;
+                auto len = std::min(static_cast<uint64_t> (read), committed - pos);
+                for (size_t i = 0; i < len; i++) {
+                    if ('\0' == buf[i]) {
+                        holes.fetch_add(1);
+                    }
+                }
+                pos += len;
+            }
+            if (pos < committed) {
+                holes.fetch_add(1);
+            }
+        }
+    });
+    for (auto& th : threads) {
+        th.join();
+    }
+    done.store(true);
+    reader.join();
+    slassert(0 == holes.load());
+
+    slassert(log.size() == log.committed_size());
+    slassert(!log.is_broken());
+    log.sync();
+    auto data = read_file(filename);
+    slassert(data.length() == log.size());
+    slassert("head\n" == data.substr(0, 5));
+    for (size_t t = 0; t < threads_count; t++) {
+        for (size_t i = 0; i < records_count; i++) {
+            auto rec = make_record(t, i);
+            slassert(rec == data.substr(static_cast<size_t> (offsets[t][i]), rec.length()));
+        }
+    }
+
+    // empty record
+    slassert(log.size() == log.append({"", 0}));
+}
+
+int main() {
+    try {
+        test_concurrent();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
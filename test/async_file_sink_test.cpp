@@ -0,0 +1,175 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   async_file_sink_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 3:10 AM
+ */
+
+#include "staticlib/tinydir/async_file_sink.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "async_file_sink_test";
+
+std::string make_line(size_t thread, size_t idx) {
+    return sl::support::to_string(thread) + ":" + sl::support::to_string(idx) + "\n";
+}
+
+// lines of every thread must be in order
+void check_lines(const std::string& data, size_t threads_count, size_t lines_count) {
+    auto next = std::vector<size_t>(threads_count, 0);
+    std::istringstream st(data);
+    std::string line;
+    while (std::getline(st, line)) {
+        auto pos = line.find(':');
+        slassert(std::string::npos != pos);
+        auto th = static_cast<size_t> (std::stoul(line.substr(0, pos)));
+        auto idx = static_cast<size_t> (std::stoul(line.substr(pos + 1)));
+        slassert(th < threads_count);
+        slassert(next[th] == idx);
+        next[th] += 1;
+    }
+    for (auto n : next) {
+        slassert(lines_count == n);
+    }
+}
+
+void write_concurrently(sl::tinydir::async_file_sink& sink, size_t threads_count, size_t lines_count) {
+    auto threads = std::vector<std::thread>();
+    for (size_t t = 0; t < threads_count; t++) {
+        threads.emplace_back([&sink, t, lines_count] {
+            for (size_t i = 0; i < lines_count; i++) {
+                auto line = make_line(t, i);
+                if (0 == i % 2) {
+                    sl::io::write_all(sink, {line.data(), line.length()});
+                } else {
+                    sink.write_buffer(std::move(line));
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+void test_block() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_block.file";
+    auto opts = sl::tinydir::async_sink_options();
+    opts.queue_size = 8;
+    opts.max_batch_size = 64;
+    auto sink = sl::tinydir::async_file_sink(filename, sl::tinydir::file_sink::open_mode::create, opts);
+    slassert(filename == sink.path());
+    write_concurrently(sink, 4, 1000);
+    sink.flush();
+    auto data = read_file(filename);
+    check_lines(data, 4, 1000);
+
+    // flush waits for the data written before it
+    sl::io::write_all(sink, {"foo", 3});
+    sink.flush();
+    slassert(static_cast<off_t> (data.length() + 3) == sl::tinydir::file_source(filename).size());
+
+    auto moved = std::move(sink);
+    sl::io::write_all(moved, {"bar", 3});
+    moved.close();
+    slassert(data + "foobar" == read_file(filename));
+    slassert(0 == moved.dropped_bytes());
+
+    bool thrown = false;
+    try {
+        sl::io::write_all(moved, {"baz", 3});
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_grow() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_grow.file";
+    auto opts = sl::tinydir::async_sink_options();
+    opts.queue_size = 2;
+    opts.backpressure = sl::tinydir::async_backpressure::grow;
+    {
+        auto sink = sl::tinydir::async_file_sink(sl::tinydir::file_sink(filename), opts);
+        write_concurrently(sink, 8, 2000);
+    }
+    check_lines(read_file(filename), 8, 2000);
+}
+
+void test_drop() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_drop.file";
+    auto opts = sl::tinydir::async_sink_options();
+    opts.queue_size = 2;
+    opts.backpressure = sl::tinydir::async_backpressure::drop;
+    auto sink = sl::tinydir::async_file_sink(filename, sl::tinydir::file_sink::open_mode::create, opts);
+    auto line = std::string(100, 'a');
+    for (size_t i = 0; i < 1000; i++) {
+        sl::io::write_all(sink, {line.data(), line.length()});
+        if (0 == i % 100) {
+            sink.flush();
+        }
+    }
+    sink.close();
+    auto written = read_file(filename).length();
+    slassert(0 == written % line.length());
+    slassert(written + sink.dropped_bytes() == line.length() * 1000);
+}
+
+int main() {
+    try {
+        test_block();
+        test_grow();
+        test_drop();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   tinydir_bench.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 3:30 PM
+ */
+
+/*
+ * Benchmark for directory and file IO hot paths, generates a synthetic
+ * tree under the specified work directory and prints the results as JSON.
+ * Work directory defaults to "tinydir_bench_work" under the system temp
+ * directory (TMPDIR, TMP or TEMP environment variable, "/tmp" on POSIX when
+ * none is set), it must not exist and is removed after the run.
+ *
+ * Usage: staticlib_tinydir_test_bench [--dir path] [--depth n] [--fanout n]
+ *        [--files n] [--file-size bytes] [--chunk-size bytes] [--rounds n]
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/tinydir.hpp"
+
+namespace { // anonymous
+
+const std::string usage = "Usage: staticlib_tinydir_test_bench [--dir path] [--depth n] [--fanout n]"
+        " [--files n] [--file-size bytes] [--chunk-size bytes] [--rounds n]";
+
+std::string default_work_dir() {
+    for (auto var : {"TMPDIR", "TMP", "TEMP"}) {
+        auto val = std::getenv(var);
+        if (nullptr != val && '\0' != val[0]) {
+            return std::string(val) + "/tinydir_bench_work";
+        }
+    }
+#ifdef STATICLIB_WINDOWS
+    return "tinydir_bench_work";
+#else // !STATICLIB_WINDOWS
+    return "/tmp/tinydir_bench_work";
+#endif // STATICLIB_WINDOWS
+}
+
+struct bench_config {
+    std::string dir = default_work_dir();
+    size_t depth = 2;
+    size_t fanout = 4;
+    size_t files = 16;
+    size_t file_size = 64 * 1024;
+    size_t chunk_size = 64 * 1024;
+    size_t rounds = 3;
+};
+
+struct bench_result {
+    std::string name;
+    std::vector<double> latencies_us;
+    uint64_t bytes = 0;
+    double total_us = 0;
+};
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsed_us(bench_clock::time_point start) {
+    auto dur = bench_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(dur).count();
+}
+
+void measure(bench_result& res, const std::function<uint64_t()>& op) {
+    auto start = bench_clock::now();
+    auto bytes = op();
+    auto us = elapsed_us(start);
+    res.latencies_us.push_back(us);
+    res.total_us += us;
+    res.bytes += bytes;
+}
+
+double percentile(const std::vector<double>& sorted, double pc) {
+    if (sorted.empty()) return 0;
+    auto idx = static_cast<size_t> (pc / 100.0 * static_cast<double> (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+std::string json_num(double num) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3) << num;
+    return ss.str();
+}
+
+std::string to_json(const bench_config& cf, const std::vector<bench_result>& results) {
+    auto res = std::string();
+    res.append("{\n");
+    res.append("  \"config\": {\n");
+    res.append("    \"depth\": " + sl::support::to_string(cf.depth) + ",\n");
+    res.append("    \"fanout\": " + sl::support::to_string(cf.fanout) + ",\n");
+    res.append("    \"files_per_dir\": " + sl::support::to_string(cf.files) + ",\n");
+    res.append("    \"file_size\": " + sl::support::to_string(cf.file_size) + ",\n");
+    res.append("    \"chunk_size\": " + sl::support::to_string(cf.chunk_size) + ",\n");
+    res.append("    \"rounds\": " + sl::support::to_string(cf.rounds) + "\n");
+    res.append("  },\n");
+    res.append("  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        auto& re = results[i];
+        auto sorted = re.latencies_us;
+        std::sort(sorted.begin(), sorted.end());
+        auto secs = re.total_us / 1000000.0;
+        res.append("    {\n");
+        res.append("      \"name\": \"" + re.name + "\",\n");
+        res.append("      \"ops\": " + sl::support::to_string(sorted.size()) + ",\n");
+        res.append("      \"bytes\": " + sl::support::to_string(re.bytes) + ",\n");
+        res.append("      \"total_us\": " + json_num(re.total_us) + ",\n");
+        res.append("      \"ops_per_sec\": " + json_num(secs > 0 ? static_cast<double> (sorted.size()) / secs : 0) + ",\n");
+        res.append("      \"mb_per_sec\": " + json_num(secs > 0 ? static_cast<double> (re.bytes) / (1024 * 1024) / secs : 0) + ",\n");
+        res.append("      \"latency_us\": {");
+        res.append("\"p50\": " + json_num(percentile(sorted, 50)) + ", ");
+        res.append("\"p90\": " + json_num(percentile(sorted, 90)) + ", ");
+        res.append("\"p99\": " + json_num(percentile(sorted, 99)) + ", ");
+        res.append("\"max\": " + json_num(sorted.empty() ? 0 : sorted.back()) + "}\n");
+        res.append(i < results.size() - 1 ? "    },\n" : "    }\n");
+    }
+    res.append("  ]\n");
+    res.append("}\n");
+    return res;
+}
+
+void generate_dirs(const bench_config& cf, const std::string& dir, size_t level, std::vector<std::string>& dirs) {
+    dirs.push_back(dir);
+    if (level == cf.depth) return;
+    for (size_t i = 0; i < cf.fanout; i++) {
+        auto child = dir + "/d" + sl::support::to_string(i);
+        sl::tinydir::create_directory(child);
+        generate_dirs(cf, child, level + 1, dirs);
+    }
+}
+
+size_t parse_number(const std::string& name, const std::string& val) {
+    // strtoull accepts leading whitespace and sign
+    if (val.empty() || std::string::npos != val.find_first_not_of("0123456789")) {
+        throw std::runtime_error("Invalid value: [" + val + "] for argument: [" + name + "]\n" + usage);
+    }
+    errno = 0;
+    auto res = std::strtoull(val.c_str(), nullptr, 10);
+    if (ERANGE == errno || res > static_cast<unsigned long long> (std::numeric_limits<size_t>::max())) {
+        throw std::runtime_error("Value out of range: [" + val + "] for argument: [" + name + "]\n" + usage);
+    }
+    return static_cast<size_t> (res);
+}
+
+bench_config parse_args(int argc, char** argv) {
+    auto cf = bench_config();
+    for (int i = 1; i < argc; i += 2) {
+        auto name = std::string(argv[i]);
+        if (i + 1 == argc) {
+            throw std::runtime_error("Missing value for argument: [" + name + "]\n" + usage);
+        }
+        auto val = std::string(argv[i + 1]);
+        if ("--dir" == name) {
+            cf.dir = val;
+        } else if ("--depth" == name) {
+            cf.depth = parse_number(name, val);
+        } else if ("--fanout" == name) {
+            cf.fanout = parse_number(name, val);
+        } else if ("--files" == name) {
+            cf.files = parse_number(name, val);
+        } else if ("--file-size" == name) {
+            cf.file_size = parse_number(name, val);
+        } else if ("--chunk-size" == name) {
+            cf.chunk_size = std::max(parse_number(name, val), static_cast<size_t> (1));
+        } else if ("--rounds" == name) {
+            cf.rounds = std::max(parse_number(name, val), static_cast<size_t> (1));
+        } else {
+            throw std::runtime_error("Invalid argument: [" + name + "]\n" + usage);
+        }
+    }
+    return cf;
+}
+
+std::vector<bench_result> run(const bench_config& cf) {
+    auto results = std::map<std::string, bench_result>();
+    auto names = std::vector<std::string>{
+        "file_sink_write", "file_source_read", "list_directory", "path_construct", "copy_file", "remove"
+    };
+    for (auto& na : names) {
+        results[na].name = na;
+    }
+    auto chunk = std::vector<char>(cf.chunk_size, 'x');
+    auto buf = std::vector<char>(cf.chunk_size);
+
+    for (size_t round = 0; round < cf.rounds; round++) {
+        sl::tinydir::create_directory(cf.dir);
+        auto deferred = sl::support::defer([&cf]() STATICLIB_NOEXCEPT {
+            sl::tinydir::path(cf.dir).remove_quietly();
+        });
+        auto dirs = std::vector<std::string>();
+        generate_dirs(cf, cf.dir, 0, dirs);
+        auto files = std::vector<std::string>();
+        for (auto& di : dirs) {
+            for (size_t i = 0; i < cf.files; i++) {
+                files.push_back(di + "/f" + sl::support::to_string(i) + ".dat");
+            }
+        }
+
+        for (auto& fi : files) {
+            measure(results["file_sink_write"], [&] {
+                auto sink = sl::tinydir::file_sink(fi);
+                size_t written = 0;
+                while (written < cf.file_size) {
+                    auto len = std::min(chunk.size(), cf.file_size - written);
+                    written += static_cast<size_t> (sink.write({chunk.data(), len}));
+                }
+                return static_cast<uint64_t> (written);
+            });
+        }
+        for (auto& fi : files) {
+            measure(results["file_source_read"], [&] {
+                auto src = sl::tinydir::file_source(fi);
+                uint64_t read_bytes = 0;
+                for (;;) {
+                    auto read = src.read({buf.data(), buf.size()});
+                    if (std::char_traits<char>::eof() == read) break;
+                    read_bytes += static_cast<uint64_t> (read);
+                }
+                return read_bytes;
+            });
+        }
+        for (auto& di : dirs) {
+            measure(results["list_directory"], [&] {
+                auto entries = sl::tinydir::list_directory(di);
+                (void) entries;
+                return static_cast<uint64_t> (0);
+            });
+        }
+        for (auto& fi : files) {
+            measure(results["path_construct"], [&] {
+                auto pa = sl::tinydir::path(fi);
+                (void) pa;
+                return static_cast<uint64_t> (0);
+            });
+        }
+        for (auto& fi : files) {
+            auto pa = sl::tinydir::path(fi);
+            measure(results["copy_file"], [&] {
+                pa.copy_file(fi + ".copy");
+                return static_cast<uint64_t> (cf.file_size);
+            });
+        }
+        for (auto& fi : files) {
+            auto pa = sl::tinydir::path(fi + ".copy");
+            measure(results["remove"], [&] {
+                pa.remove();
+                return static_cast<uint64_t> (0);
+            });
+        }
+    }
+
+    auto res = std::vector<bench_result>();
+    for (auto& na : names) {
+        res.emplace_back(std::move(results[na]));
+    }
+    return res;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto cf = parse_args(argc, argv);
+        auto results = run(cf);
+        std::cout << to_json(cf, results);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
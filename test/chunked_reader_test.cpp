@@ -0,0 +1,287 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   chunked_reader_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 10:20 PM
+ */
+
+#include "staticlib/tinydir/chunked_reader.hpp"
+
+#include <array>
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "chunked_reader_test";
+
+std::string make_lines(size_t count) {
+    auto res = std::string();
+    for (size_t i = 0; i < count; i++) {
+        res.append("line " + sl::support::to_string(i) + " ");
+        res.append(i % 13, 'x');
+        res.push_back('\n');
+    }
+    return res;
+}
+
+std::string read_all(sl::tinydir::chunk_source& src, size_t chunk) {
+    auto res = std::string();
+    auto buf = std::string(chunk, '\0');
+    for (;;) {
+        auto read = src.read({std::addressof(buf.front()), buf.length()});
+        if (std::char_traits<char>::eof() == read) break;
+        slassert(read > 0);
+        res.append(buf.data(), static_cast<size_t> (read));
+    }
+    return res;
+}
+
+void test_split() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_split.file";
+    auto data = make_lines(5000);
+    write_file(filename, data);
+
+    auto opts = sl::tinydir::chunked_read_options();
+    opts.chunks_count = 7;
+    opts.min_chunk_size = 1;
+    auto plain = sl::tinydir::split_file(filename, opts);
+    slassert(7 == plain.size());
+    uint64_t next = 0;
+    for (size_t i = 0; i < plain.size(); i++) {
+        slassert(i == plain[i].index);
+        slassert(next == plain[i].offset);
+        slassert(plain[i].length > 0);
+        next += plain[i].length;
+    }
+    slassert(data.length() == next);
+
+    opts.align_to_delimiter = true;
+    auto aligned = sl::tinydir::split_file(filename, opts);
+    slassert(aligned.size() > 1);
+    next = 0;
+    for (auto& ch : aligned) {
+        slassert(next == ch.offset);
+        next += ch.length;
+        slassert('\n' == data[static_cast<size_t> (next - 1)]);
+    }
+    slassert(data.length() == next);
+
+    // single record cannot be split
+    auto single = dir + "/tmp_single.file";
+    write_file(single, std::string(10000, 'a'));
+    slassert(1 == sl::tinydir::split_file(single, opts).size());
+
+    // small file is not split below min size
+    opts.min_chunk_size = data.length() / 2;
+    slassert(sl::tinydir::split_file(filename, opts).size() <= 2);
+
+    // empty file
+    auto empty = dir + "/tmp_empty.file";
+    write_file(empty, "");
+    slassert(sl::tinydir::split_file(empty, opts).empty());
+}
+
+void test_source() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_source.file";
+    auto data = make_lines(3000);
+    write_file(filename, data);
+
+    auto chunk = sl::tinydir::file_chunk(0, 1001, 20000);
+    auto expected = data.substr(1001, 20000);
+    {
+        // buffered reads
+        auto src = sl::tinydir::chunk_source(filename, chunk, 4096);
+        slassert(filename == src.path());
+        slassert(1001 == src.chunk().offset);
+        slassert(expected == read_all(src, 1000));
+        std::array<char, 1> one;
+        slassert(std::char_traits<char>::eof() == src.read(one));
+    }
+    {
+        // reads bypassing the buffer
+        auto src = sl::tinydir::chunk_source(filename, chunk, 4096);
+        slassert(expected == read_all(src, 8192));
+    }
+    {
+        // moved source
+        auto src = sl::tinydir::chunk_source(filename, chunk, 4096);
+        auto moved = std::move(src);
+        slassert(expected == read_all(moved, 333));
+    }
+
+    // truncated file
+    auto past_end = sl::tinydir::file_chunk(0, data.length() - 10, 100);
+    auto src = sl::tinydir::chunk_source(filename, past_end, 4096);
+    std::array<char, 64> buf;
+    slassert(10 == src.read(buf));
+    bool thrown = false;
+    try {
+        src.read(buf);
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_read_ordered() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_ordered.file";
+    auto data = make_lines(20000);
+    write_file(filename, data);
+
+    auto opts = sl::tinydir::chunked_read_options();
+    opts.threads_count = 4;
+    opts.chunks_count = 23;
+    opts.min_chunk_size = 1;
+    opts.align_to_delimiter = true;
+    opts.buffer_size = 4096;
+    auto result = std::string();
+    size_t expected_index = 0;
+    sl::tinydir::map_chunks<std::string>(filename, opts, [](sl::tinydir::chunk_source& src) {
+        return read_all(src, 1500);
+    }, [&](const sl::tinydir::file_chunk& chunk, std::string str) {
+        slassert(expected_index == chunk.index);
+        slassert(chunk.length == str.length());
+        slassert('\n' == str.back());
+        expected_index += 1;
+        result.append(str);
+    });
+    slassert(expected_index > 1);
+    slassert(data == result);
+}
+
+void test_read_unordered() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_unordered.file";
+    auto data = make_lines(20000);
+    write_file(filename, data);
+
+    auto opts = sl::tinydir::chunked_read_options();
+    opts.threads_count = 3;
+    opts.chunks_count = 17;
+    opts.min_chunk_size = 1;
+    opts.ordered = false;
+    std::atomic<uint64_t> processed{0};
+    auto seen = std::vector<bool>(17, false);
+    uint64_t consumed = 0;
+    sl::tinydir::read_chunks(filename, opts, [&processed](sl::tinydir::chunk_source& src) {
+        processed.fetch_add(read_all(src, 4096).length());
+    }, [&](const sl::tinydir::file_chunk& chunk) {
+        slassert(!seen[chunk.index]);
+        seen[chunk.index] = true;
+        consumed += chunk.length;
+    });
+    slassert(data.length() == processed.load());
+    slassert(data.length() == consumed);
+    for (bool fl : seen) {
+        slassert(fl);
+    }
+}
+
+void test_read_error() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_error.file";
+    write_file(filename, make_lines(5000));
+
+    auto opts = sl::tinydir::chunked_read_options();
+    opts.threads_count = 2;
+    opts.chunks_count = 10;
+    opts.min_chunk_size = 1;
+    bool thrown = false;
+    try {
+        sl::tinydir::read_chunks(filename, opts, [](sl::tinydir::chunk_source& src) {
+            if (3 == src.chunk().index) {
+                throw std::runtime_error("fail");
+            }
+        });
+    } catch (const std::runtime_error& e) {
+        thrown = std::string("fail") == e.what();
+    }
+    slassert(thrown);
+
+    // consumer error
+    thrown = false;
+    try {
+        sl::tinydir::read_chunks(filename, opts, [](sl::tinydir::chunk_source&) { },
+                [](const sl::tinydir::file_chunk& chunk) {
+            if (5 == chunk.index) {
+                throw std::runtime_error("fail");
+            }
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    slassert(thrown);
+
+    // missing file
+    thrown = false;
+    try {
+        sl::tinydir::read_chunks(dir + "/missing.file", opts, [](sl::tinydir::chunk_source&) { });
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+int main() {
+    try {
+        test_split();
+        test_source();
+        test_read_ordered();
+        test_read_unordered();
+        test_read_error();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   deferred_remover_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 4:45 AM
+ */
+
+#include "staticlib/tinydir/deferred_remover.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/io_stats.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+const std::string dir = "deferred_remover_test";
+
+// returns number of created files and directories
+size_t create_tree(const std::string& root, size_t files_count) {
+    sl::tinydir::create_directories(root + "/sub/nested");
+    for (size_t i = 0; i < files_count; i++) {
+        auto parent = 0 == i % 2 ? root : root + "/sub/nested";
+        auto sink = sl::tinydir::file_sink(parent + "/" + sl::support::to_string(i) + ".file");
+        sink.write({"foo", 3});
+    }
+    return files_count + 3;
+}
+
+void test_remove() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto trash = dir + "/trash";
+    auto remover = sl::tinydir::deferred_remover(trash);
+    slassert(trash == remover.trash_dir());
+    slassert(sl::tinydir::path(trash).is_directory());
+
+    auto data = dir + "/data";
+    auto count = create_tree(data, 50);
+    auto single = dir + "/single.file";
+    sl::tinydir::file_sink(single).write({"bar", 3});
+
+    remover.remove(data);
+    remover.remove(single);
+    // gone from the original location immediately
+    slassert(!sl::tinydir::path(data).exists());
+    slassert(!sl::tinydir::path(single).exists());
+
+    auto moved = std::move(remover);
+    moved.wait();
+    slassert(0 == moved.pending_count());
+    slassert(count + 1 == moved.removals_count());
+    slassert(0 == moved.failures_count());
+    slassert(sl::tinydir::list_directory(trash).empty());
+
+    bool thrown = false;
+    try {
+        moved.remove(dir + "/not_existing");
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_throttle() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto opts = sl::tinydir::deferred_remove_options();
+    opts.max_removals_per_second = 100;
+    auto remover = sl::tinydir::deferred_remover(dir + "/trash", opts);
+    auto data = dir + "/data";
+    auto count = create_tree(data, 20);
+    auto start = std::chrono::steady_clock::now();
+    remover.remove(data);
+    remover.wait();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    slassert(count == remover.removals_count());
+    // first removal is not delayed
+    slassert(elapsed >= std::chrono::milliseconds((count - 1) * 10 - 30));
+}
+
+void test_no_listing() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto remover = sl::tinydir::deferred_remover(dir + "/trash");
+    sl::tinydir::io_stats_reset();
+    for (size_t i = 0; i < 20; i++) {
+        auto file = dir + "/" + sl::support::to_string(i) + ".file";
+        sl::tinydir::file_sink(file).write({"foo", 3});
+        remover.remove(file);
+    }
+    remover.wait();
+    slassert(20 == remover.removals_count());
+    // trash is not listed to reap a single file
+    auto global = sl::tinydir::io_stats_snapshot().get(sl::tinydir::io_op::read_directory).calls;
+    auto local = sl::tinydir::io_stats_thread_snapshot().get(sl::tinydir::io_op::read_directory).calls;
+    slassert(global == local);
+}
+
+void test_recover() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto trash = dir + "/trash";
+    auto data = dir + "/data";
+    create_tree(data, 10);
+    {
+        auto opts = sl::tinydir::deferred_remove_options();
+        opts.max_removals_per_second = 1;
+        auto remover = sl::tinydir::deferred_remover(trash, opts);
+        remover.remove(data);
+        remover.close();
+        slassert(1 == remover.pending_count());
+    }
+    slassert(1 == sl::tinydir::list_directory(trash).size());
+
+    // leftovers are not touched without recovery
+    auto no_recover = sl::tinydir::deferred_remove_options();
+    no_recover.recover = false;
+    {
+        auto remover = sl::tinydir::deferred_remover(trash, no_recover);
+        remover.wait();
+        slassert(0 == remover.removals_count());
+    }
+    slassert(1 == sl::tinydir::list_directory(trash).size());
+
+    auto remover = sl::tinydir::deferred_remover(trash);
+    remover.wait();
+    slassert(sl::tinydir::list_directory(trash).empty());
+}
+
+int main() {
+    try {
+        test_remove();
+        test_throttle();
+        test_no_listing();
+        test_recover();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
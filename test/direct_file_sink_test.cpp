@@ -0,0 +1,125 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   direct_file_sink_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 8:10 PM
+ */
+
+#include "staticlib/tinydir/direct_file_sink.hpp"
+
+#include <iostream>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "direct_file_sink_test";
+
+void test_write() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    // several full buffers and unaligned tail
+    auto data = make_data((1 << 18) * 3 + 1234);
+    auto filename = dir + "/tmp_write.file";
+    {
+        auto sink = sl::tinydir::direct_file_sink(filename, 1 << 16);
+        slassert(filename == sink.path());
+        size_t pos = 0;
+        size_t step = 1;
+        while (pos < data.length()) {
+            auto len = std::min(step, data.length() - pos);
+            slassert(static_cast<std::streamsize> (len) == sink.write({data.data() + pos, len}));
+            pos += len;
+            step = step * 3 + 1;
+        }
+        sink.flush();
+        sink.finish();
+        // no-op on closed file
+        sink.finish();
+    }
+    slassert(data.length() == static_cast<size_t> (sl::tinydir::file_source(filename).size()));
+    slassert(data == read_file(filename));
+
+    // tail written on destruction
+    {
+        auto sink = sl::tinydir::direct_file_sink(filename);
+        sink.write({"foo", 3});
+    }
+    slassert("foo" == read_file(filename));
+
+    // empty file
+    {
+        auto sink = sl::tinydir::direct_file_sink(filename);
+        sink.finish();
+    }
+    slassert(0 == sl::tinydir::file_source(filename).size());
+
+    bool thrown = false;
+    try {
+        sl::tinydir::direct_file_sink(dir + "/foo/bar.file");
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_move() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto data = make_data(10000);
+    auto filename = dir + "/tmp_move.file";
+    {
+        auto sink = sl::tinydir::direct_file_sink(filename, 4096);
+        sink.write({data.data(), 5000});
+        auto moved = std::move(sink);
+        moved.write({data.data() + 5000, 5000});
+        bool thrown = false;
+        try {
+            sink.write({"foo", 3});
+        } catch (const sl::tinydir::tinydir_exception&) {
+            thrown = true;
+        }
+        slassert(thrown);
+    }
+    slassert(data == read_file(filename));
+}
+
+int main() {
+    try {
+        test_write();
+        test_move();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   direct_file_source_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 8:20 PM
+ */
+
+#include "staticlib/tinydir/direct_file_source.hpp"
+
+#include <array>
+#include <iostream>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "direct_file_source_test";
+
+std::string read_direct(const std::string& path, size_t buffer_size, size_t chunk) {
+    auto src = sl::tinydir::direct_file_source(path, buffer_size);
+    slassert(path == src.path());
+    auto res = std::string();
+    auto buf = std::string(chunk, '\0');
+    for (;;) {
+        auto read = src.read({std::addressof(buf.front()), buf.length()});
+        if (std::char_traits<char>::eof() == read) break;
+        slassert(read > 0);
+        res.append(buf.data(), static_cast<size_t> (read));
+    }
+    // EOF is sticky
+    std::array<char, 1> one;
+    slassert(std::char_traits<char>::eof() == src.read(one));
+    return res;
+}
+
+void test_read() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_read.file";
+    // unaligned size
+    auto data = make_data((1 << 16) * 5 + 777);
+    write_file(filename, data);
+    slassert(data == read_direct(filename, 1 << 16, 1000));
+    slassert(data == read_direct(filename, 4096, 1 << 20));
+    slassert(data == read_direct(filename, 1 << 20, 1));
+
+    // size is a multiple of buffer size
+    data = make_data(4096 * 4);
+    write_file(filename, data);
+    slassert(data == read_direct(filename, 4096, 4096));
+
+    // empty file
+    write_file(filename, "");
+    slassert(read_direct(filename, 4096, 10).empty());
+
+    // sl::io compatible
+    write_file(filename, "foobar");
+    auto src = sl::tinydir::direct_file_source(filename);
+    auto moved = std::move(src);
+    auto sink = sl::io::string_sink();
+    sl::io::copy_all(moved, sink);
+    slassert("foobar" == sink.get_string());
+
+    bool thrown = false;
+    try {
+        sl::tinydir::direct_file_source(dir + "/foo.file");
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+int main() {
+    try {
+        test_read();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
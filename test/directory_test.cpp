@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   directory_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 4:50 PM
+ */
+
+#include "staticlib/tinydir/directory.hpp"
+
+#include <iostream>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+const std::string root = "directory_test_dir";
+
+std::string read_all(sl::tinydir::file_source src) {
+    auto sink = sl::io::string_sink();
+    sl::io::copy_all(src, sink);
+    return sink.get_string();
+}
+
+void test_files() {
+    sl::tinydir::create_directory(root);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(root).remove_quietly();
+    });
+    auto dir = sl::tinydir::directory(root);
+    slassert(root == dir.path());
+    dir.create_directory("foo");
+    {
+        auto sink = dir.open_write("foo/1.txt");
+        sink.write({"foo", 3});
+        slassert(root + "/foo/1.txt" == sink.path());
+    }
+    {
+        auto sink = dir.open_write("foo/1.txt", sl::tinydir::file_sink::open_mode::append);
+        sink.write({"bar", 3});
+    }
+    slassert("foobar" == read_all(dir.open_read("foo/1.txt")));
+    slassert("foobar" == read_all(sl::tinydir::file_source(root + "/foo/1.txt")));
+
+    auto st = dir.stat("foo/1.txt");
+    slassert(sl::tinydir::file_type::regular_file == st.type);
+    slassert(6 == st.size);
+    slassert(sl::tinydir::file_type::directory == dir.stat("foo").type);
+    slassert(sl::tinydir::file_type::not_found == dir.stat("bar").type);
+
+    bool thrown = false;
+    try {
+        dir.open_read("bar.txt");
+    } catch (const sl::tinydir::tinydir_exception& e) {
+        thrown = true;
+        slassert(std::string::npos != std::string(e.what()).find(root + "/bar.txt"));
+    }
+    slassert(thrown);
+}
+
+void test_list_rename_remove() {
+    sl::tinydir::create_directory(root);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(root).remove_quietly();
+    });
+    auto dir = sl::tinydir::directory(root);
+    dir.create_directory("b");
+    dir.open_write("c.txt");
+    dir.open_write("a.txt");
+    auto sub = dir.open_directory("b");
+    sub.open_write("1.txt");
+    sub.create_directory("2");
+    sub.open_write("2/3.txt");
+
+    auto names = dir.list();
+    slassert(3 == names.size());
+    slassert("a.txt" == names[0]);
+    slassert("b" == names[1]);
+    slassert("c.txt" == names[2]);
+    slassert(2 == sub.list().size());
+
+    dir.rename("a.txt", "d.txt");
+    slassert(sl::tinydir::file_type::not_found == dir.stat("a.txt").type);
+    slassert(sl::tinydir::file_type::regular_file == dir.stat("d.txt").type);
+    dir.rename("d.txt", sub, "4.txt");
+    slassert(sl::tinydir::file_type::regular_file == sub.stat("4.txt").type);
+
+    // handle stays valid after parent rename
+    dir.rename("b", "e");
+    sub.open_write("5.txt");
+    slassert(sl::tinydir::path(root + "/e/5.txt").exists());
+
+    dir.remove("e");
+    slassert(sl::tinydir::file_type::not_found == dir.stat("e").type);
+    dir.remove("c.txt");
+    slassert(dir.list().empty());
+}
+
+void test_remove_symlink() {
+#ifndef STATICLIB_WINDOWS
+    sl::tinydir::create_directory(root);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(root).remove_quietly();
+    });
+    auto dir = sl::tinydir::directory(root);
+    dir.create_directory("target");
+    dir.open_write("target/1.txt");
+    dir.create_directory("sub");
+    sl::tinydir::create_symlink("../target", root + "/sub/link");
+    sl::tinydir::create_symlink("target", root + "/link");
+
+    // links are removed, target contents are not touched
+    dir.remove("sub");
+    dir.remove("link");
+    slassert(sl::tinydir::file_type::not_found == dir.stat("sub").type);
+    slassert(sl::tinydir::file_type::not_found == dir.stat("link").type);
+    slassert(sl::tinydir::file_type::regular_file == dir.stat("target/1.txt").type);
+#endif // !STATICLIB_WINDOWS
+}
+
+int main() {
+    try {
+        test_files();
+        test_list_rename_remove();
+        test_remove_symlink();
+        slassert(!sl::tinydir::path(root).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
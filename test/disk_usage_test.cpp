@@ -0,0 +1,82 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   disk_usage_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 1:40 PM
+ */
+
+#include "staticlib/tinydir/disk_usage.hpp"
+
+#include <cstring>
+#include <iostream>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/tinydir/file_status.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "disk_usage_test";
+
+void test_usage() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    sl::tinydir::create_directory(dir + "/foo");
+    sl::tinydir::create_directory(dir + "/foo/bar");
+    sl::tinydir::create_directory(dir + "/baz");
+    write_file(dir + "/1.txt", std::string(10, 'x'));
+    write_file(dir + "/foo/2.txt", std::string(20, 'x'));
+    write_file(dir + "/foo/bar/3.txt", std::string(30, 'x'));
+
+    auto opts = sl::tinydir::disk_usage_options();
+    opts.threads_count = 3;
+    auto usage = sl::tinydir::disk_usage(dir, opts);
+    auto dirs_size = sl::tinydir::status(dir).size +
+            sl::tinydir::status(dir + "/foo").size +
+            sl::tinydir::status(dir + "/foo/bar").size +
+            sl::tinydir::status(dir + "/baz").size;
+    slassert(dir == usage.dirpath);
+    slassert(60 + dirs_size == usage.apparent_size);
+    slassert(usage.allocated_size >= usage.apparent_size - dirs_size);
+    slassert(7 == usage.inodes_count);
+    slassert(2 == usage.children.size());
+    slassert(dir + "/baz" == usage.children[0].dirpath);
+    slassert(1 == usage.children[0].inodes_count);
+    auto& foo = usage.children[1];
+    slassert(dir + "/foo" == foo.dirpath);
+    slassert(4 == foo.inodes_count);
+    slassert(1 == foo.children.size());
+    slassert(2 == foo.children[0].inodes_count);
+}
+
+int main() {
+    try {
+        test_usage();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -23,6 +23,7 @@
 
 #include "staticlib/tinydir/file_sink.hpp"
 
+#include <array>
 #include <cstring>
 #include <iostream>
 
@@ -30,6 +31,7 @@
 #include "staticlib/config/assert.hpp"
 #include "staticlib/io.hpp"
 
+#include "staticlib/tinydir/file_status.hpp"
 #include "staticlib/tinydir/operations.hpp"
 #include "staticlib/tinydir/path.hpp"
 
@@ -148,12 +150,180 @@ void test_write_from_file() {
     slassert("fbar" == sink.get_string());
 }
 
+void test_sparse() {
+    sl::tinydir::create_directory(dir);
+    auto tf = sl::tinydir::path(dir);
+    auto deferred = sl::support::defer([tf]() STATICLIB_NOEXCEPT {
+        tf.remove_quietly();
+    });
+
+    const uint64_t gap = 1 << 22;
+    auto from = sl::tinydir::path(dir + "/tmp_sparse_from.file");
+    {
+        auto fd = from.open_write();
+        // seek is relative to the current position
+        fd.write({"foo", 3});
+        fd.seek(gap - 3);
+        fd.write({"bar", 3});
+        fd.seek(gap - 3);
+        fd.write({"baz", 3});
+    }
+
+    {
+        auto src = from.open_read();
+        src.seek(1);
+        auto extents = src.data_extents();
+        slassert(!extents.empty());
+        slassert(0 == extents.front().offset);
+        slassert(2 * gap + 3 == extents.back().offset + extents.back().length);
+        uint64_t prev_end = 0;
+        for (auto& ex : extents) {
+            slassert(ex.offset >= prev_end);
+            slassert(ex.length > 0);
+            prev_end = ex.offset + ex.length;
+        }
+        // position is not changed
+        std::array<char, 2> buf;
+        slassert(2 == src.read(buf));
+        slassert('o' == buf[0] && 'o' == buf[1]);
+    }
+
+    auto file = sl::tinydir::path(dir + "/tmp_sparse_to.file");
+    {
+        auto fd = file.open_write();
+        fd.write({"x", 1});
+        slassert(static_cast<std::streamsize> (2 * gap + 3) == fd.write_from_file(from.filepath()));
+        fd.write({"y", 1});
+    }
+    auto copy = sl::tinydir::path(from.filepath()).copy_file(dir + "/tmp_sparse_copy.file");
+
+    auto src_st = sl::tinydir::status(from.filepath());
+    for (auto& pa : {file, copy}) {
+        auto st = sl::tinydir::status(pa.filepath());
+        // holes are preserved when FS supports them
+        slassert(st.allocated_size <= src_st.allocated_size + (1 << 16));
+        auto src = pa.open_read();
+        auto sink = sl::io::string_sink();
+        sl::io::copy_all(src, sink);
+        auto& str = sink.get_string();
+        auto shift = pa.filepath() == file.filepath() ? 1 : 0;
+        slassert(static_cast<size_t> (2 * gap + 3 + shift * 2) == str.length());
+        slassert("foo" == str.substr(shift, 3));
+        slassert("bar" == str.substr(gap + shift, 3));
+        slassert("baz" == str.substr(2 * gap + shift, 3));
+        slassert(std::string(16, '\0') == str.substr(shift + 3, 16));
+    }
+}
+
+void test_sparse_overwrite() {
+    sl::tinydir::create_directory(dir);
+    auto tf = sl::tinydir::path(dir);
+    auto deferred = sl::support::defer([tf]() STATICLIB_NOEXCEPT {
+        tf.remove_quietly();
+    });
+
+    const uint64_t gap = 1 << 20;
+    auto from = sl::tinydir::path(dir + "/tmp_sparse_from.file");
+    {
+        auto fd = from.open_write();
+        fd.write({"foo", 3});
+        fd.seek(gap - 3);
+        fd.write({"bar", 3});
+    }
+    auto filler = std::string(static_cast<size_t> (gap + 16), 'X');
+
+    // holes must read as zeros over existing data, from start and after seek
+    for (size_t shift = 0; shift < 2; shift++) {
+        auto file = sl::tinydir::path(dir + "/tmp_sparse_over.file");
+        {
+            auto fd = file.open_write();
+            fd.write({filler.data(), filler.length()});
+        }
+        {
+            auto fd = file.open_write(sl::tinydir::file_sink::open_mode::from_file);
+            if (shift > 0) {
+                fd.seek(static_cast<std::streamsize> (shift));
+            }
+            slassert(static_cast<std::streamsize> (gap + 3) == fd.write_from_file(from.filepath()));
+        }
+        auto src = file.open_read();
+        auto sink = sl::io::string_sink();
+        sl::io::copy_all(src, sink);
+        auto& str = sink.get_string();
+        slassert(filler.length() == str.length());
+        slassert(std::string(shift, 'X') == str.substr(0, shift));
+        slassert("foo" == str.substr(shift, 3));
+        slassert(std::string(static_cast<size_t> (gap - 3), '\0') == str.substr(shift + 3, static_cast<size_t> (gap - 3)));
+        slassert("bar" == str.substr(static_cast<size_t> (gap) + shift, 3));
+        slassert('X' == str.back());
+    }
+}
+
+void test_ec() {
+    sl::tinydir::create_directory(dir);
+    auto tf = sl::tinydir::path(dir);
+    auto deferred = sl::support::defer([tf]() STATICLIB_NOEXCEPT {
+        tf.remove_quietly();
+    });
+
+    std::error_code ec;
+    auto filename = dir + "/tmp_ec.file";
+    {
+        auto sink = sl::tinydir::file_sink(filename, sl::tinydir::file_sink::open_mode::append, ec);
+        slassert(std::errc::no_such_file_or_directory == ec);
+    }
+    {
+        auto sink = sl::tinydir::file_sink(filename, sl::tinydir::file_sink::open_mode::create, ec);
+        slassert(!ec);
+        sink.write({"foo", 3});
+    }
+    slassert(3 == sl::tinydir::file_source(filename).size());
+    {
+        auto sink = sl::tinydir::file_sink(filename, sl::tinydir::file_sink::open_mode::create_new, ec);
+        slassert(std::errc::file_exists == ec);
+    }
+    slassert(3 == sl::tinydir::file_source(filename).size());
+    {
+        auto sink = sl::tinydir::file_sink(dir + "/tmp_ec_new.file", sl::tinydir::file_sink::open_mode::create_new, ec);
+        slassert(!ec);
+    }
+}
+
+void test_reserve_sync() {
+    sl::tinydir::create_directory(dir);
+    auto tf = sl::tinydir::path(dir);
+    auto deferred = sl::support::defer([tf]() STATICLIB_NOEXCEPT {
+        tf.remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_reserve.file";
+    auto sink = sl::tinydir::file_sink(filename);
+    sink.reserve_space(1 << 20);
+    // size is not changed by reservation
+    slassert(0 == sl::tinydir::file_source(filename).size());
+    sink.write({"foo", 3});
+    sink.sync();
+    slassert(3 == sl::tinydir::file_source(filename).size());
+    sink.close();
+    bool thrown = false;
+    try {
+        sink.sync();
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
 int main() {
     try {
         test_write();
         test_append();
         test_seek();
         test_write_from_file();
+        test_sparse();
+        test_sparse_overwrite();
+        test_ec();
+        test_reserve_sync();
         slassert(!sl::tinydir::path(dir).exists());
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
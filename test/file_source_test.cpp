@@ -23,13 +23,26 @@
 
 #include "staticlib/tinydir/file_source.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <iostream>
+#include <string>
+
+#ifndef STATICLIB_WINDOWS
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // !STATICLIB_WINDOWS
 
 #include "staticlib/config.hpp"
 
 #include "staticlib/config/assert.hpp"
 
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/path.hpp"
+
 void test_desc() {
     sl::tinydir::file_source desc{"CMakeCache.txt"};
 }
@@ -44,6 +57,16 @@ void test_desc_fail() {
     slassert(catched);
 }
 
+void test_desc_ec() {
+    std::error_code ec;
+    sl::tinydir::file_source desc{"aaa", ec};
+    slassert(ec);
+    slassert(std::errc::no_such_file_or_directory == ec);
+    sl::tinydir::file_source desc_ok{"CMakeCache.txt", ec};
+    slassert(!ec);
+    slassert(desc_ok.size() > 0);
+}
+
 void test_read() {
     sl::tinydir::file_source desc{"CMakeCache.txt"};
     desc.seek(16);
@@ -57,14 +80,127 @@ void test_accessors() {
     sl::tinydir::file_source file{"CMakeCache.txt"};
     (void) file;
     slassert("CMakeCache.txt" == file.path());
+    auto st = file.status();
+    auto by_path = sl::tinydir::status("CMakeCache.txt");
+    slassert(sl::tinydir::file_type::regular_file == st.type);
+    slassert(static_cast<uint64_t> (file.size()) == st.size);
+    slassert(by_path.inode == st.inode);
+    slassert(by_path.device == st.device);
+}
+
+#ifndef STATICLIB_WINDOWS
+std::string read_fd(int fd, size_t len) {
+    auto res = std::string();
+    auto buf = std::string(4096, '\0');
+    while (res.length() < len) {
+        auto read = ::read(fd, std::addressof(buf.front()), std::min(buf.length(), len - res.length()));
+        slassert(read > 0);
+        res.append(buf.data(), static_cast<size_t> (read));
+    }
+    return res;
+}
+
+void test_transfer() {
+    auto filename = std::string("file_source_test_transfer.file");
+    auto deferred = sl::support::defer([filename]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(filename).remove_quietly();
+    });
+    auto data = std::string();
+    for (size_t i = 0; i < (1 << 20); i++) {
+        data.push_back(static_cast<char> ('a' + i % 26));
+    }
+    {
+        auto sink = sl::tinydir::file_sink(filename);
+        sink.write({data.data(), data.length()});
+    }
+    auto src = sl::tinydir::file_source(filename);
+    src.seek(42);
+
+    // pipe
+    int pfd[2];
+    slassert(0 == ::pipe(pfd));
+    auto deferred_pipe = sl::support::defer([pfd]() STATICLIB_NOEXCEPT {
+        ::close(pfd[0]);
+        ::close(pfd[1]);
+    });
+    slassert(1000 == src.transfer_to(pfd[1], 10, 1000));
+    slassert(data.substr(10, 1000) == read_fd(pfd[0], 1000));
+
+    // non-blocking pipe, returns progress when full
+    slassert(0 == ::fcntl(pfd[1], F_SETFL, ::fcntl(pfd[1], F_GETFL) | O_NONBLOCK));
+    uint64_t offset = 0;
+    size_t rounds = 0;
+    auto received = std::string();
+    while (offset < data.length()) {
+        auto sent = src.transfer_to(pfd[1], offset, data.length() - offset);
+        slassert(sent > 0);
+        received += read_fd(pfd[0], static_cast<size_t> (sent));
+        offset += sent;
+        rounds += 1;
+    }
+    slassert(rounds > 1);
+    slassert(data == received);
+
+    // full non-blocking pipe is reported separately from EOF
+    auto filled = src.transfer_to(pfd[1], 0, data.length());
+    slassert(filled > 0 && filled < data.length());
+    std::error_code ec;
+    slassert(0 == src.transfer_to(pfd[1], filled, data.length() - filled, ec));
+    slassert(std::errc::operation_would_block == ec);
+    bool thrown = false;
+    try {
+        src.transfer_to(pfd[1], filled, data.length() - filled);
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    slassert(data.substr(0, static_cast<size_t> (filled)) == read_fd(pfd[0], static_cast<size_t> (filled)));
+    slassert(0 == src.transfer_to(pfd[1], data.length(), 1000, ec));
+    slassert(!ec);
+
+    // socket, count past EOF
+    int sfd[2];
+    slassert(0 == ::socketpair(AF_UNIX, SOCK_STREAM, 0, sfd));
+    auto deferred_socket = sl::support::defer([sfd]() STATICLIB_NOEXCEPT {
+        ::close(sfd[0]);
+        ::close(sfd[1]);
+    });
+    slassert(26 == src.transfer_to(sfd[0], data.length() - 26, 1000));
+    slassert(data.substr(data.length() - 26) == read_fd(sfd[1], 26));
+    slassert(0 == src.transfer_to(sfd[0], data.length(), 1000));
+
+    // regular file
+    auto copyname = filename + ".copy";
+    auto deferred_copy = sl::support::defer([copyname]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(copyname).remove_quietly();
+    });
+    {
+        auto sink = sl::tinydir::file_sink(copyname);
+        (void) sink;
+    }
+    int cfd = ::open(copyname.c_str(), O_WRONLY);
+    slassert(-1 != cfd);
+    slassert(data.length() == src.transfer_to(cfd, 0, data.length()));
+    ::close(cfd);
+    slassert(data.length() == static_cast<size_t> (sl::tinydir::file_source(copyname).size()));
+
+    // position is not changed
+    std::array<char, 3> buf;
+    slassert(3 == src.read(buf));
+    slassert(data.substr(42, 3) == std::string(buf.data(), buf.size()));
 }
+#endif // !STATICLIB_WINDOWS
 
 int main() {
     try {
         test_desc();
         test_desc_fail();
+        test_desc_ec();
         test_read();
         test_accessors();
+#ifndef STATICLIB_WINDOWS
+        test_transfer();
+#endif // !STATICLIB_WINDOWS
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
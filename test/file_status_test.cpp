@@ -0,0 +1,81 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_status_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:52 AM
+ */
+
+#include "staticlib/tinydir/file_status.hpp"
+
+#include <cstring>
+#include <iostream>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+const std::string dir = "file_status_test";
+
+void test_status() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    {
+        auto sink = sl::tinydir::file_sink(dir + "/tmp.file");
+        sink.write({"foo", 3});
+    }
+    auto dst = sl::tinydir::status(dir);
+    slassert(sl::tinydir::file_type::directory == dst.type);
+    auto fst = sl::tinydir::status(dir + "/tmp.file");
+    slassert(sl::tinydir::file_type::regular_file == fst.type);
+    slassert(3 == fst.size);
+    slassert(fst.mtime_ns > 0);
+    slassert(1 == fst.links_count);
+    auto nst = sl::tinydir::status(dir + "/fail.file");
+    slassert(sl::tinydir::file_type::not_found == nst.type);
+}
+
+void test_modification_time() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    {
+        auto sink = sl::tinydir::file_sink(dir + "/tmp.file");
+        sink.write({"foo", 3});
+    }
+    int64_t mtime = 1500000000LL * 1000000000LL;
+    sl::tinydir::set_modification_time(dir + "/tmp.file", mtime);
+    slassert(mtime == sl::tinydir::status(dir + "/tmp.file").mtime_ns);
+}
+
+int main() {
+    try {
+        test_status();
+        test_modification_time();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
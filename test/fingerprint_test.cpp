@@ -0,0 +1,136 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fingerprint_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 3:02 PM
+ */
+
+#include "staticlib/tinydir/fingerprint.hpp"
+
+#include <cstring>
+#include <iostream>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "fingerprint_test";
+
+void test_fingerprint() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    write_file(dir + "/empty.txt", "");
+    write_file(dir + "/abc.txt", "abc");
+    write_file(dir + "/long.txt", "Nobody inspects the spammish repetition");
+
+    auto opts = sl::tinydir::fingerprint_options();
+    opts.sha256 = true;
+    auto empty = sl::tinydir::fingerprint_file(dir + "/empty.txt", opts);
+    slassert(0 == empty.size);
+    slassert(0xef46db3751d8e999ULL == empty.xxh64);
+    slassert("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" == empty.sha256);
+
+    auto abc = sl::tinydir::fingerprint_file(dir + "/abc.txt", opts);
+    slassert(3 == abc.size);
+    slassert(0x44bc2cf5ad770999ULL == abc.xxh64);
+    slassert("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" == abc.sha256);
+
+    // small buffer to exercise stripes spanning reads
+    opts.buffer_size = 5;
+    auto long_fp = sl::tinydir::fingerprint_file(dir + "/long.txt", opts);
+    slassert(0xfbcea83c8a378bf1ULL == long_fp.xxh64);
+
+    auto list = sl::tinydir::fingerprint_files({dir + "/abc.txt", dir + "/empty.txt"});
+    slassert(2 == list.size());
+    slassert(abc.xxh64 == list[0].xxh64);
+    slassert(list[0].sha256.empty());
+    slassert(empty.xxh64 == list[1].xxh64);
+}
+
+void test_duplicates() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    sl::tinydir::create_directory(dir + "/foo");
+    sl::tinydir::create_directory(dir + "/bar");
+    auto big = std::string(1000, 'a');
+    auto big_other = big;
+    big_other[500] = 'b';
+    write_file(dir + "/foo/1.txt", big);
+    write_file(dir + "/bar/1.txt", big);
+    write_file(dir + "/bar/2.txt", big_other);
+    write_file(dir + "/foo/3.txt", "foo");
+    write_file(dir + "/bar/3.txt", "foo");
+    write_file(dir + "/bar/4.txt", "bar");
+    write_file(dir + "/foo/empty1.txt", "");
+    write_file(dir + "/foo/empty2.txt", "");
+
+    auto opts = sl::tinydir::duplicates_options();
+    opts.partial_size = 100;
+    opts.sha256 = true;
+    auto dups = sl::tinydir::find_duplicates({dir + "/foo", dir + "/bar"}, opts);
+    slassert(2 == dups.size());
+    slassert(2 == dups[0].size());
+    slassert(dir + "/bar/1.txt" == dups[0][0]);
+    slassert(dir + "/foo/1.txt" == dups[0][1]);
+    slassert(2 == dups[1].size());
+    slassert(dir + "/bar/3.txt" == dups[1][0]);
+    slassert(dir + "/foo/3.txt" == dups[1][1]);
+}
+
+void test_duplicates_default() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    // differ past both the partial hash and the first read buffer
+    auto opts = sl::tinydir::duplicates_options();
+    auto big = std::string(opts.buffer_size + opts.buffer_size / 2, 'a');
+    auto big_other = big;
+    big_other[big_other.length() - 1] = 'b';
+    write_file(dir + "/1.txt", big);
+    write_file(dir + "/2.txt", big_other);
+    write_file(dir + "/3.txt", big);
+
+    auto dups = sl::tinydir::find_duplicates({dir}, opts);
+    slassert(1 == dups.size());
+    slassert(2 == dups[0].size());
+    slassert(dir + "/1.txt" == dups[0][0]);
+    slassert(dir + "/3.txt" == dups[0][1]);
+}
+
+int main() {
+    try {
+        test_fingerprint();
+        test_duplicates();
+        test_duplicates_default();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   follow_reader_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 1:20 AM
+ */
+
+#include "staticlib/tinydir/follow_reader.hpp"
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "follow_reader_test";
+
+void append_file(const std::string& path, const std::string& data) {
+    auto sink = sl::tinydir::file_sink(path, sl::tinydir::file_sink::open_mode::append);
+    sink.write({data.data(), data.length()});
+}
+
+std::string read_available(sl::tinydir::follow_reader& reader) {
+    auto res = std::string();
+    std::array<char, 3> buf;
+    for (;;) {
+        auto read = reader.read(buf);
+        if (0 == read) break;
+        res.append(buf.data(), static_cast<size_t> (read));
+    }
+    return res;
+}
+
+std::string read_wait(sl::tinydir::follow_reader& reader, size_t len) {
+    auto res = std::string();
+    std::array<char, 64> buf;
+    while (res.length() < len) {
+        auto read = reader.read(buf, std::chrono::milliseconds(5000));
+        slassert(read > 0);
+        res.append(buf.data(), static_cast<size_t> (read));
+    }
+    return res;
+}
+
+void test_follow() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_follow.log";
+    write_file(filename, "foo\n");
+    auto reader = sl::tinydir::follow_reader(filename);
+    slassert(filename == reader.path());
+#ifdef STATICLIB_LINUX
+    slassert(reader.is_notified());
+#endif // STATICLIB_LINUX
+    slassert("foo\n" == read_available(reader));
+    slassert(4 == reader.offset());
+    slassert(read_available(reader).empty());
+
+    // nothing is written
+    std::array<char, 16> buf;
+    slassert(0 == reader.read(buf, std::chrono::milliseconds(50)));
+
+    // concurrent append
+    auto writer = std::thread([&filename] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        append_file(filename, "bar\n");
+    });
+    auto start = std::chrono::steady_clock::now();
+    slassert("bar\n" == read_wait(reader, 4));
+    writer.join();
+    slassert(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(4000));
+
+    // truncation
+    write_file(filename, "ab");
+    slassert("ab" == read_available(reader));
+    slassert(2 == reader.offset());
+    slassert(0 == reader.reopens_count());
+
+    // rotation, the tail of the old file is read first
+    auto rotated = dir + "/tmp_follow.log.1";
+    sl::tinydir::path(filename).rename(rotated);
+    append_file(rotated, "cd");
+    write_file(filename, "new\n");
+    slassert("cdnew\n" == read_available(reader));
+    slassert(1 == reader.reopens_count());
+    slassert(4 == reader.offset());
+
+    // moved reader
+    auto moved = std::move(reader);
+    append_file(filename, "baz");
+    slassert("baz" == read_wait(moved, 3));
+}
+
+void test_missing() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_missing.log";
+    auto reader = sl::tinydir::follow_reader(filename);
+    slassert(read_available(reader).empty());
+    auto writer = std::thread([&filename] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        write_file(filename, "created");
+    });
+    slassert("created" == read_wait(reader, 7));
+    writer.join();
+    slassert(0 == reader.reopens_count());
+}
+
+void test_start_at_end() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto filename = dir + "/tmp_end.log";
+    write_file(filename, "old\n");
+    auto opts = sl::tinydir::follow_options();
+    opts.start_at_end = true;
+    opts.poll_interval = std::chrono::milliseconds(10);
+    auto reader = sl::tinydir::follow_reader(filename, opts);
+    slassert(4 == reader.offset());
+    slassert(read_available(reader).empty());
+    append_file(filename, "new\n");
+    slassert("new\n" == read_available(reader));
+}
+
+int main() {
+    try {
+        test_follow();
+        test_missing();
+        test_start_at_end();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   io_buffer_pool_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 9:10 PM
+ */
+
+#include "staticlib/tinydir/io_buffer_pool.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+
+bool aligned(const char* ptr) {
+    return 0 == reinterpret_cast<uintptr_t> (ptr) % 4096;
+}
+
+void test_acquire() {
+    {
+        auto buf = sl::tinydir::acquire_io_buffer(1);
+        slassert(4096 == buf.size());
+        slassert(aligned(buf.data()));
+        std::memset(buf.data(), 'a', buf.size());
+        slassert(buf.size() == buf.span().size());
+    }
+    {
+        auto buf = sl::tinydir::acquire_io_buffer(5000);
+        slassert(8192 == buf.size());
+        slassert(aligned(buf.data()));
+    }
+    {
+        auto buf = sl::tinydir::acquire_io_buffer(1 << 20);
+        slassert((1 << 20) == buf.size());
+    }
+    {
+        // oversized
+        auto buf = sl::tinydir::acquire_io_buffer((5 << 20) + 1);
+        slassert((5 << 20) + 4096 == buf.size());
+        slassert(aligned(buf.data()));
+    }
+    {
+        auto empty = sl::tinydir::io_buffer();
+        slassert(nullptr == empty.data());
+        slassert(0 == empty.size());
+        empty.release();
+    }
+}
+
+void test_reuse() {
+    sl::tinydir::io_buffer_pool_trim();
+    auto before = sl::tinydir::io_buffer_pool_snapshot();
+    const char* ptr = nullptr;
+    {
+        auto buf = sl::tinydir::acquire_io_buffer(1 << 16);
+        ptr = buf.data();
+        auto st = sl::tinydir::io_buffer_pool_snapshot();
+        slassert(st.in_use_bytes >= before.in_use_bytes + (1 << 16));
+    }
+    auto released = sl::tinydir::io_buffer_pool_snapshot();
+    slassert(released.cached_bytes >= (1 << 16));
+    {
+        auto buf = sl::tinydir::acquire_io_buffer(40000);
+        // same buffer from the cache of this thread
+        slassert(ptr == buf.data());
+        auto moved = std::move(buf);
+        slassert(nullptr == buf.data());
+        slassert(ptr == moved.data());
+    }
+    auto after = sl::tinydir::io_buffer_pool_snapshot();
+    slassert(after.acquired == before.acquired + 2);
+    slassert(after.allocations == before.allocations + 1);
+    slassert(after.thread_cache_hits + after.shared_cache_hits ==
+            before.thread_cache_hits + before.shared_cache_hits + 1);
+    slassert(after.in_use_bytes == before.in_use_bytes);
+
+    // buffers of finished threads go to the shared cache
+    sl::tinydir::io_buffer_pool_trim();
+    auto th = std::thread([] {
+        auto buf = sl::tinydir::acquire_io_buffer(1 << 18);
+        (void) buf;
+    });
+    th.join();
+    auto shared_before = sl::tinydir::io_buffer_pool_snapshot();
+    {
+        auto buf = sl::tinydir::acquire_io_buffer(1 << 18);
+        (void) buf;
+    }
+    auto shared_after = sl::tinydir::io_buffer_pool_snapshot();
+    slassert(shared_after.shared_cache_hits == shared_before.shared_cache_hits + 1);
+    slassert(shared_after.allocations == shared_before.allocations);
+}
+
+void test_limit() {
+    sl::tinydir::io_buffer_pool_trim();
+    auto st = sl::tinydir::io_buffer_pool_snapshot();
+    slassert(0 == st.cached_bytes);
+    sl::tinydir::io_buffer_pool_set_limit(0);
+    {
+        // thread cache accepts at most 4 buffers of a class
+        auto vec = std::vector<sl::tinydir::io_buffer>();
+        for (size_t i = 0; i < 6; i++) {
+            vec.emplace_back(sl::tinydir::acquire_io_buffer(4096));
+        }
+    }
+    auto limited = sl::tinydir::io_buffer_pool_snapshot();
+    slassert(limited.cached_bytes <= 4 * 4096);
+    slassert(limited.deallocations >= st.deallocations + 2);
+    sl::tinydir::io_buffer_pool_set_limit(64 << 20);
+    sl::tinydir::io_buffer_pool_trim();
+    slassert(0 == sl::tinydir::io_buffer_pool_snapshot().cached_bytes);
+}
+
+void test_threads() {
+    auto before = sl::tinydir::io_buffer_pool_snapshot();
+    auto threads = std::vector<std::thread>();
+    for (size_t i = 0; i < 8; i++) {
+        threads.emplace_back([i] {
+            for (size_t j = 0; j < 1000; j++) {
+                auto buf = sl::tinydir::acquire_io_buffer(4096 << ((i + j) % 6));
+                buf.data()[0] = static_cast<char> (j);
+                buf.data()[buf.size() - 1] = static_cast<char> (j);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    auto after = sl::tinydir::io_buffer_pool_snapshot();
+    slassert(after.acquired == before.acquired + 8000);
+    slassert(after.in_use_bytes == before.in_use_bytes);
+    // most of the buffers are reused
+    slassert(after.allocations - before.allocations < 8 * 6 * 4 + 8);
+}
+
+int main() {
+    try {
+        test_acquire();
+        test_reuse();
+        test_limit();
+        test_threads();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
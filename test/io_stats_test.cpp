@@ -0,0 +1,169 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   io_stats_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 3:20 PM
+ */
+
+#include "staticlib/tinydir/io_stats.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "io_stats_test_dir";
+
+void test_names() {
+    slassert(0 == std::strcmp("open", sl::tinydir::io_op_name(sl::tinydir::io_op::open)));
+    slassert(0 == std::strcmp("read_directory", sl::tinydir::io_op_name(sl::tinydir::io_op::read_directory)));
+    slassert(0 == std::strcmp("set_times", sl::tinydir::io_op_name(sl::tinydir::io_op::set_times)));
+}
+
+void test_counters() {
+    sl::tinydir::io_stats_reset();
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    write_file(dir + "/1.txt", "foo");
+    write_file(dir + "/2.txt", "barbaz");
+    auto src = sl::tinydir::file_source(dir + "/2.txt");
+    auto sink = sl::io::string_sink();
+    sl::io::copy_all(src, sink);
+    src.close();
+    auto list = sl::tinydir::list_directory(dir);
+    slassert(2 == list.size());
+    bool thrown = false;
+    try {
+        sl::tinydir::file_source(dir + "/fail.txt");
+    } catch (const sl::tinydir::tinydir_exception& e) {
+        thrown = true;
+        slassert(std::string::npos != std::string(e.what()).find("fail.txt"));
+    }
+    slassert(thrown);
+
+    auto st = sl::tinydir::io_stats_snapshot();
+    auto& open = st.get(sl::tinydir::io_op::open);
+    auto& write = st.get(sl::tinydir::io_op::write);
+    auto& read = st.get(sl::tinydir::io_op::read);
+    if (sl::tinydir::io_stats_enabled()) {
+        slassert(4 == open.calls);
+        slassert(1 == open.errors);
+        slassert(2 == write.calls);
+        slassert(9 == write.bytes);
+        slassert(read.calls >= 2);
+        slassert(6 == read.bytes);
+        slassert(1 == st.get(sl::tinydir::io_op::create_directory).calls);
+        slassert(1 == st.get(sl::tinydir::io_op::read_directory).calls);
+        uint64_t hist = 0;
+        for (auto cnt : open.latency_histogram) {
+            hist += cnt;
+        }
+        slassert(open.calls == hist);
+        slassert(open.total_ns > 0);
+    } else {
+        slassert(0 == open.calls);
+        slassert(0 == write.bytes);
+        slassert(0 == read.calls);
+    }
+
+    sl::tinydir::io_stats_reset();
+    slassert(0 == sl::tinydir::io_stats_snapshot().get(sl::tinydir::io_op::open).calls);
+}
+
+void test_threads() {
+    sl::tinydir::io_stats_reset();
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    auto th = std::thread([] {
+        write_file(dir + "/1.txt", "foo");
+    });
+    th.join();
+    auto local = sl::tinydir::io_stats_thread_snapshot();
+    slassert(0 == local.get(sl::tinydir::io_op::write).calls);
+    auto global = sl::tinydir::io_stats_snapshot();
+    if (sl::tinydir::io_stats_enabled()) {
+        slassert(1 == global.get(sl::tinydir::io_op::write).calls);
+        slassert(1 == local.get(sl::tinydir::io_op::create_directory).calls);
+        // counters of the finished thread are retired, reset clears them too
+        sl::tinydir::io_stats_reset();
+        slassert(0 == sl::tinydir::io_stats_snapshot().get(sl::tinydir::io_op::write).calls);
+    } else {
+        slassert(0 == global.get(sl::tinydir::io_op::write).calls);
+    }
+}
+
+void test_trace() {
+    std::atomic<size_t> writes(0);
+    std::atomic<size_t> failures(0);
+    sl::tinydir::io_stats_set_trace_callback([&writes, &failures](const sl::tinydir::io_trace_event& ev) {
+        if (sl::tinydir::io_op::write == ev.op && std::string::npos != ev.path.find("1.txt")) {
+            writes += 1;
+        }
+        if (ev.failed) {
+            failures += 1;
+        }
+    });
+    auto deferred_cb = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::io_stats_set_trace_callback(nullptr);
+    });
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    write_file(dir + "/1.txt", "foo");
+    try {
+        sl::tinydir::create_directory(dir);
+    } catch (const sl::tinydir::tinydir_exception&) {
+        // expected
+    }
+    if (sl::tinydir::io_stats_enabled()) {
+        slassert(1 == writes.load());
+        slassert(1 == failures.load());
+    } else {
+        slassert(0 == writes.load());
+        slassert(0 == failures.load());
+    }
+}
+
+int main() {
+    try {
+        test_names();
+        test_counters();
+        test_threads();
+        test_trace();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
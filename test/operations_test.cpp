@@ -25,10 +25,14 @@
 
 #include <cstring>
 #include <iostream>
+#include <thread>
 
 #include "staticlib/config.hpp"
 
 #include "staticlib/config/assert.hpp"
+#include "staticlib/support.hpp"
+
+#include "staticlib/tinydir/file_status.hpp"
 
 void test_list() {
     auto vec = sl::tinydir::list_directory(".");
@@ -52,6 +56,66 @@ void test_mkdir() {
     slassert(!sl::tinydir::path("operations_test_dir").exists());
 }
 
+void test_mkdir_ec() {
+    auto name = std::string("operations_test_dir_ec");
+    std::error_code ec;
+    sl::tinydir::create_directory(name, ec);
+    slassert(!ec);
+    auto deferred = sl::support::defer([name]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(name).remove_quietly();
+    });
+    sl::tinydir::create_directory(name, ec);
+    slassert(std::errc::file_exists == ec);
+    sl::tinydir::create_directory(name + "/foo/bar", ec);
+    slassert(std::errc::no_such_file_or_directory == ec);
+}
+
+void test_mkdirs() {
+    auto name = std::string("operations_test_dirs");
+    auto deferred = sl::support::defer([name]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(name).remove_quietly();
+    });
+    sl::tinydir::create_directories(name + "/foo/bar/baz/");
+    slassert(sl::tinydir::path(name + "/foo/bar/baz").is_directory());
+    // existing
+    sl::tinydir::create_directories(name + "/foo/bar/baz");
+    sl::tinydir::create_directories(name + "/foo/bar1/baz1");
+    slassert(sl::tinydir::path(name + "/foo/bar1/baz1").is_directory());
+    {
+        auto sink = sl::tinydir::file_sink(name + "/foo/42.txt");
+    }
+    std::error_code ec;
+    sl::tinydir::create_directories(name + "/foo/42.txt", ec);
+    slassert(std::errc::file_exists == ec);
+    sl::tinydir::create_directories(name + "/foo/42.txt/bar", ec);
+    slassert(ec);
+    bool thrown = false;
+    try {
+        sl::tinydir::create_directories(name + "/foo/42.txt");
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+#ifndef STATICLIB_WINDOWS
+    // stat error on existing entry is reported through ec
+    sl::tinydir::create_symlink("loop", name + "/loop");
+    sl::tinydir::create_directories(name + "/loop", ec);
+    slassert(std::errc::too_many_symbolic_link_levels == ec);
+#endif // !STATICLIB_WINDOWS
+
+    // concurrent creators
+    auto threads = std::vector<std::thread>();
+    for (size_t i = 0; i < 4; i++) {
+        threads.emplace_back([name, i] {
+            sl::tinydir::create_directories(name + "/par/a/b/c/" + sl::support::to_string(i % 2));
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    slassert(2 == sl::tinydir::list_directory(name + "/par/a/b/c").size());
+}
+
 void test_normalize() {
     slassert("/foo/bar" == sl::tinydir::normalize_path("/foo/bar/"))
     slassert("/foo/bar" == sl::tinydir::normalize_path("/foo//bar"))
@@ -65,6 +129,15 @@ void test_full_path() {
     auto path = std::string(".");
     auto full = sl::tinydir::full_path(path);
     slassert(full.length() > path.length());
+    std::error_code ec;
+    auto full_ec = sl::tinydir::full_path(path, ec);
+    slassert(!ec);
+    slassert(full == full_ec);
+#ifndef STATICLIB_WINDOWS
+    auto fail = sl::tinydir::full_path("operations_test_nonexistent", ec);
+    slassert(ec);
+    slassert(fail.empty());
+#endif // !STATICLIB_WINDOWS
 }
 
 void test_symlink() {
@@ -99,12 +172,82 @@ void test_symlink() {
     slassert(!dlink_removed.exists());
 }
 
+void test_hardlink() {
+    auto dirname = std::string("operations_hardlink_test_dir");
+    sl::tinydir::create_directory(dirname);
+    auto deferred = sl::support::defer([dirname]() STATICLIB_NOEXCEPT{
+        sl::tinydir::path(dirname).remove_quietly();
+    });
+    auto file = sl::tinydir::path(dirname + "/tmp.file");
+    {
+        auto fd = file.open_write();
+        fd.write({ "foo", 3});
+    }
+    sl::tinydir::create_hardlink(dirname + "/tmp.file", dirname + "/tmp.file.link");
+    auto st = sl::tinydir::status(dirname + "/tmp.file");
+    auto lst = sl::tinydir::status(dirname + "/tmp.file.link");
+    slassert(sl::tinydir::file_type::regular_file == lst.type);
+    slassert(st.inode == lst.inode);
+    slassert(2 == lst.links_count);
+    slassert(3 == lst.size);
+    // link path must not exist
+    bool thrown = false;
+    try {
+        sl::tinydir::create_hardlink(dirname + "/tmp.file", dirname + "/tmp.file.link");
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    sl::tinydir::path(dirname + "/tmp.file").remove();
+    slassert(1 == sl::tinydir::status(dirname + "/tmp.file.link").links_count);
+}
+
+void test_list_status() {
+    auto dirname = std::string("operations_list_status_test_dir");
+    sl::tinydir::create_directory(dirname);
+    auto deferred = sl::support::defer([dirname]() STATICLIB_NOEXCEPT{
+        sl::tinydir::path(dirname).remove_quietly();
+    });
+    sl::tinydir::create_directory(dirname + "/sub");
+    for (size_t i = 0; i < 3; i++) {
+        auto fpath = dirname + "/" + sl::support::to_string(i) + ".file";
+        sl::tinydir::path(fpath).open_write().write({"foobar", 1 + i});
+        sl::tinydir::set_modification_time(fpath, 1500000000000000000LL - static_cast<int64_t> (i));
+    }
+#ifndef STATICLIB_WINDOWS
+    sl::tinydir::create_symlink("0.file", dirname + "/link");
+#endif // !STATICLIB_WINDOWS
+    for (auto& ch : sl::tinydir::list_directory(dirname)) {
+        auto st = ch.symlink_status();
+        auto expected = sl::tinydir::symlink_status(ch.filepath());
+        slassert(expected.type == st.type);
+        slassert(expected.size == st.size);
+        slassert(expected.mtime_ns == st.mtime_ns);
+        slassert(expected.inode == st.inode);
+        if (sl::tinydir::file_type::regular_file == st.type) {
+            slassert(1500000000000000000LL - static_cast<int64_t> (st.size - 1) == st.mtime_ns);
+        }
+    }
+    auto file = sl::tinydir::path(dirname + "/2.file");
+    slassert(3 == file.symlink_status().size);
+#ifndef STATICLIB_WINDOWS
+    auto link = sl::tinydir::path(dirname + "/link");
+    slassert(sl::tinydir::file_type::symlink == link.symlink_status().type);
+#endif // !STATICLIB_WINDOWS
+    auto missing = sl::tinydir::path(dirname + "/missing");
+    slassert(sl::tinydir::file_type::not_found == missing.symlink_status().type);
+}
+
 int main() {
     try {
         test_list();
         test_mkdir();
+        test_mkdir_ec();
+        test_mkdirs();
         test_normalize();
         test_full_path();
+        test_hardlink();
+        test_list_status();
 #if !defined(STATICLIB_WINDOWS) || defined(_WIN64)        
         test_symlink();
 #endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   parallel_copy_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:20 PM
+ */
+
+#include "staticlib/tinydir/parallel_copy.hpp"
+
+#include <iostream>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/file_status.hpp"
+#include "staticlib/tinydir/operations.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "parallel_copy_test";
+
+void test_copy() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto from = dir + "/tmp_from.file";
+    auto to = dir + "/tmp_to.file";
+    auto data = make_data((1 << 20) * 3 + 12345);
+    write_file(from, data);
+    // existing target is replaced
+    write_file(to, "foo");
+    // user entries next to the target are not touched
+    write_file(to + ".tinydir_copy_tmp", "bar");
+
+    auto opts = sl::tinydir::parallel_copy_options();
+    opts.threads_count = 4;
+    opts.chunk_size = 256 * 1024;
+    auto ranges_count = (data.length() + opts.chunk_size - 1) / opts.chunk_size;
+    auto progress = std::vector<uint64_t>(ranges_count, 0);
+    opts.on_progress = [&progress](const sl::tinydir::file_chunk& range, uint64_t copied) {
+        slassert(copied > progress[range.index]);
+        slassert(copied <= range.length);
+        slassert(range.index * (256 * 1024) == range.offset);
+        progress[range.index] = copied;
+    };
+    auto res = sl::tinydir::parallel_copy_file(from, to, opts);
+    slassert(res.is_regular_file());
+    slassert(data == read_file(to));
+    uint64_t total = 0;
+    for (auto pr : progress) {
+        slassert(pr > 0);
+        total += pr;
+    }
+    slassert(data.length() == total);
+    slassert("bar" == read_file(to + ".tinydir_copy_tmp"));
+    // temporary entries are removed
+    slassert(3 == sl::tinydir::list_directory(dir).size());
+
+    // empty file
+    auto empty = dir + "/tmp_empty.file";
+    auto empty_to = dir + "/tmp_empty_to.file";
+    write_file(empty, "");
+    sl::tinydir::parallel_copy_file(empty, empty_to);
+    slassert(0 == sl::tinydir::symlink_status(empty_to).size);
+
+    // single range
+    auto small_to = dir + "/tmp_small_to.file";
+    sl::tinydir::parallel_copy_file(from, small_to);
+    slassert(data == read_file(small_to));
+}
+
+void test_errors() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    // missing source
+    auto to = dir + "/tmp_to.file";
+    bool thrown = false;
+    try {
+        sl::tinydir::parallel_copy_file(dir + "/missing.file", to);
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    slassert(sl::tinydir::list_directory(dir).empty());
+
+    // failed progress callback leaves no target
+    auto from = dir + "/tmp_from.file";
+    write_file(from, make_data(100000));
+    auto opts = sl::tinydir::parallel_copy_options();
+    opts.threads_count = 2;
+    opts.chunk_size = 10000;
+    opts.on_progress = [](const sl::tinydir::file_chunk& range, uint64_t) {
+        if (5 == range.index) {
+            throw sl::tinydir::tinydir_exception("fail");
+        }
+    };
+    thrown = false;
+    try {
+        sl::tinydir::parallel_copy_file(from, to, opts);
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    slassert(!sl::tinydir::path(to).exists());
+    slassert(1 == sl::tinydir::list_directory(dir).size());
+
+    // directory source
+    thrown = false;
+    try {
+        sl::tinydir::parallel_copy_file(dir, to);
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+int main() {
+    try {
+        test_copy();
+        test_errors();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
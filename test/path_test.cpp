@@ -32,6 +32,14 @@
 
 #include "staticlib/config/assert.hpp"
 
+#include "staticlib/tinydir/file_status.hpp"
+
+#include "test_utils.hpp"
+
+#ifndef STATICLIB_WINDOWS
+#include <sys/stat.h>
+#endif // !STATICLIB_WINDOWS
+
 void test_file() {
     auto dir = std::string("path_test");
     auto dir_moved = std::string("path_test_moved");
@@ -111,10 +119,260 @@ void test_remove_dir() {
     slassert(!dirpath_refreshed.exists());
 }
 
+void test_ec() {
+    auto dir = std::string("path_ec_test");
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([dir]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    {
+        auto sink = sl::tinydir::path(dir + "/1.txt").open_write();
+        sink.write({"foo", 3});
+    }
+    std::error_code ec;
+    auto missing = sl::tinydir::path(dir + "/2.txt");
+    missing.rename(dir + "/3.txt", ec);
+    slassert(std::errc::no_such_file_or_directory == ec);
+    missing.copy_file(dir + "/3.txt", ec);
+    slassert(std::errc::no_such_file_or_directory == ec);
+
+    auto file = sl::tinydir::path(dir + "/1.txt");
+    file.copy_file(dir + "/2.txt", ec);
+    slassert(!ec);
+    file.rename(dir + "/3.txt", ec);
+    slassert(!ec);
+    slassert(!sl::tinydir::path(dir + "/1.txt").exists());
+    slassert(sl::tinydir::path(dir + "/2.txt").exists());
+    slassert(sl::tinydir::path(dir + "/3.txt").exists());
+    file.copy_file(dir + "/no/such/dir.txt", ec);
+    slassert(ec);
+}
+
+void test_rename_modes() {
+    auto dir = std::string("path_rename_test");
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([dir]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    sl::tinydir::create_directory(dir + "/a");
+    sl::tinydir::create_directory(dir + "/b");
+    {
+        auto sink = sl::tinydir::file_sink(dir + "/a/1.txt");
+        sink.write({"foo", 3});
+    }
+    {
+        auto sink = sl::tinydir::file_sink(dir + "/b/1.txt");
+        sink.write({"bar", 3});
+    }
+    std::error_code ec;
+    auto a = sl::tinydir::path(dir + "/a");
+    a.rename(dir + "/b", sl::tinydir::path::rename_mode::no_replace, ec);
+    if (std::errc::function_not_supported == ec || std::errc::invalid_argument == ec ||
+            std::errc::not_supported == ec) {
+        std::cout << "WARN: rename modes are not supported, error: [" << ec.message() << "]" << std::endl;
+        return;
+    }
+    slassert(std::errc::file_exists == ec);
+    slassert("foo" == read_file(dir + "/a/1.txt"));
+
+    a.rename(dir + "/b", sl::tinydir::path::rename_mode::exchange, ec);
+    slassert(!ec);
+    slassert("bar" == read_file(dir + "/a/1.txt"));
+    slassert("foo" == read_file(dir + "/b/1.txt"));
+
+    a.rename(dir + "/c", sl::tinydir::path::rename_mode::exchange, ec);
+    slassert(std::errc::no_such_file_or_directory == ec);
+    auto c = a.rename(dir + "/c", sl::tinydir::path::rename_mode::no_replace);
+    slassert(c.is_directory());
+    slassert("bar" == read_file(dir + "/c/1.txt"));
+}
+
+void test_move() {
+    auto dir = std::string("path_move_test");
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([dir]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    sl::tinydir::create_directory(dir + "/src");
+    sl::tinydir::create_directory(dir + "/src/foo");
+    {
+        auto sink = sl::tinydir::file_sink(dir + "/src/foo/1.txt");
+        sink.write({"foo", 3});
+    }
+    // same file system
+    auto moved = sl::tinydir::path(dir + "/src").move(dir + "/dest");
+    slassert(moved.is_directory());
+    slassert(!sl::tinydir::path(dir + "/src").exists());
+    slassert("foo" == read_file(dir + "/dest/foo/1.txt"));
+
+#ifndef STATICLIB_WINDOWS
+    // different file system, if available
+    auto shm = std::string("/dev/shm");
+    auto shm_st = sl::tinydir::status(shm);
+    if (sl::tinydir::file_type::directory != shm_st.type ||
+            shm_st.device == sl::tinydir::status(dir).device) {
+        return;
+    }
+    auto shm_dir = shm + "/path_move_test";
+    sl::tinydir::create_directory(shm_dir);
+    auto deferred_shm = sl::support::defer([shm_dir]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(shm_dir).remove_quietly();
+    });
+    sl::tinydir::create_symlink("foo/1.txt", dir + "/dest/link");
+    sl::tinydir::set_modification_time(dir + "/dest/foo/1.txt", 1500000000000000000LL);
+    ::chmod((dir + "/dest/foo/1.txt").c_str(), 0600);
+    // user entries next to the target are not touched
+    sl::tinydir::file_sink(shm_dir + "/dest.tinydir_move_tmp").write({"baz", 3});
+    auto xdev = sl::tinydir::path(dir + "/dest").move(shm_dir + "/dest", 2);
+    slassert(xdev.is_directory());
+    slassert(!sl::tinydir::path(dir + "/dest").exists());
+    slassert("baz" == read_file(shm_dir + "/dest.tinydir_move_tmp"));
+    // temporary entries are removed
+    slassert(2 == sl::tinydir::list_directory(shm_dir).size());
+    slassert("foo" == read_file(shm_dir + "/dest/foo/1.txt"));
+    slassert("foo" == read_file(shm_dir + "/dest/link"));
+    slassert(sl::tinydir::file_type::symlink == sl::tinydir::symlink_status(shm_dir + "/dest/link").type);
+    auto st = sl::tinydir::status(shm_dir + "/dest/foo/1.txt");
+    slassert(1500000000000000000LL == st.mtime_ns);
+    slassert(0600 == st.mode);
+
+    // single file back
+    auto back = sl::tinydir::path(shm_dir + "/dest/foo/1.txt").move(dir + "/1.txt");
+    slassert(back.is_regular_file());
+    slassert("foo" == read_file(dir + "/1.txt"));
+    slassert(!sl::tinydir::path(shm_dir + "/dest/foo/1.txt").exists());
+#endif // !STATICLIB_WINDOWS
+}
+
+void test_clone() {
+    auto dir = std::string("path_clone_test");
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([dir]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    sl::tinydir::create_directories(dir + "/src/foo/bar");
+    for (size_t i = 0; i < 20; i++) {
+        auto parent = 0 == i % 2 ? dir + "/src/foo" : dir + "/src/foo/bar";
+        auto sink = sl::tinydir::file_sink(parent + "/" + sl::support::to_string(i) + ".txt");
+        sink.write({"foo", 3});
+    }
+#ifndef STATICLIB_WINDOWS
+    sl::tinydir::create_symlink("foo/0.txt", dir + "/src/link");
+    ::chmod((dir + "/src/foo/bar").c_str(), 0700);
+#endif // !STATICLIB_WINDOWS
+    sl::tinydir::set_modification_time(dir + "/src/foo/bar", 1500000000000000000LL);
+
+    // hard links
+    auto snap = sl::tinydir::path(dir + "/src").clone(dir + "/snap", sl::tinydir::path::clone_mode::hardlink, 4);
+    slassert(snap.is_directory());
+    slassert("foo" == read_file(dir + "/snap/foo/bar/1.txt"));
+    auto st = sl::tinydir::status(dir + "/src/foo/bar/1.txt");
+    auto snap_st = sl::tinydir::status(dir + "/snap/foo/bar/1.txt");
+    slassert(st.inode == snap_st.inode);
+    slassert(2 == snap_st.links_count);
+    auto dir_st = sl::tinydir::status(dir + "/snap/foo/bar");
+    slassert(1500000000000000000LL == dir_st.mtime_ns);
+#ifndef STATICLIB_WINDOWS
+    slassert(0700 == dir_st.mode);
+    slassert(sl::tinydir::file_type::symlink == sl::tinydir::symlink_status(dir + "/snap/link").type);
+    slassert("foo" == read_file(dir + "/snap/link"));
+#endif // !STATICLIB_WINDOWS
+
+    // shared extents or copies
+    auto refl = sl::tinydir::path(dir + "/src").clone(dir + "/refl", sl::tinydir::path::clone_mode::reflink);
+    slassert(refl.is_directory());
+    slassert("foo" == read_file(dir + "/refl/foo/0.txt"));
+    auto refl_st = sl::tinydir::status(dir + "/refl/foo/0.txt");
+    slassert(sl::tinydir::status(dir + "/src/foo/0.txt").inode != refl_st.inode);
+    slassert(1 == refl_st.links_count);
+    {
+        auto sink = sl::tinydir::file_sink(dir + "/refl/foo/0.txt");
+        sink.write({"bar", 3});
+    }
+    slassert("foo" == read_file(dir + "/src/foo/0.txt"));
+
+    // single file
+    auto single = sl::tinydir::path(dir + "/src/foo/2.txt").clone(dir + "/2.txt");
+    slassert(single.is_regular_file());
+    slassert(3 == sl::tinydir::status(dir + "/2.txt").links_count);
+
+    bool thrown = false;
+    try {
+        sl::tinydir::path(dir + "/not_existing").clone(dir + "/fail");
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_join() {
+    auto dir = std::string("path_join_test");
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([dir]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+    auto parent = sl::tinydir::path(dir + "/");
+    auto child = parent / "foo";
+    slassert(dir + "/foo" == child.filepath());
+    slassert("foo" == child.filename());
+    slassert(sl::tinydir::path(dir + "/foo").filepath() == child.filepath());
+    // metadata is read on access
+    slassert(!child.exists());
+    sl::tinydir::create_directory(child.filepath());
+    slassert(child.exists());
+    slassert(child.is_directory());
+    slassert(!child.is_regular_file());
+    auto file = child / "bar.txt";
+    file.open_write().write({"bar", 3});
+    slassert(file.is_regular_file());
+    slassert(3 == file.symlink_status().size);
+    slassert("bar" == read_file(file.filepath()));
+    auto copied = file;
+    slassert(copied.exists());
+    auto moved = std::move(copied);
+    slassert(moved.is_regular_file());
+
+    // names with separators are normalized
+    auto nested = parent / "foo\\bar.txt";
+    slassert(dir + "/foo/bar.txt" == nested.filepath());
+    slassert("bar.txt" == nested.filename());
+    slassert(nested.exists());
+    auto root = sl::tinydir::path("/") / "tmp";
+    slassert("/tmp" == root.filepath());
+
+    bool thrown = false;
+    try {
+        parent / "";
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+    for (auto name : {".", "..", "foo/..", "../foo", "foo/./bar.txt"}) {
+        bool thrown_dots = false;
+        try {
+            parent / name;
+        } catch (const sl::tinydir::tinydir_exception&) {
+            thrown_dots = true;
+        }
+        slassert(thrown_dots);
+    }
+    slassert(dir + "/foo/.bar" == (parent / "foo/.bar").filepath());
+    slassert(dir + "/..foo" == (parent / "..foo").filepath());
+
+    child.remove();
+    slassert(!child.exists());
+    slassert(!file.exists());
+}
+
 int main() {
     try {
         test_file();
         test_remove_dir();
+        test_ec();
+        test_rename_modes();
+        test_move();
+        test_clone();
+        test_join();
     } catch (const std::exception& e) {
         std::cout << e.what() << std::endl;
         return 1;
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   record_reader_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 12:20 AM
+ */
+
+#include "staticlib/tinydir/record_reader.hpp"
+
+#include <iostream>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "record_reader_test";
+
+std::vector<std::string> read_records(sl::tinydir::record_reader& reader) {
+    auto res = std::vector<std::string>();
+    sl::io::span<const char> rec;
+    while (reader.next(rec)) {
+        res.emplace_back(rec.data(), rec.size());
+    }
+    // EOF is sticky
+    slassert(!reader.next(rec));
+    return res;
+}
+
+void test_lines() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    // every length from 0 to 99 to cover vector blocks and tails,
+    // lines span the boundaries of the small buffer
+    auto expected = std::vector<std::string>();
+    auto data = std::string();
+    for (size_t i = 0; i < 300; i++) {
+        auto line = std::string(i % 100, static_cast<char> ('a' + i % 26));
+        expected.push_back(line);
+        data.append(line);
+        data.push_back('\n');
+    }
+    auto filename = dir + "/tmp_lines.file";
+    write_file(filename, data);
+
+    auto reader = sl::tinydir::record_reader(filename, '\n', 4096);
+    slassert(expected == read_records(reader));
+
+    // offsets
+    auto offsets = sl::tinydir::record_reader(filename, '\n', 4096);
+    sl::io::span<const char> rec;
+    uint64_t expected_offset = 0;
+    for (size_t i = 0; i < expected.size(); i++) {
+        slassert(offsets.next(rec));
+        slassert(expected_offset == offsets.offset());
+        expected_offset += expected[i].length() + 1;
+    }
+}
+
+void test_records() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    // custom delimiter, record larger than buffer, no trailing delimiter
+    auto large = std::string(10000, 'x');
+    auto data = std::string("foo") + '\0' + '\0' + large + '\0' + "bar";
+    auto filename = dir + "/tmp_records.file";
+    write_file(filename, data);
+
+    auto reader = sl::tinydir::record_reader(filename, '\0', 4096);
+    auto recs = read_records(reader);
+    slassert(4 == recs.size());
+    slassert("foo" == recs[0]);
+    slassert(recs[1].empty());
+    slassert(large == recs[2]);
+    slassert("bar" == recs[3]);
+
+    // reading from the current position of the source
+    auto src = sl::tinydir::file_source(filename);
+    src.seek(4);
+    auto from_pos = sl::tinydir::record_reader(std::move(src), '\0', 4096);
+    sl::io::span<const char> rec;
+    slassert(from_pos.next(rec));
+    slassert(0 == rec.size());
+    slassert(4 == from_pos.offset());
+    auto moved = std::move(from_pos);
+    slassert(moved.next(rec));
+    slassert(large == std::string(rec.data(), rec.size()));
+    slassert(5 == moved.offset());
+
+    // empty file
+    auto empty = dir + "/tmp_empty.file";
+    write_file(empty, "");
+    auto empty_reader = sl::tinydir::record_reader(empty);
+    slassert(read_records(empty_reader).empty());
+}
+
+int main() {
+    try {
+        test_lines();
+        test_records();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
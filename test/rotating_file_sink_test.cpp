@@ -0,0 +1,188 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   rotating_file_sink_test.cpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 2:20 AM
+ */
+
+#include "staticlib/tinydir/rotating_file_sink.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/file_source.hpp"
+#include "staticlib/tinydir/file_status.hpp"
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+const std::string dir = "rotating_file_sink_test";
+
+void test_size() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto opts = sl::tinydir::rotation_options();
+    opts.max_segment_size = 10;
+    auto sink = sl::tinydir::rotating_file_sink(dir + "/tmp.log", opts);
+    slassert(1 == sink.segment_index());
+    slassert(dir + "/tmp.log.2" == sink.segment_path(2));
+    for (size_t i = 0; i < 5; i++) {
+        sl::io::write_all(sink, {"12345", 5});
+    }
+    slassert(3 == sink.segment_index());
+    slassert(5 == sink.segment_size());
+
+    // single write is not split
+    sl::io::write_all(sink, {"abcdefghijkl", 12});
+    slassert(4 == sink.segment_index());
+    slassert(12 == sink.segment_size());
+
+    // empty segment is not rotated
+    auto moved = std::move(sink);
+    moved.rotate();
+    slassert(5 == moved.segment_index());
+    moved.rotate();
+    slassert(5 == moved.segment_index());
+    sl::io::write_all(moved, {"xyz", 3});
+    moved.close();
+
+    // retired segments are not padded by preallocation
+    slassert("1234512345" == read_file(dir + "/tmp.log.1"));
+    slassert("1234512345" == read_file(dir + "/tmp.log.2"));
+    slassert("12345" == read_file(dir + "/tmp.log.3"));
+    slassert("abcdefghijkl" == read_file(dir + "/tmp.log.4"));
+    slassert("xyz" == read_file(dir + "/tmp.log.5"));
+    // pre-created segment is removed
+    slassert(!sl::tinydir::path(dir + "/tmp.log.6").exists());
+
+    bool thrown = false;
+    try {
+        sl::io::write_all(moved, {"foo", 3});
+    } catch (const sl::tinydir::tinydir_exception&) {
+        thrown = true;
+    }
+    slassert(thrown);
+}
+
+void test_age() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto opts = sl::tinydir::rotation_options();
+    opts.max_segment_size = 0;
+    opts.max_segment_age = std::chrono::milliseconds(50);
+    opts.first_index = 10;
+    opts.sync_retired = false;
+    {
+        auto sink = sl::tinydir::rotating_file_sink(dir + "/tmp_age.log", opts);
+        sl::io::write_all(sink, {"foo", 3});
+        sl::io::write_all(sink, {"bar", 3});
+        slassert(10 == sink.segment_index());
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        sl::io::write_all(sink, {"baz", 3});
+        slassert(11 == sink.segment_index());
+    }
+    slassert("foobar" == read_file(dir + "/tmp_age.log.10"));
+    slassert("baz" == read_file(dir + "/tmp_age.log.11"));
+    slassert(!sl::tinydir::path(dir + "/tmp_age.log.12").exists());
+}
+
+void test_existing() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    // left from an earlier run
+    sl::tinydir::file_sink(dir + "/tmp_old.log.2").write({"old2", 4});
+    sl::tinydir::file_sink(dir + "/tmp_old.log.3").write({"old3", 4});
+    auto opts = sl::tinydir::rotation_options();
+    opts.max_segment_size = 0;
+    {
+        auto sink = sl::tinydir::rotating_file_sink(dir + "/tmp_old.log", opts);
+        sl::io::write_all(sink, {"foo", 3});
+    }
+    // unused pre-created segment does not touch existing files
+    slassert("old2" == read_file(dir + "/tmp_old.log.2"));
+    slassert("old3" == read_file(dir + "/tmp_old.log.3"));
+    slassert(!sl::tinydir::path(dir + "/tmp_old.log.4").exists());
+    {
+        auto sink = sl::tinydir::rotating_file_sink(dir + "/tmp_old.log", opts);
+        slassert(4 == sink.segment_index());
+        sl::io::write_all(sink, {"bar", 3});
+        sink.rotate();
+        slassert(5 == sink.segment_index());
+        sl::io::write_all(sink, {"baz", 3});
+    }
+    // first segment does not truncate existing file
+    slassert("foo" == read_file(dir + "/tmp_old.log.1"));
+    slassert("old2" == read_file(dir + "/tmp_old.log.2"));
+    slassert("old3" == read_file(dir + "/tmp_old.log.3"));
+    slassert("bar" == read_file(dir + "/tmp_old.log.4"));
+    slassert("baz" == read_file(dir + "/tmp_old.log.5"));
+    slassert(!sl::tinydir::path(dir + "/tmp_old.log.6").exists());
+}
+
+void test_preallocated() {
+    sl::tinydir::create_directory(dir);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(dir).remove_quietly();
+    });
+
+    auto opts = sl::tinydir::rotation_options();
+    opts.max_segment_size = 1 << 26;
+    {
+        auto sink = sl::tinydir::rotating_file_sink(dir + "/tmp.log", opts);
+        sl::io::write_all(sink, {"foo", 3});
+        sink.rotate();
+        sl::io::write_all(sink, {"bar", 3});
+    }
+    slassert("foo" == read_file(dir + "/tmp.log.1"));
+    slassert("bar" == read_file(dir + "/tmp.log.2"));
+    // reservation beyond written data is released on retire
+    slassert(sl::tinydir::status(dir + "/tmp.log.1").allocated_size < (1 << 20));
+    slassert(sl::tinydir::status(dir + "/tmp.log.2").allocated_size < (1 << 20));
+    slassert(!sl::tinydir::path(dir + "/tmp.log.3").exists());
+}
+
+int main() {
+    try {
+        test_size();
+        test_age();
+        test_existing();
+        test_preallocated();
+        slassert(!sl::tinydir::path(dir).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   test_utils.hpp
+ * Author: alex
+ *
+ * Created on October 19, 2026, 6:10 AM
+ */
+
+#ifndef STATICLIB_TINYDIR_TEST_UTILS_HPP
+#define STATICLIB_TINYDIR_TEST_UTILS_HPP
+
+#include <string>
+
+#include "staticlib/io.hpp"
+
+#include "staticlib/tinydir/file_sink.hpp"
+#include "staticlib/tinydir/file_source.hpp"
+
+// helpers shared by the tests, not a part of the library
+
+inline void write_file(const std::string& path, const std::string& data) {
+    auto sink = sl::tinydir::file_sink(path);
+    sink.write({data.data(), data.length()});
+}
+
+inline std::string read_file(const std::string& path) {
+    auto src = sl::tinydir::file_source(path);
+    auto sink = sl::io::string_sink();
+    sl::io::copy_all(src, sink);
+    return sink.get_string();
+}
+
+// not periodic on 4096 bytes, so misplaced blocks are detected
+inline std::string make_data(size_t len) {
+    auto res = std::string();
+    res.reserve(len);
+    for (size_t i = 0; i < len; i++) {
+        res.push_back(static_cast<char> ('a' + (i * 7 + i / 4096) % 26));
+    }
+    return res;
+}
+
+#endif /* STATICLIB_TINYDIR_TEST_UTILS_HPP */
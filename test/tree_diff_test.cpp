@@ -0,0 +1,184 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   tree_diff_test.cpp
+ * Author: alex
+ *
+ * Created on October 18, 2026, 11:40 AM
+ */
+
+#include "staticlib/tinydir/tree_diff.hpp"
+
+#include <cstring>
+#include <iostream>
+
+#include "staticlib/config.hpp"
+#include "staticlib/config/assert.hpp"
+#include "staticlib/io.hpp"
+
+#include "staticlib/tinydir/operations.hpp"
+#include "staticlib/tinydir/path.hpp"
+
+#include "test_utils.hpp"
+
+#ifndef STATICLIB_WINDOWS
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif // !STATICLIB_WINDOWS
+
+const std::string src = "tree_diff_test_src";
+const std::string dst = "tree_diff_test_dst";
+
+void test_mirror() {
+    sl::tinydir::create_directory(src);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(src).remove_quietly();
+        sl::tinydir::path(dst).remove_quietly();
+    });
+    sl::tinydir::create_directory(src + "/foo");
+    sl::tinydir::create_directory(src + "/foo/bar");
+    write_file(src + "/foo/bar/1.txt", "foo");
+    write_file(src + "/foo/2.txt", "bar");
+    write_file(src + "/3.txt", "baz");
+
+    auto initial = sl::tinydir::mirror_tree(src, dst);
+    slassert(5 == initial.size());
+    slassert("foo" == read_file(dst + "/foo/bar/1.txt"));
+    slassert(sl::tinydir::diff_trees(src, dst).empty());
+
+    write_file(src + "/foo/2.txt", "barbar");
+    write_file(src + "/4.txt", "42");
+    sl::tinydir::path(src + "/foo/bar").remove();
+
+    auto changes = sl::tinydir::diff_trees(src, dst);
+    slassert(4 == changes.size());
+    slassert("4.txt" == changes[0].relpath);
+    slassert(sl::tinydir::tree_change_kind::added == changes[0].kind);
+    slassert("foo/2.txt" == changes[1].relpath);
+    slassert(sl::tinydir::tree_change_kind::modified == changes[1].kind);
+    slassert("foo/bar" == changes[2].relpath);
+    slassert(sl::tinydir::tree_change_kind::removed == changes[2].kind);
+    slassert(sl::tinydir::file_type::directory == changes[2].type);
+    slassert("foo/bar/1.txt" == changes[3].relpath);
+    slassert(sl::tinydir::tree_change_kind::removed == changes[3].kind);
+
+    auto applied = sl::tinydir::mirror_tree(src, dst);
+    slassert(4 == applied.size());
+    slassert(sl::tinydir::diff_trees(src, dst).empty());
+    slassert("barbar" == read_file(dst + "/foo/2.txt"));
+    slassert(!sl::tinydir::path(dst + "/foo/bar").exists());
+}
+
+void test_verify_content() {
+    sl::tinydir::create_directory(src);
+    sl::tinydir::create_directory(dst);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(src).remove_quietly();
+        sl::tinydir::path(dst).remove_quietly();
+    });
+    write_file(src + "/1.txt", "foo");
+    write_file(dst + "/1.txt", "bar");
+    auto st = sl::tinydir::status(src + "/1.txt");
+    sl::tinydir::set_modification_time(dst + "/1.txt", st.mtime_ns);
+
+    slassert(sl::tinydir::diff_trees(src, dst).empty());
+    auto opts = sl::tinydir::tree_diff_options();
+    opts.verify_content = true;
+    auto changes = sl::tinydir::diff_trees(src, dst, opts);
+    slassert(1 == changes.size());
+    slassert(sl::tinydir::tree_change_kind::modified == changes[0].kind);
+
+    // equal contents, different times
+    write_file(src + "/2.txt", "baz");
+    write_file(dst + "/2.txt", "baz");
+    sl::tinydir::set_modification_time(src + "/2.txt", 1500000000123456789LL);
+    slassert(1 == sl::tinydir::diff_trees(src, dst).size());
+    slassert(1 == sl::tinydir::diff_trees(src, dst, opts).size());
+    // diff does not touch the target
+    slassert(1500000000123456789LL != sl::tinydir::status(dst + "/2.txt").mtime_ns);
+    auto applied = sl::tinydir::mirror_tree(src, dst, opts);
+    slassert(1 == applied.size());
+    slassert("1.txt" == applied[0].relpath);
+    slassert(1500000000123456789LL == sl::tinydir::status(dst + "/2.txt").mtime_ns);
+    slassert(sl::tinydir::diff_trees(src, dst).empty());
+}
+
+#ifndef STATICLIB_WINDOWS
+void test_mirror_symlink() {
+    sl::tinydir::create_directory(src);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(src).remove_quietly();
+        sl::tinydir::path(dst).remove_quietly();
+    });
+    write_file(src + "/1.txt", "foo");
+    sl::tinydir::create_symlink("1.txt", src + "/link");
+    struct timespec times[2];
+    times[0].tv_sec = 1500000000;
+    times[0].tv_nsec = 123456789;
+    times[1] = times[0];
+    slassert(0 == ::utimensat(AT_FDCWD, (src + "/link").c_str(), times, AT_SYMLINK_NOFOLLOW));
+
+    auto initial = sl::tinydir::mirror_tree(src, dst);
+    slassert(2 == initial.size());
+    slassert(1500000000123456789LL == sl::tinydir::symlink_status(dst + "/link").mtime_ns);
+    // converged, next sync does not recreate the link
+    slassert(sl::tinydir::diff_trees(src, dst).empty());
+    slassert(sl::tinydir::mirror_tree(src, dst).empty());
+}
+#endif // !STATICLIB_WINDOWS
+
+void test_snapshot() {
+    sl::tinydir::create_directory(src);
+    auto deferred = sl::support::defer([]() STATICLIB_NOEXCEPT {
+        sl::tinydir::path(src).remove_quietly();
+        sl::tinydir::path("tree_diff_test.snapshot").remove_quietly();
+    });
+    sl::tinydir::create_directory(src + "/foo");
+    write_file(src + "/foo/1 2.txt", "foo");
+
+    auto snap = sl::tinydir::snapshot_tree(src, 2);
+    slassert(2 == snap.entries().size());
+    slassert(nullptr != snap.find("foo/1 2.txt"));
+    slassert(3 == snap.find("foo/1 2.txt")->status.size);
+    slassert(nullptr == snap.find("foo/3.txt"));
+    snap.save("tree_diff_test.snapshot");
+
+    write_file(src + "/foo/1 2.txt", "foobar");
+    auto loaded = sl::tinydir::tree_snapshot::load("tree_diff_test.snapshot");
+    slassert(2 == loaded.entries().size());
+    auto changes = sl::tinydir::diff_trees(sl::tinydir::snapshot_tree(src), loaded);
+    slassert(1 == changes.size());
+    slassert("foo/1 2.txt" == changes[0].relpath);
+    slassert(sl::tinydir::tree_change_kind::modified == changes[0].kind);
+}
+
+int main() {
+    try {
+        test_mirror();
+        test_verify_content();
+#ifndef STATICLIB_WINDOWS
+        test_mirror_symlink();
+#endif // !STATICLIB_WINDOWS
+        test_snapshot();
+        slassert(!sl::tinydir::path(src).exists());
+        slassert(!sl::tinydir::path(dst).exists());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}